@@ -4,104 +4,460 @@
  */
 
 #include "API_pobieranie.h"
+#include "Geokoder_osm.h"
+#include "Odleglosci.h"
 #include <QNetworkRequest>
 #include <QMessageBox>
 #include <QDebug>
 #include <QUrlQuery>
-#include <QGeoCodingManager>
-#include <QGeoServiceProvider>
-#include <QGeoCodeReply>
 #include <QGeoCoordinate>
-#include <QGeoLocation>
+#include <QDateTime>
+#include <QSaveFile>
 
 #include <QtConcurrent>
+#include <limits>
+
+namespace {
+/// Atrybut żądania listy stacji niosący nazwę miasta do filtrowania.
+const QNetworkRequest::Attribute ATRYBUT_MIASTO = QNetworkRequest::Attribute(QNetworkRequest::User + 1);
+/// Atrybut żądania wysłanego przez pobieranie całej sieci (wynik nie trafia do widoków).
+const QNetworkRequest::Attribute ATRYBUT_TLO = QNetworkRequest::Attribute(QNetworkRequest::User + 2);
+/// Liczba stacji na stronie listy stacji.
+const int ROZMIAR_STRONY_STACJI = 500;
+/// Liczba stanowisk, których scalona historia jest trzymana w pamięci.
+const int MAKS_HISTORII = 8;
+
+/**
+ * @brief Zwraca numer strony z adresu żądania listy stacji (0, gdy go nie ma).
+ */
+int numerStrony(const QString& url) {
+    return QUrlQuery(QUrl(url)).queryItemValue("page").toInt();
+}
+
+/**
+ * @brief Sprawdza, czy na odpowiedź czeka któryś z widoków (a nie tylko pobieranie w tle).
+ */
+bool dlaWidoku(const QVector<QNetworkRequest>& oczekujace) {
+    for (const QNetworkRequest& request : oczekujace) {
+        if (!request.attribute(ATRYBUT_TLO).toBool())
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Sprawdza, czy na odpowiedź czeka pobieranie całej sieci.
+ */
+bool dlaPobieraniaSieci(const QVector<QNetworkRequest>& oczekujace) {
+    for (const QNetworkRequest& request : oczekujace) {
+        if (request.attribute(ATRYBUT_TLO).toBool())
+            return true;
+    }
+    return false;
+}
+}
 
 /**
  * @brief Konstruktor klasy APIService.
- * Inicjalizuje menedżer sieci i ładuje dane z pliku cache (jeśli dostępne).
+ * Inicjalizuje menedżer sieci, dyskową pamięć odpowiedzi, wątek zapisu i dziennik pomiarów.
  */
 APIService::APIService(QObject *parent) :
     QObject(parent),
     networkManager(new QNetworkAccessManager(this)),
-    cache(100)
+    harmonogram(new HarmonogramZadan(networkManager, 4, this)),
+    cache(32 * 1024 * 1024),
+    pamiecDyskowa(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/odpowiedzi"),
+    geokoder(new GeokoderOsm),
+    pamiecGeokodowania(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/geokodowanie")
 {
-    connect(networkManager, &QNetworkAccessManager::finished,
+    connect(harmonogram, &HarmonogramZadan::zakonczono,
             this, &APIService::onReplyFinished);
 
-    QFile file(sciezkaPliku);
-    if (file.open(QIODevice::ReadOnly)) {
-        QByteArray data = file.readAll();
-        aktualneDane = QJsonDocument::fromJson(data).object();
-        file.close();
+    dziennik.otworz();
+
+    // Skorowidz jest opcjonalny: bez pliku każde wyszukiwanie idzie do geokodera.
+    const QString sciezkaSkorowidza = QStandardPaths::locate(QStandardPaths::AppDataLocation, "skorowidz.skm");
+    if (!sciezkaSkorowidza.isEmpty())
+        skorowidz.otworz(sciezkaSkorowidza);
+
+    if (QFile::exists(sciezkaArchiwum)) {
+        QSharedPointer<MagazynKolumnowy> archiwum(new MagazynKolumnowy);
+        if (archiwum->otworz(sciezkaArchiwum))
+            magazyn = archiwum;
     }
+
+    zapisWTle = new ZapisWTle(sciezkaPliku);
+    zapisWTle->moveToThread(&watekZapisu);
+    connect(&watekZapisu, &QThread::finished, zapisWTle, &QObject::deleteLater);
+    connect(zapisWTle, &ZapisWTle::zapisano, this, [this](bool sukces) {
+        if (sukces) {
+            qDebug() << "Dane zostały automatycznie zapisane do pliku";
+            emit daneAutomatycznieZapisane();
+        }
+    });
+    watekZapisu.start();
 }
 
 /**
- * @brief Zapisuje aktualne dane do pliku automatycznie.
- * Emituje sygnał po zakończeniu zapisu.
+ * @brief Destruktor klasy APIService.
+ * Zapisuje oczekujące zmiany i kończy wątek zapisu.
  */
-void APIService::zapiszDaneAutomatycznie() {
-    QFile file(sciezkaPliku);
-    if (!file.open(QIODevice::WriteOnly)) {
-        qWarning() << "Nie można otworzyć pliku do zapisu:" << sciezkaPliku;
-        return;
-    }
+APIService::~APIService() {
+    QMetaObject::invokeMethod(zapisWTle, &ZapisWTle::zapiszTeraz, Qt::BlockingQueuedConnection);
+    watekZapisu.quit();
+    watekZapisu.wait();
+}
 
-    file.write(QJsonDocument(aktualneDane).toJson());
-    file.close();
-    qDebug() << "Dane zostały automatycznie zapisane do pliku";
-    emit daneAutomatycznieZapisane();
+/**
+ * @brief Zleca automatyczny zapis zmienionej sekcji danych.
+ * Zapis odbywa się w tle; po jego zakończeniu emitowany jest sygnał daneAutomatycznieZapisane.
+ *
+ * @param sekcja Nazwa zmienionej sekcji.
+ */
+void APIService::zapiszDaneAutomatycznie(const QString& sekcja) {
+    zapisWTle->oznaczZmiane(sekcja, aktualneDane[sekcja]);
 }
 
 /**
- * @brief Pobiera wszystkie stacje pomiarowe z API lub z cache.
- * Dane są przetwarzane i przekazywane dalej za pomocą sygnału.
+ * @brief Ustawia adres bazowy API.
+ *
+ * @param adres Adres bazowy zakończony ukośnikiem.
  */
-void APIService::pobierzWszystkieStacje() {
-    QtConcurrent::run([=]() {
-        QUrl url("https://api.gios.gov.pl/pjp-api/v1/rest/station/findAll?size=500");
-        if (cache.contains(url.toString())) {
+void APIService::ustawAdresBazowy(const QString& adres) {
+    adresBazowy = adres.endsWith('/') ? adres : adres + '/';
+}
+
+/**
+ * @brief Ustawia maksymalną liczbę równoczesnych zapytań do API.
+ *
+ * @param maks Limit zapytań w toku.
+ */
+void APIService::ustawLimitZapytan(int maks) {
+    harmonogram->ustawMaksWToku(maks);
+}
+
+/**
+ * @brief Zwraca skorowidz miejsc.
+ *
+ * @return Referencja do skorowidza.
+ */
+const SkorowidzMiejsc& APIService::skorowidzMiejsc() const {
+    return skorowidz;
+}
+
+/**
+ * @brief Zastępuje usługę geokodowania.
+ *
+ * @param nowy Nowy geokoder lub nullptr (domyślny GeokoderOsm).
+ */
+void APIService::ustawGeokoder(Geokoder *nowy) {
+    geokoder.reset(nowy ? nowy : new GeokoderOsm);
+}
+
+/**
+ * @brief Buduje pełny adres endpointu.
+ *
+ * @param sciezka Ścieżka względem adresu bazowego.
+ * @return QUrl Pełny adres.
+ */
+QUrl APIService::adresEndpointu(const QString& sciezka) const {
+    return QUrl(adresBazowy + sciezka);
+}
+
+/**
+ * @brief Wysyła żądanie GET z wykorzystaniem dyskowej pamięci podręcznej.
+ *
+ * Jeśli żądanie o ten sam adres jest już w toku, nowe żądanie jest tylko dołączane
+ * do listy oczekujących i otrzyma tę samą odpowiedź (żądanie interaktywne przyspiesza
+ * czekające w kolejce żądanie w tle).
+ * Świeży zdekodowany dokument z pamięci jest przetwarzany bez odczytu pliku pamięci dyskowej;
+ * plik jest czytany tylko, gdy dokumentu nie ma w pamięci albo stracił ważność.
+ *
+ * @param request Żądanie sieciowe.
+ * @param priorytet Klasa priorytetu w harmonogramie zapytań.
+ */
+void APIService::wyslij(QNetworkRequest request, HarmonogramZadan::Priorytet priorytet) {
+    const QString klucz = request.url().toString();
+
+    auto it = wToku.find(klucz);
+    if (it != wToku.end()) {
+        if (!it->contains(request))
+            it->append(request);
+        if (priorytet == HarmonogramZadan::Interaktywny)
+            harmonogram->podniesPriorytet(request.url());
+        return;
+    }
+    wToku.insert(klucz, QVector<QNetworkRequest>{request});
+
+    const qint64 teraz = QDateTime::currentMSecsSinceEpoch();
+    if (teraz < waznoscCache.value(klucz, 0)) {
+        if (const QSharedPointer<const QJsonDocument> doc = cache.znajdz(klucz)) {
             QMetaObject::invokeMethod(this, [=]() {
-                przetworzOdpowiedzStacje(cache[url.toString()]->toJson());
+                przetworzDokument(wToku.take(klucz), *doc);
             }, Qt::QueuedConnection);
             return;
         }
-        QNetworkRequest request(url);
+    }
+
+    PamiecOdpowiedzi::Wpis wpis;
+    if (pamiecDyskowa.znajdz(request.url(), &wpis)) {
+        if (wpis.jestSwiezy(teraz)) {
+            waznoscCache.insert(klucz, wpis.waznyDo);
+            const QSharedPointer<const QJsonDocument> doc = cache.znajdz(klucz);
+            QMetaObject::invokeMethod(this, [=]() {
+                if (doc)
+                    przetworzDokument(wToku.take(klucz), *doc);
+                else
+                    przetworzOdpowiedz(wToku.take(klucz), wpis.tresc);
+            }, Qt::QueuedConnection);
+            return;
+        }
+
+        if (!wpis.etag.isEmpty())
+            request.setRawHeader("If-None-Match", wpis.etag);
+        if (!wpis.ostatniaZmiana.isEmpty())
+            request.setRawHeader("If-Modified-Since", wpis.ostatniaZmiana);
+    }
+
+    harmonogram->dodaj(request, priorytet);
+}
+
+/**
+ * @brief Wysyła żądanie dla widoku, anulując poprzednie żądanie tego widoku.
+ *
+ * Dzięki temu odpowiedzi dla wcześniej wybranych stacji i stanowisk nie są przetwarzane,
+ * zapisywane ani wyświetlane po odpowiedzi dla bieżącego wyboru.
+ *
+ * @param widok Nazwa widoku ("stanowiska", "pomiary", "indeks").
+ * @param request Żądanie sieciowe.
+ */
+void APIService::wyslijNajnowsze(const QString& widok, const QNetworkRequest& request) {
+    const QString klucz = request.url().toString();
+    const QString poprzedni = ostatnieZadania.value(widok);
+
+    if (!poprzedni.isEmpty() && poprzedni != klucz)
+        anuluj(poprzedni);
+
+    ostatnieZadania[widok] = klucz;
+    wyslij(request);
+}
+
+/**
+ * @brief Anuluje żądanie w toku; jego odpowiedź nie zostanie przetworzona.
+ *
+ * @param klucz Adres żądania.
+ */
+void APIService::anuluj(const QString& klucz) {
+    auto it = wToku.find(klucz);
+    if (it == wToku.end())
+        return;
+
+    // Żądanie potrzebne pobieraniu całej sieci nie jest przerywane - odpada tylko widok.
+    it->removeIf([](const QNetworkRequest& request) { return !request.attribute(ATRYBUT_TLO).toBool(); });
+    if (it->isEmpty()) {
+        wToku.erase(it);
+        harmonogram->anuluj(QUrl(klucz));
+    }
+}
+
+/**
+ * @brief Rozpoczyna pobieranie stanowisk i bieżących pomiarów wszystkich stacji.
+ *
+ * @param zapytanNaSekunde Limit częstości zapytań w tle.
+ */
+void APIService::pobierzCalaSiec(int zapytanNaSekunde) {
+    if (pobieranieSieci.aktywne)
+        return;
+
+    pobieranieSieci = PostepPobierania();
+    pobieranieSieci.aktywne = true;
+    harmonogram->ustawLimitTla(zapytanNaSekunde);
+
+    if (rejestr.jestPusty()) {
+        pobierzWTle(zadanieListyStacji());
+        return;
+    }
+
+    QNetworkRequest request = zadanieListyStacji();
+    request.setAttribute(ATRYBUT_TLO, true);
+    if (czekajNaStronyStacji(request))
+        return;
+
+    pobierzStanowiskaWszystkichStacji();
+    if (pobieranieSieci.gotowe >= pobieranieSieci.wszystkie)
+        pobieranieSieci.aktywne = false;
+    emit postepPobieraniaSieci(pobieranieSieci.gotowe, pobieranieSieci.wszystkie, pobieranieSieci.bledy);
+}
+
+/**
+ * @brief Zwraca, czy trwa pobieranie całej sieci.
+ *
+ * @return true jeśli pobieranie nie zostało zakończone.
+ */
+bool APIService::pobieranieSieciTrwa() const {
+    return pobieranieSieci.aktywne;
+}
+
+/**
+ * @brief Wysyła żądanie pobierania całej sieci z priorytetem tła.
+ *
+ * @param request Żądanie sieciowe.
+ */
+void APIService::pobierzWTle(QNetworkRequest request) {
+    request.setAttribute(ATRYBUT_TLO, true);
+    ++pobieranieSieci.wszystkie;
+    wyslij(request, HarmonogramZadan::Tlo);
+}
+
+/**
+ * @brief Kolejkuje pobranie listy stanowisk każdej stacji z rejestru.
+ */
+void APIService::pobierzStanowiskaWszystkichStacji() {
+    for (int wiersz = 0; wiersz < rejestr.rozmiar(); ++wiersz)
+        pobierzWTle(QNetworkRequest(adresEndpointu(QString("station/sensors/%1").arg(rejestr.id(wiersz)))));
+}
+
+/**
+ * @brief Zlicza zakończone żądanie pobierania całej sieci i raportuje postęp.
+ *
+ * @param oczekujace Żądania, na które przyszła odpowiedź.
+ * @param sukces Czy odpowiedź została przetworzona.
+ */
+void APIService::oznaczPobranieWTle(const QVector<QNetworkRequest>& oczekujace, bool sukces) {
+    if (!pobieranieSieci.aktywne || !dlaPobieraniaSieci(oczekujace))
+        return;
+
+    ++pobieranieSieci.gotowe;
+    if (!sukces)
+        ++pobieranieSieci.bledy;
+    if (pobieranieSieci.gotowe >= pobieranieSieci.wszystkie)
+        pobieranieSieci.aktywne = false;
+
+    emit postepPobieraniaSieci(pobieranieSieci.gotowe, pobieranieSieci.wszystkie, pobieranieSieci.bledy);
+}
+
+/**
+ * @brief Zwraca żądanie strony listy wszystkich stacji.
+ *
+ * @param strona Numer strony.
+ * @return QNetworkRequest Żądanie endpointu station/findAll.
+ */
+QNetworkRequest APIService::zadanieListyStacji(int strona) const {
+    return QNetworkRequest(adresEndpointu(QString("station/findAll?page=%1&size=%2")
+                                              .arg(strona).arg(ROZMIAR_STRONY_STACJI)));
+}
+
+/**
+ * @brief Pobiera listę stacji z pamięci podręcznej lub z sieci.
+ *
+ * Dokument z pamięci podręcznej trafia do obsługi bez serializacji i ponownego parsowania.
+ *
+ * @param request Żądanie listy stacji (z atrybutami filtra).
+ */
+void APIService::pobierzListeStacji(const QNetworkRequest& request) {
+    if (QSharedPointer<const QJsonDocument> doc = cache.znajdz(request.url().toString())) {
         QMetaObject::invokeMethod(this, [=]() {
-            networkManager->get(request);
+            przetworzDokument(QVector<QNetworkRequest>{request}, *doc);
         }, Qt::QueuedConnection);
-    });
+        return;
+    }
+
+    wyslij(request);
+}
+
+/**
+ * @brief Dołącza żądanie do odbiorców kolejnych stron listy stacji.
+ *
+ * @param request Żądanie listy stacji.
+ * @return true jeśli część stron jest jeszcze w drodze.
+ */
+bool APIService::czekajNaStronyStacji(const QNetworkRequest& request) {
+    if (pozostaleStronyStacji == 0)
+        return false;
+
+    odbiorcyStacji.append(request);
+    return true;
+}
+
+/**
+ * @brief Przekazuje zawartość rejestru do każdego odbiorcy listy stacji.
+ *
+ * Widoki dostają wynik po każdej stronie (rejestr rośnie), a pobieranie całej sieci
+ * startuje dopiero po ostatniej stronie.
+ *
+ * @param kompletna Czy dotarły wszystkie strony.
+ */
+void APIService::rozeslijStacje(bool kompletna) {
+    for (const QNetworkRequest& request : odbiorcyStacji) {
+        if (request.attribute(ATRYBUT_TLO).toBool()) {
+            if (kompletna && pobieranieSieci.aktywne)
+                pobierzStanowiskaWszystkichStacji();
+        }
+        else if (request.rawHeader("X-Geo-Filtr") == "1") {
+            double lat = request.attribute(QNetworkRequest::User).toDouble();
+            double lon = request.attribute(QNetworkRequest::UserMax).toDouble();
+            double promienKm = request.attribute(QNetworkRequest::HttpPipeliningAllowedAttribute).toDouble();
+
+            filtrujStacjeWPromieniu(lat, lon, promienKm);
+        }
+        else if (request.attribute(ATRYBUT_MIASTO).isValid()) {
+            emit daneStacjiPobrane(filtrujStacjePoMiescie(request.attribute(ATRYBUT_MIASTO).toString()));
+        }
+        else {
+            emit daneStacjiPobrane(rejestr.wszystkie());
+        }
+    }
+
+    if (kompletna)
+        odbiorcyStacji.clear();
+}
+
+/**
+ * @brief Zlicza nieudaną stronę listy stacji jako zakończoną.
+ *
+ * Bez tego odbiorcy czekaliby na stronę, która nie dotrze (np. pobieranie całej sieci by nie ruszyło).
+ *
+ * @param url Adres żądania.
+ */
+void APIService::pominStroneStacji(const QString& url) {
+    if (!url.contains("station/findAll") || numerStrony(url) == 0 || pozostaleStronyStacji == 0)
+        return;
+
+    if (--pozostaleStronyStacji == 0)
+        rozeslijStacje(true);
+}
+
+/**
+ * @brief Pobiera wszystkie stacje pomiarowe z rejestru, cache lub API.
+ * Dane są przetwarzane i przekazywane dalej za pomocą sygnału.
+ */
+void APIService::pobierzWszystkieStacje() {
+    if (!rejestr.jestPusty()) {
+        emit daneStacjiPobrane(rejestr.wszystkie());
+        czekajNaStronyStacji(zadanieListyStacji());
+        return;
+    }
+
+    pobierzListeStacji(zadanieListyStacji());
 }
 
 /**
  * @brief Pobiera stacje znajdujące się w podanym mieście.
- * Wykorzystuje dane z cache lub pobiera z sieci.
+ * Wykorzystuje rejestr stacji lub pobiera listę z sieci.
  *
  * @param miasto Nazwa miasta do filtrowania.
  */
 void APIService::pobierzStacjeWMiescie(const QString& miasto) {
-    QtConcurrent::run([=]() {
-        QUrl url("https://api.gios.gov.pl/pjp-api/v1/rest/station/findAll?size=500");
-
-        if (cache.contains(url.toString())) {
-            QJsonDocument* cachedDoc = cache[url.toString()];
-            QJsonArray wszystkieStacje;
-            if (cachedDoc->isObject()) {
-                QJsonObject obj = cachedDoc->object();
-                if (obj.contains("Lista stacji pomiarowych"))
-                    wszystkieStacje = obj["Lista stacji pomiarowych"].toArray();
-            }
-            QJsonArray przefiltrowane = filtrujStacjePoMiescie(wszystkieStacje, miasto);
-            QMetaObject::invokeMethod(this, [=]() {
-                emit daneStacjiPobrane(przefiltrowane);
-            }, Qt::QueuedConnection);
-            return;
-        }
-        QMetaObject::invokeMethod(this, [=]() {
-            QNetworkRequest request(url);
-            networkManager->get(request);
-        }, Qt::QueuedConnection);
-    });
+    QNetworkRequest request = zadanieListyStacji();
+    request.setAttribute(ATRYBUT_MIASTO, miasto);
+
+    if (!rejestr.jestPusty()) {
+        emit daneStacjiPobrane(filtrujStacjePoMiescie(miasto));
+        czekajNaStronyStacji(request);
+        return;
+    }
+
+    pobierzListeStacji(request);
 }
 
 /**
@@ -110,9 +466,7 @@ void APIService::pobierzStacjeWMiescie(const QString& miasto) {
  * @param stacjaId Identyfikator stacji.
  */
 void APIService::pobierzStanowiskaDlaStacji(int stacjaId) {
-    QUrl url(QString("https://api.gios.gov.pl/pjp-api/v1/rest/station/sensors/%1").arg(stacjaId));
-    QNetworkRequest request(url);
-    networkManager->get(request);
+    wyslijNajnowsze("stanowiska", QNetworkRequest(adresEndpointu(QString("station/sensors/%1").arg(stacjaId))));
 }
 
 /**
@@ -121,9 +475,7 @@ void APIService::pobierzStanowiskaDlaStacji(int stacjaId) {
  * @param stanowiskoId Identyfikator stanowiska.
  */
 void APIService::pobierzDanePomiarowe(int stanowiskoId) {
-    QUrl url(QString("https://api.gios.gov.pl/pjp-api/v1/rest/data/getData/%1").arg(stanowiskoId));
-    QNetworkRequest request(url);
-    networkManager->get(request);
+    wyslijNajnowsze("pomiary", QNetworkRequest(adresEndpointu(QString("data/getData/%1").arg(stanowiskoId))));
 }
 
 /**
@@ -132,58 +484,134 @@ void APIService::pobierzDanePomiarowe(int stanowiskoId) {
  * @param stacjaId Identyfikator stacji.
  */
 void APIService::pobierzIndeksJakosciPowietrza(int stacjaId) {
-    QUrl url(QString("https://api.gios.gov.pl/pjp-api/v1/rest/aqindex/getIndex/%1").arg(stacjaId));
-    QNetworkRequest request(url);
-    networkManager->get(request);
+    wyslijNajnowsze("indeks", QNetworkRequest(adresEndpointu(QString("aqindex/getIndex/%1").arg(stacjaId))));
 }
 
 /**
  * @brief Obsługuje zakończenie odpowiedzi sieciowej.
- * Przetwarza dane w zależności od typu zapytania.
+ * Odpowiedź 304 jest zastępowana kopią z pamięci dyskowej, a nowa treść jest w niej zapisywana.
+ * W razie błędu sieci używana jest nieaktualna kopia, jeśli istnieje.
+ * Wynik trafia do wszystkich żądań oczekujących na ten sam adres; odpowiedź na anulowane żądanie jest pomijana.
  *
  * @param reply Wskaźnik do obiektu odpowiedzi sieciowej.
  */
 void APIService::onReplyFinished(QNetworkReply *reply) {
-    QString url = reply->url().toString();
-    if (reply->error() != QNetworkReply::NoError) {
-        int httpStatus = reply->attribute(
-                                  QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    const QNetworkRequest request = reply->request();
+    QString url = request.url().toString();
+    int httpStatus = reply->attribute(
+                              QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    PamiecOdpowiedzi::Wpis wpis;
+
+    // Brak oczekujących oznacza żądanie anulowane przez nowszy wybór - odpowiedź jest pomijana.
+    const QVector<QNetworkRequest> oczekujace = wToku.take(url);
+    if (oczekujace.isEmpty()) {
+        reply->deleteLater();
+        return;
+    }
 
+    if (reply->error() != QNetworkReply::NoError) {
         if (url.contains("data/getData") && httpStatus == 400) {
-            emit danePomiarowePobrane(QJsonArray(), "Brak danych bieżących");
+            if (dlaWidoku(oczekujace))
+                emit danePomiarowePobrane(SeriaPomiarowa("Brak danych bieżących"));
+            oznaczPobranieWTle(oczekujace, true);
+            reply->deleteLater();
+            return;
+        }
+
+        if (pamiecDyskowa.znajdz(request.url(), &wpis)) {
+            qWarning() << "Błąd sieci, użyto nieaktualnej kopii odpowiedzi:" << url;
+            przetworzOdpowiedz(oczekujace, wpis.tresc);
             reply->deleteLater();
             return;
         }
 
-        emit blad("Błąd sieci: " + reply->errorString());
+        if (dlaWidoku(oczekujace))
+            emit blad("Błąd sieci: " + reply->errorString());
+        oznaczPobranieWTle(oczekujace, false);
+        pominStroneStacji(url);
+        reply->deleteLater();
+        return;
+    }
+
+    if (httpStatus == 304) {
+        if (pamiecDyskowa.znajdz(request.url(), &wpis)) {
+            pamiecDyskowa.odswiez(request.url(), wpis);
+            if (przetworzOdpowiedz(oczekujace, wpis.tresc))
+                waznoscCache.insert(url, QDateTime::currentMSecsSinceEpoch() + PamiecOdpowiedzi::czasZycia(request.url()));
+        } else {
+            if (dlaWidoku(oczekujace))
+                emit blad("Brak zapisanej kopii dla odpowiedzi 304");
+            oznaczPobranieWTle(oczekujace, false);
+            pominStroneStacji(url);
+        }
         reply->deleteLater();
         return;
     }
 
     QByteArray response = reply->readAll();
+    if (przetworzOdpowiedz(oczekujace, response)) {
+        pamiecDyskowa.zapisz(request.url(), response,
+                             reply->rawHeader("ETag"), reply->rawHeader("Last-Modified"));
+        waznoscCache.insert(url, QDateTime::currentMSecsSinceEpoch() + PamiecOdpowiedzi::czasZycia(request.url()));
+    }
+
+    reply->deleteLater();
+}
+
+/**
+ * @brief Dekoduje treść odpowiedzi i przekazuje dokument dalej.
+ *
+ * Treść jest dekodowana raz; zdekodowany dokument trafia do pamięci podręcznej, z której kolejne
+ * trafienia są przetwarzane bez ponownego parsowania.
+ *
+ * @param oczekujace Żądania oczekujące na odpowiedź (ten sam adres).
+ * @param response Treść odpowiedzi.
+ * @return true jeśli treść była poprawnym dokumentem JSON.
+ */
+bool APIService::przetworzOdpowiedz(const QVector<QNetworkRequest>& oczekujace, const QByteArray& response) {
+    if (oczekujace.isEmpty())
+        return false;
+
+    QString url = oczekujace.first().url().toString();
     QJsonDocument doc = QJsonDocument::fromJson(response);
 
     if (doc.isNull()) {
-        emit blad("Nieprawidłowy format JSON");
-        reply->deleteLater();
-        return;
+        if (dlaWidoku(oczekujace))
+            emit blad("Nieprawidłowy format JSON");
+        oznaczPobranieWTle(oczekujace, false);
+        pominStroneStacji(url);
+        return false;
     }
 
-    cache.insert(url, new QJsonDocument(doc));
-
-    if (reply->request().rawHeader("X-Geo-Filtr") == "1") {
-        double lat = reply->request().attribute(QNetworkRequest::User).toDouble();
-        double lon = reply->request().attribute(QNetworkRequest::UserMax).toDouble();
-        double promienKm = reply->request().attribute(QNetworkRequest::HttpPipeliningAllowedAttribute).toDouble();
+    cache.wstaw(url, QSharedPointer<const QJsonDocument>::create(doc), response.size());
+    przetworzDokument(oczekujace, doc);
+    return true;
+}
 
-        filtrujStacjeWPromieniu(lat, lon, promienKm);
-        reply->deleteLater();
+/**
+ * @brief Kieruje dokument odpowiedzi do metody przetwarzającej właściwej dla endpointu.
+ *
+ * Dla listy stacji rejestr jest budowany raz, a wynik filtrowany osobno dla każdego
+ * oczekującego żądania (wszystkie stacje, miasto, promień).
+ * Pierwsza strona listy stacji podaje liczbę stron (totalPages); pozostałe strony są wtedy
+ * pobierane równolegle, dołączane do rejestru i rozsyłane do tych samych odbiorców.
+ * Odpowiedzi pobierania całej sieci trafiają do pamięci podręcznej i dziennika, ale nie do widoków
+ * ani do automatycznie zapisywanego pliku danych.
+ *
+ * @param oczekujace Żądania oczekujące na odpowiedź (ten sam adres).
+ * @param doc Dokument odpowiedzi.
+ */
+void APIService::przetworzDokument(const QVector<QNetworkRequest>& oczekujace, const QJsonDocument& doc) {
+    if (oczekujace.isEmpty())
         return;
-    }
+
+    QString url = oczekujace.first().url().toString();
+    const bool widok = dlaWidoku(oczekujace);
 
     if (url.contains("station/findAll")) {
 
         QJsonArray stacje;
+        int liczbaStron = 1;
 
         if (doc.isArray()) {
             stacje = doc.array();
@@ -195,94 +623,69 @@ void APIService::onReplyFinished(QNetworkReply *reply) {
                 stacje =
                     obj["Lista stacji pomiarowych"].toArray();
             }
+            liczbaStron = qMax(1, obj["totalPages"].toInt(1));
         }
 
-        if (reply->request().url().query().contains("miasto")) {
-
-            QString miasto =
-                reply->request().url().query().split("=")[1];
-
-            QJsonArray przefiltrowane =
-                filtrujStacjePoMiescie(stacje, miasto);
+        // Lista pobrana tylko w tle zasila rejestr, ale nie bieżące dane ani plik danych.
+        if (numerStrony(url) == 0) {
+            if (widok)
+                aktualneDane["stacje"] = stacje;
+            rejestr.zbuduj(stacje);
+
+            odbiorcyStacji += oczekujace;
+            pozostaleStronyStacji = liczbaStron - 1;
+
+            // Kolejne strony idą naraz; liczbę równoczesnych zapytań ogranicza harmonogram.
+            const bool tylkoWTle = !widok;
+            for (int strona = 1; strona < liczbaStron; ++strona) {
+                if (tylkoWTle)
+                    pobierzWTle(zadanieListyStacji(strona));
+                else
+                    pobierzListeStacji(zadanieListyStacji(strona));
+            }
+        } else {
+            if (widok) {
+                QJsonArray wszystkie = aktualneDane["stacje"].toArray();
+                for (const QJsonValue& stacja : stacje)
+                    wszystkie.append(stacja);
+                aktualneDane["stacje"] = wszystkie;
+            }
+            rejestr.scal(stacje);
 
-            emit daneStacjiPobrane(przefiltrowane);
-        }
-        else {
-            emit daneStacjiPobrane(stacje);
+            if (pozostaleStronyStacji > 0)
+                --pozostaleStronyStacji;
         }
+
+        if (widok)
+            zapiszDaneAutomatycznie("stacje");
+        rozeslijStacje(pozostaleStronyStacji == 0);
     }
     else if (url.contains("station/sensors")) {
-        przetworzOdpowiedzStanowiska(response);
+        const QJsonArray stanowiska = przetworzOdpowiedzStanowiska(doc, widok);
+        if (pobieranieSieci.aktywne && dlaPobieraniaSieci(oczekujace)) {
+            for (const QJsonValue& stanowisko : stanowiska)
+                pobierzWTle(QNetworkRequest(adresEndpointu(
+                    QString("data/getData/%1").arg(stanowisko.toObject()["id"].toInt()))));
+        }
     }
     else if (url.contains("data/getData")) {
-        przetworzOdpowiedzPomiary(response);
+        przetworzOdpowiedzPomiary(doc, url.section('/', -1).toInt(), widok);
     }
     else if (url.contains("aqindex/getIndex")) {
-        przetworzOdpowiedzIndeks(response);
+        przetworzOdpowiedzIndeks(doc);
     }
 
-    reply->deleteLater();
-}
-
-/**
- * @brief Przetwarza odpowiedź JSON zawierającą listę stacji.
- *
- * @param odpowiedz Dane odpowiedzi w postaci bajtów.
- */
-void APIService::przetworzOdpowiedzStacje(const QByteArray& odpowiedz) {
-    qDebug().noquote() << "RAW RESPONSE:";
-    qDebug().noquote() << odpowiedz;
-
-    QJsonParseError err;
-    QJsonDocument doc = QJsonDocument::fromJson(odpowiedz, &err);
-
-    if (err.error != QJsonParseError::NoError) {
-        emit blad("Błąd parsowania JSON: " + err.errorString());
-        return;
-    }
-
-    QJsonArray stacje;
-
-
-    if (doc.isArray()) {
-        stacje = doc.array();
-    }
-
-
-    else if (doc.isObject()) {
-        QJsonObject obj = doc.object();
-
-        if (obj.contains("Lista stacji pomiarowych") &&
-            obj["Lista stacji pomiarowych"].isArray()) {
-
-            stacje = obj["Lista stacji pomiarowych"].toArray();
-        }
-        else {
-            emit blad("JSON nie zawiera tablicy stacji");
-            qDebug().noquote() << "OBJECT:";
-            qDebug() << obj;
-            return;
-        }
-    }
-    else {
-        emit blad("Nieprawidłowy format JSON");
-        return;
-    }
-
-    aktualneDane["stacje"] = stacje;
-
-    zapiszDaneAutomatycznie();
-
-    emit daneStacjiPobrane(stacje);
+    oznaczPobranieWTle(oczekujace, true);
 }
 
 /**
  * @brief Przetwarza odpowiedź JSON zawierającą listę stanowisk.
  *
- * @param odpowiedz Dane odpowiedzi w postaci bajtów.
+ * @param doc Dokument odpowiedzi.
+ * @param dlaWidoku Czy wynik ma trafić do widoku (sygnał i bieżące dane).
+ * @return QJsonArray Znormalizowana lista stanowisk.
  */
-void APIService::przetworzOdpowiedzStanowiska(const QByteArray& odpowiedz) {
-    QJsonDocument doc = QJsonDocument::fromJson(odpowiedz);
+QJsonArray APIService::przetworzOdpowiedzStanowiska(const QJsonDocument& doc, bool dlaWidoku) {
     QJsonArray stanowiska;
 
     if (doc.isArray()) {
@@ -306,8 +709,9 @@ void APIService::przetworzOdpowiedzStanowiska(const QByteArray& odpowiedz) {
     }
 
     if (stanowiska.isEmpty()) {
-        emit blad("Brak stanowisk w odpowiedzi JSON");
-        return;
+        if (dlaWidoku)
+            emit blad("Brak stanowisk w odpowiedzi JSON");
+        return QJsonArray();
     }
 
 
@@ -332,20 +736,25 @@ void APIService::przetworzOdpowiedzStanowiska(const QByteArray& odpowiedz) {
         }
     }
 
-    aktualneDane["stanowiska"] = znormalizowane;
-    zapiszDaneAutomatycznie();
-    emit daneStanowiskPobrane(znormalizowane);
+    if (dlaWidoku) {
+        aktualneDane["stanowiska"] = znormalizowane;
+        zapiszDaneAutomatycznie("stanowiska");
+        emit daneStanowiskPobrane(znormalizowane);
+    }
+    return znormalizowane;
 }
 
 /**
  * @brief Przetwarza odpowiedź JSON z danymi pomiarowymi.
  *
- * @param odpowiedz Dane odpowiedzi w postaci bajtów.
+ * @param doc Dokument odpowiedzi.
+ * @param stanowiskoId Identyfikator stanowiska.
+ * @param dlaWidoku Czy wynik ma trafić do widoku; w przeciwnym razie seria jest tylko dopisywana do dziennika.
  */
-void APIService::przetworzOdpowiedzPomiary(const QByteArray& odpowiedz) {
-    QJsonDocument doc = QJsonDocument::fromJson(odpowiedz);
+void APIService::przetworzOdpowiedzPomiary(const QJsonDocument& doc, int stanowiskoId, bool dlaWidoku) {
     if (!doc.isObject()) {
-        emit blad("Oczekiwano obiektu JSON dla pomiarów");
+        if (dlaWidoku)
+            emit blad("Oczekiwano obiektu JSON dla pomiarów");
         return;
     }
 
@@ -353,10 +762,7 @@ void APIService::przetworzOdpowiedzPomiary(const QByteArray& odpowiedz) {
 
 
     if (obj.contains("key") && obj.contains("values")) {
-        QString parametrKod = obj["key"].toString();
-        aktualneDane["pomiary"] = obj;
-        zapiszDaneAutomatycznie();
-        emit danePomiarowePobrane(obj["values"].toArray(), parametrKod);
+        opublikujPomiary(stanowiskoId, obj, dlaWidoku);
         return;
     }
 
@@ -370,7 +776,8 @@ void APIService::przetworzOdpowiedzPomiary(const QByteArray& odpowiedz) {
     }
 
     if (lista.isEmpty()) {
-        emit blad("Brak danych pomiarowych w odpowiedzi");
+        if (dlaWidoku)
+            emit blad("Brak danych pomiarowych w odpowiedzi");
         return;
     }
 
@@ -391,65 +798,250 @@ void APIService::przetworzOdpowiedzPomiary(const QByteArray& odpowiedz) {
         QJsonObject p = val.toObject();
         QJsonObject znorm;
         znorm["date"]  = p["Data"].toString();
-        znorm["value"] = p[QString::fromUtf8("Wartość")].toDouble();
+        znorm["value"] = p[QString::fromUtf8("Wartość")];
         znormalizowane.append(znorm);
     }
 
     QJsonObject zapiszObj;
     zapiszObj["key"]    = parametrKod;
     zapiszObj["values"] = znormalizowane;
-    aktualneDane["pomiary"] = zapiszObj;
-    zapiszDaneAutomatycznie();
-    emit danePomiarowePobrane(znormalizowane, parametrKod);
+    opublikujPomiary(stanowiskoId, zapiszObj, dlaWidoku);
 }
 
 /**
- * @brief Przetwarza odpowiedź JSON z indeksem jakości powietrza.
+ * @brief Zapisuje znormalizowane pomiary i przekazuje je do widoku.
  *
- * @param odpowiedz Dane odpowiedzi w postaci bajtów.
+ * Pierwsze pobranie stanowiska w sesji wczytuje jego historię z dziennika. Przy kolejnych
+ * pobraniach okno z API jest scalane z zapamiętaną historią w miejscu (SeriaPomiarowa::scal),
+ * do dziennika trafiają tylko nowe i zmienione próbki, a sekcja "pomiary" nie jest przebudowywana.
+ *
+ * @param stanowiskoId Identyfikator stanowiska.
+ * @param pomiary Obiekt {"key", "values"}.
+ * @param dlaWidoku Czy wynik ma trafić do widoku.
  */
-void APIService::przetworzOdpowiedzIndeks(const QByteArray& odpowiedz) {
-    QJsonDocument doc = QJsonDocument::fromJson(odpowiedz);
-    if (!doc.isObject()) {
-        emit blad("Oczekiwano obiektu JSON");
+void APIService::opublikujPomiary(int stanowiskoId, const QJsonObject& pomiary, bool dlaWidoku) {
+    const SeriaPomiarowa seria = SeriaPomiarowa::fromJson(pomiary);
+
+    auto historia = historie.find(stanowiskoId);
+    if (historia == historie.end()) {
+        if (!dlaWidoku) {
+            // Dopisanie próbki starszej od ostatniej uwzględnionej w statystykach to poprawka danych,
+            // więc statystyki są budowane od nowa; inaczej dochodzą tylko nowsze próbki.
+            qint64 pierwszyDopisany = std::numeric_limits<qint64>::max();
+            dziennik.dopisz(stanowiskoId, seria, &pierwszyDopisany);
+            const auto biezace = statystyki.constFind(stanowiskoId);
+            const bool poprawka = biezace != statystyki.constEnd() && !biezace->jestPusta() &&
+                                  pierwszyDopisany <= biezace->ostatniCzas();
+            aktualizujStatystyki(stanowiskoId, seria, poprawka, true);
+            return;
+        }
+
+        aktualneDane["pomiary"] = pomiary;
+        zapiszDaneAutomatycznie("pomiary");
+        historia = historie.insert(stanowiskoId, dolaczDoDziennika(stanowiskoId, seria));
+        uzyjHistorii(stanowiskoId);
+        aktualizujStatystyki(stanowiskoId, historia.value(), true, false);
+        emit danePomiarowePobrane(historia.value());
         return;
     }
-    aktualneDane["indeks"] = doc.object();
-    zapiszDaneAutomatycznie();
-    emit indeksJakosciPobrany(doc.object());
+
+    if (dlaWidoku)
+        uzyjHistorii(stanowiskoId);
+
+    SeriaPomiarowa roznica(seria.parametr());
+    const SeriaPomiarowa::Scalenie wynik = historia->scal(seria, &roznica);
+    if (!roznica.jestPusta() && dziennik.jestOtwarty())
+        dziennik.dopisz(stanowiskoId, roznica);
+    aktualizujStatystyki(stanowiskoId, historia.value(), wynik.zmienione > 0 || wynik.wstawione > 0, false);
+
+    if (!dlaWidoku)
+        return;
+
+    // Bez zmian we wcześniejszych próbkach różnica zawiera dokładnie próbki dopisane na końcu.
+    if (wynik.zmienione > 0 || wynik.wstawione > 0)
+        emit danePomiarowePobrane(historia.value());
+    else
+        emit pomiaryDolaczone(stanowiskoId, roznica);
 }
 
 /**
- * @brief Filtrowanie stacji na podstawie nazwy miasta.
+ * @brief Oznacza historię stanowiska jako ostatnio używaną.
  *
- * @param stacje Tablica stacji.
- * @param miasto Nazwa miasta do filtrowania.
- * @return QJsonArray Lista stacji spełniających warunek.
+ * Po przekroczeniu MAKS_HISTORII usuwana jest historia stanowiska najdawniej używanego;
+ * jej próbki pozostają w dzienniku.
+ *
+ * @param stanowiskoId Identyfikator stanowiska.
  */
-QJsonArray APIService::filtrujStacjePoMiescie(const QJsonArray& stacje, const QString& miasto) {
-    QJsonArray wynik;
-    QString szukaneMiasto = miasto.toLower();
+void APIService::uzyjHistorii(int stanowiskoId) {
+    kolejnoscHistorii.removeOne(stanowiskoId);
+    kolejnoscHistorii.append(stanowiskoId);
+
+    while (kolejnoscHistorii.size() > MAKS_HISTORII)
+        historie.remove(kolejnoscHistorii.takeFirst());
+}
+
+/**
+ * @brief Dopisuje serię do dziennika i zwraca historię stanowiska.
+ *
+ * @param stanowiskoId Identyfikator stanowiska.
+ * @param seria Seria pobrana z API.
+ * @return SeriaPomiarowa Pełna historia stanowiska.
+ */
+SeriaPomiarowa APIService::dolaczDoDziennika(int stanowiskoId, const SeriaPomiarowa& seria) {
+    if (!dziennik.jestOtwarty() || seria.jestPusta())
+        return seria;
+
+    dziennik.dopisz(stanowiskoId, seria);
+
+    SeriaPomiarowa historia = dziennik.wczytaj(stanowiskoId);
+    historia.setParametr(seria.parametr());
+    return historia;
+}
+
+/**
+ * @brief Uzupełnia statystyki stanowiska o nowe próbki albo buduje je od nowa.
+ *
+ * Zwykle dochodzą tylko próbki z ostatnich godzin, więc aktualizacja kosztuje tyle,
+ * ile liczba nowych próbek. Przy pierwszym użyciu stanowiska i po zmianie wcześniejszych wartości
+ * statystyki są liczone od nowa: archiwum uzupełnia tylko okres sprzed pierwszej próbki dziennika
+ * lub serii (jak w WidokSklejony), a dziennik jest czytany blokami dekodera bez budowania serii.
+ *
+ * @param stanowiskoId Identyfikator stanowiska.
+ * @param seria Seria stanowiska.
+ * @param odNowa Czy zbudować statystyki od początku.
+ * @param zDziennika Czy przejrzeć dziennik przy budowaniu od nowa.
+ */
+void APIService::aktualizujStatystyki(int stanowiskoId, const SeriaPomiarowa& seria, bool odNowa, bool zDziennika) {
+    auto biezace = statystyki.find(stanowiskoId);
+    if (biezace == statystyki.end()) {
+        biezace = statystyki.insert(stanowiskoId, StatystykiStrumieniowe());
+        odNowa = true;
+    }
+
+    if (!odNowa) {
+        if (biezace->dodaj(seria.calosc()) > 0)
+            emit statystykiZaktualizowane(stanowiskoId);
+        return;
+    }
 
-    for (const QJsonValue& val : stacje) {
-        QJsonObject stacja = val.toObject();
-        QString aktualneMiasto =
-            stacja["Nazwa miasta"].toString().toLower();
+    StatystykiStrumieniowe& statystykiStanowiska = biezace.value();
+    statystykiStanowiska.wyczysc();
 
-        if (aktualneMiasto.contains(szukaneMiasto)) {
-            wynik.append(stacja);
+    const WidokSerii archiwum = magazyn && magazyn->zawiera(stanowiskoId) ? magazyn->seria(stanowiskoId)
+                                                                          : WidokSerii();
+    bool archiwumDodane = archiwum.jestPusty();
+    auto dodaj = [&](const WidokSerii& blok) {
+        if (blok.jestPusty())
+            return;
+        if (!archiwumDodane) {
+            statystykiStanowiska.dodaj(archiwum.zakres(std::numeric_limits<qint64>::min(), blok.pierwszyCzas() - 1));
+            archiwumDodane = true;
         }
+        statystykiStanowiska.dodaj(blok);
+    };
+
+    if (zDziennika && dziennik.jestOtwarty())
+        dziennik.przegladaj(stanowiskoId, std::numeric_limits<qint64>::min(), std::numeric_limits<qint64>::max(), dodaj);
+    dodaj(seria.calosc());
+    if (!archiwumDodane)
+        statystykiStanowiska.dodaj(archiwum);
+
+    emit statystykiZaktualizowane(stanowiskoId);
+}
+
+/**
+ * @brief Zwraca statystyki stanowiska.
+ *
+ * @param stanowiskoId Identyfikator stanowiska.
+ * @return StatystykiStrumieniowe Statystyki (puste dla nieznanego stanowiska).
+ */
+StatystykiStrumieniowe APIService::statystykiStanowiska(int stanowiskoId) const {
+    return statystyki.value(stanowiskoId);
+}
+
+/**
+ * @brief Zwraca scaloną historię stanowiska.
+ *
+ * @param stanowiskoId Identyfikator stanowiska.
+ * @return SeriaPomiarowa Historia (pusta dla stanowiska spoza pamięci).
+ */
+SeriaPomiarowa APIService::historiaStanowiska(int stanowiskoId) const {
+    return historie.value(stanowiskoId);
+}
+
+/**
+ * @brief Przetwarza odpowiedź JSON z indeksem jakości powietrza.
+ *
+ * @param doc Dokument odpowiedzi.
+ */
+void APIService::przetworzOdpowiedzIndeks(const QJsonDocument& doc) {
+    if (!doc.isObject()) {
+        emit blad("Oczekiwano obiektu JSON");
+        return;
     }
+    aktualneDane["indeks"] = doc.object();
+    zapiszDaneAutomatycznie("indeks");
+    emit indeksJakosciPobrany(doc.object());
+}
 
-    return wynik;
+/**
+ * @brief Filtrowanie stacji z rejestru na podstawie nazwy miasta.
+ *
+ * @param miasto Nazwa miasta do filtrowania (wielkość liter nie ma znaczenia).
+ * @return QVector<int> Numery wierszy stacji spełniających warunek.
+ */
+QVector<int> APIService::filtrujStacjePoMiescie(const QString& miasto) const {
+    return rejestr.wMiescie(miasto);
 }
 
 /**
  * @brief Zapisuje dane (w tym cache) do pliku JSON.
  *
+ * Dla rozszerzenia ".kol" historia wszystkich stanowisk z dziennika jest zapisywana w magazynie kolumnowym,
+ * a dla ".cbor" pamięć podręczna jest zapisywana strumieniowo w formacie binarnym (MigawkaCbor).
+ * Dziennik jest używany tylko w wątku GUI, więc wątek zapisu magazynu prosi go kolejno o jedno
+ * stanowisko, którego bloki trafiają prosto do kolumn zapisu (MagazynKolumnowy::Zapis).
+ *
  * @param sciezka Ścieżka pliku, do którego zapisywane są dane.
  * @return true Jeśli operacja została rozpoczęta.
  */
 bool APIService::zapiszDaneDoPliku(const QString& sciezka) {
+    if (sciezka.endsWith(".kol", Qt::CaseInsensitive)) {
+        const QVector<int> stanowiska = dziennik.stanowiska();
+
+        QtConcurrent::run([=]() {
+            MagazynKolumnowy::Zapis zapis(sciezka, stanowiska.size());
+            for (int id : stanowiska) {
+                QString parametr;
+                QMetaObject::invokeMethod(this, [&]() {
+                    parametr = dziennik.przegladaj(id, std::numeric_limits<qint64>::min(), std::numeric_limits<qint64>::max(),
+                                                   [&zapis](const WidokSerii& blok) { zapis.dopisz(blok); });
+                }, Qt::BlockingQueuedConnection);
+                if (!zapis.zakonczStanowisko(id, parametr))
+                    break;
+            }
+            bool sukces = zapis.zatwierdz();
+            QMetaObject::invokeMethod(this, [=]() {
+                emit daneZapisane(sukces);
+            }, Qt::QueuedConnection);
+        });
+        return true;
+    }
+
+    if (sciezka.endsWith(".cbor", Qt::CaseInsensitive)) {
+        QtConcurrent::run([=]() {
+            QSaveFile plik(sciezka);
+            bool sukces = plik.open(QIODevice::WriteOnly) &&
+                          MigawkaCbor::zapisz(&plik, cache.migawka()) &&
+                          plik.commit();
+
+            QMetaObject::invokeMethod(this, [=]() {
+                emit daneZapisane(sukces);
+            }, Qt::QueuedConnection);
+        });
+        return true;
+    }
+
     QtConcurrent::run([=]() {
         QFile file(sciezka);
         bool sukces = false;
@@ -458,10 +1050,8 @@ bool APIService::zapiszDaneDoPliku(const QString& sciezka) {
             QJsonObject mainObject;
 
             QJsonObject cacheObject;
-            for (const QString& url : cache.keys()) {
-                if (const QJsonDocument* doc = cache[url]) {
-                    cacheObject[url] = doc->object();
-                }
+            for (const auto& wpis : cache.migawka()) {
+                cacheObject[wpis.first] = wpis.second->object();
             }
             mainObject["cache"] = cacheObject;
 
@@ -481,10 +1071,55 @@ bool APIService::zapiszDaneDoPliku(const QString& sciezka) {
 /**
  * @brief Wczytuje dane (w tym cache) z pliku JSON.
  *
+ * Plik ".kol" jest tylko mapowany do pamięci, więc otwierany jest od razu, w bieżącym wątku.
+ * Plik ".cbor" jest czytany strumieniowo, a każdy wpis trafia do pamięci podręcznej zaraz po odczytaniu
+ * (PamiecWspolbiezna jest bezpieczna wątkowo).
+ *
  * @param sciezka Ścieżka pliku, z którego dane są ładowane.
  * @return true Jeśli operacja została rozpoczęta.
  */
 bool APIService::wczytajDaneZPliku(const QString& sciezka) {
+    if (sciezka.endsWith(".kol", Qt::CaseInsensitive)) {
+        QSharedPointer<MagazynKolumnowy> archiwum(new MagazynKolumnowy);
+        bool sukces = archiwum->otworz(sciezka);
+        if (sukces) {
+            magazyn = archiwum;
+
+            // Statystyki obejmują archiwum: stanowiska z historią w pamięci są przeliczane od razu,
+            // pozostałe przy następnym pobraniu.
+            const QList<int> zeStatystykami = statystyki.keys();
+            for (int id : zeStatystykami) {
+                const auto historia = historie.constFind(id);
+                if (historia == historie.constEnd())
+                    statystyki.remove(id);
+                else
+                    aktualizujStatystyki(id, historia.value(), true, false);
+            }
+        }
+
+        QMetaObject::invokeMethod(this, [=]() {
+            emit daneWczytane(sukces);
+        }, Qt::QueuedConnection);
+        return true;
+    }
+
+    if (sciezka.endsWith(".cbor", Qt::CaseInsensitive)) {
+        QtConcurrent::run([=]() {
+            QFile plik(sciezka);
+            bool sukces = plik.open(QIODevice::ReadOnly) &&
+                          MigawkaCbor::wczytaj(&plik, [this](const QString& url, const QJsonDocument& dokument,
+                                                             qint64 rozmiar) {
+                              // Koszt to rozmiar wpisu w pliku CBOR (bez ponownej serializacji do JSON).
+                              cache.wstaw(url, QSharedPointer<const QJsonDocument>::create(dokument), rozmiar);
+                          });
+
+            QMetaObject::invokeMethod(this, [=]() {
+                emit daneWczytane(sukces);
+            }, Qt::QueuedConnection);
+        });
+        return true;
+    }
+
     QtConcurrent::run([=]() {
         QFile file(sciezka);
         bool sukces = false;
@@ -499,7 +1134,9 @@ bool APIService::wczytajDaneZPliku(const QString& sciezka) {
                 if (mainObject.contains("cache")) {
                     QJsonObject cacheObject = mainObject["cache"].toObject();
                     for (const QString& url : cacheObject.keys()) {
-                        cache.insert(url, new QJsonDocument(cacheObject[url].toObject()));
+                        QSharedPointer<const QJsonDocument> wpis =
+                            QSharedPointer<const QJsonDocument>::create(cacheObject[url].toObject());
+                        cache.wstaw(url, wpis, wpis->toJson(QJsonDocument::Compact).size());
                     }
                 }
 
@@ -524,51 +1161,58 @@ bool APIService::wczytajDaneZPliku(const QString& sciezka) {
  * @param promienKm Promień w kilometrach.
  */
 void APIService::znajdzStacjeWPromieniu(const QString& lokalizacja, double promienKm) {
-    QGeoServiceProvider *geoService = new QGeoServiceProvider("osm");
-    QGeoCodingManager *geoManager = geoService->geocodingManager();
-
-    if (!geoManager) {
-        emit blad("Nie można zainicjować usługi geokodowania");
+    const SkorowidzMiejsc::Rozpoznanie lokalne = skorowidz.rozwiaz(lokalizacja);
+    const QGeoCoordinate przyblizone = lokalne.znaleziono
+        ? QGeoCoordinate(lokalne.miejsce.lat, lokalne.miejsce.lon) : QGeoCoordinate();
+    if (lokalne.dokladne) {
+        szukajStacjiWPromieniu(przyblizone, promienKm);
         return;
     }
 
-    QGeoCodeReply *reply = geoManager->geocode(lokalizacja);
-    connect(reply, &QGeoCodeReply::finished, [this, reply, promienKm]() {
-        if (reply->error() != QGeoCodeReply::NoError) {
-            emit blad("Błąd geokodowania: " + reply->errorString());
-            reply->deleteLater();
-            return;
-        }
+    const QGeoCoordinate zapamietane = pamiecGeokodowania.znajdz(lokalizacja);
+    if (zapamietane.isValid()) {
+        szukajStacjiWPromieniu(zapamietane, promienKm);
+        return;
+    }
 
-        QList<QGeoLocation> locations = reply->locations();
-        if (locations.isEmpty()) {
-            emit blad("Nie znaleziono lokalizacji");
-            reply->deleteLater();
+    geokoder->geokoduj(lokalizacja, [this, lokalizacja, promienKm, przyblizone](const QGeoCoordinate& coord, const QString& komunikat) {
+        if (!coord.isValid()) {
+            if (przyblizone.isValid()) {
+                qWarning() << komunikat << "- użyto przybliżonej lokalizacji ze skorowidza:" << lokalizacja;
+                szukajStacjiWPromieniu(przyblizone, promienKm);
+                return;
+            }
+            emit blad(komunikat);
             return;
         }
 
-        QGeoCoordinate coord = locations.first().coordinate();
-
-        if (cache.contains("https://api.gios.gov.pl/pjp-api/v1/rest/station/findAll")) {
-            QtConcurrent::run([=]() {
-                filtrujStacjeWPromieniu(coord.latitude(), coord.longitude(), promienKm);
-            });
-        } else {
-            QUrl url("https://api.gios.gov.pl/pjp-api/v1/rest/station/findAll");
-            QNetworkRequest request(url);
-
-            request.setAttribute(QNetworkRequest::User, coord.latitude());
-            request.setAttribute(QNetworkRequest::UserMax, coord.longitude());
-            request.setAttribute(QNetworkRequest::HttpPipeliningAllowedAttribute, promienKm);
-            request.setRawHeader("X-Geo-Filtr", "1");
-
-            networkManager->get(request);
-        }
-
-        reply->deleteLater();
+        pamiecGeokodowania.zapisz(lokalizacja, coord);
+        szukajStacjiWPromieniu(coord, promienKm);
     });
 }
 
+/**
+ * @brief Filtruje stacje w promieniu od współrzędnych lub pobiera listę stacji z filtrem promienia.
+ *
+ * @param wspolrzedne Środek obszaru.
+ * @param promienKm Promień w kilometrach.
+ */
+void APIService::szukajStacjiWPromieniu(const QGeoCoordinate& wspolrzedne, double promienKm) {
+    QNetworkRequest request = zadanieListyStacji();
+
+    request.setAttribute(QNetworkRequest::User, wspolrzedne.latitude());
+    request.setAttribute(QNetworkRequest::UserMax, wspolrzedne.longitude());
+    request.setAttribute(QNetworkRequest::HttpPipeliningAllowedAttribute, promienKm);
+    request.setRawHeader("X-Geo-Filtr", "1");
+
+    if (!rejestr.jestPusty()) {
+        filtrujStacjeWPromieniu(wspolrzedne.latitude(), wspolrzedne.longitude(), promienKm);
+        czekajNaStronyStacji(request);
+    } else {
+        pobierzListeStacji(request);
+    }
+}
+
 /**
  * @brief Oblicza odległość między dwoma punktami geograficznymi.
  *
@@ -579,18 +1223,7 @@ void APIService::znajdzStacjeWPromieniu(const QString& lokalizacja, double promi
  * @return double Odległość w kilometrach.
  */
 double APIService::obliczOdleglosc(double lat1, double lon1, double lat2, double lon2) {
-    const double R = 6371.0;
-
-    double dLat = qDegreesToRadians(lat2 - lat1);
-    double dLon = qDegreesToRadians(lon2 - lon1);
-
-    double a = qSin(dLat / 2) * qSin(dLat / 2) +
-               qCos(qDegreesToRadians(lat1)) * qCos(qDegreesToRadians(lat2)) *
-                   qSin(dLon / 2) * qSin(dLon / 2);
-
-    double c = 2 * qAtan2(qSqrt(a), qSqrt(1 - a));
-
-    return R * c;
+    return Odleglosci::haversine(lat1, lon1, lat2, lon2);
 }
 
 /**
@@ -602,47 +1235,41 @@ double APIService::obliczOdleglosc(double lat1, double lon1, double lat2, double
  * @param promienKm Promień w kilometrach.
  */
 void APIService::filtrujStacjeWPromieniu(double lat, double lon, double promienKm) {
-    const QString urlKey = "https://api.gios.gov.pl/pjp-api/v1/rest/station/findAll?size=500";
-    if (!cache.contains(urlKey)) return;
-
-    QJsonDocument* cachedDoc = cache[urlKey];
-    QJsonArray wszystkieStacje;
-    if (cachedDoc->isObject()) {
-        QJsonObject obj = cachedDoc->object();
-        if (obj.contains("Lista stacji pomiarowych"))
-            wszystkieStacje = obj["Lista stacji pomiarowych"].toArray();
-    } else if (cachedDoc->isArray()) {
-        wszystkieStacje = cachedDoc->array();
-    }
-
-    const QString klatN = QString::fromUtf8("WGS84 \xCF\x86 N"); // φ
-    const QString klatE = QString::fromUtf8("WGS84 \xCE\xBB E"); // λ
-
-    QJsonArray stacjeWPromieniu;
-    for (const QJsonValue& val : wszystkieStacje) {
-        QJsonObject stacja = val.toObject();
-        double sLat = stacja[klatN].toString().toDouble();
-        double sLon = stacja[klatE].toString().toDouble();
-        double odleglosc = obliczOdleglosc(lat, lon, sLat, sLon);
-        if (odleglosc <= promienKm) {
-            QJsonObject kopia = stacja;
-            kopia["distance"] = odleglosc;
-            stacjeWPromieniu.append(kopia);
-        }
-    }
+    if (rejestr.jestPusty()) return;
 
-    QList<QJsonObject> stacjeList;
-    for (const QJsonValue& val : stacjeWPromieniu)
-        stacjeList.append(val.toObject());
+    QVector<int> wiersze;
+    for (const IndeksPrzestrzenny::Wynik& w : rejestr.wPromieniu(lat, lon, promienKm))
+        wiersze.append(w.indeks);
 
-    std::sort(stacjeList.begin(), stacjeList.end(),
-              [](const QJsonObject& a, const QJsonObject& b) {
-                  return a["distance"].toDouble() < b["distance"].toDouble();
-              });
+    emit daneStacjiPobrane(wiersze);
+}
 
-    QJsonArray sortedArray;
-    for (const QJsonObject& o : stacjeList)
-        sortedArray.append(o);
+/**
+ * @brief Zwraca k stacji najbliższych podanemu punktowi.
+ *
+ * @param lat Szerokość geograficzna punktu odniesienia.
+ * @param lon Długość geograficzna punktu odniesienia.
+ * @param k Maksymalna liczba stacji.
+ * @return Numery wierszy rejestru wraz z odległościami.
+ */
+QVector<IndeksPrzestrzenny::Wynik> APIService::najblizszeStacje(double lat, double lon, int k) const {
+    return rejestr.najblizsze(lat, lon, k);
+}
+
+/**
+ * @brief Zwraca rejestr stacji.
+ *
+ * @return Referencja do rejestru stacji.
+ */
+const RejestrStacji& APIService::rejestrStacji() const {
+    return rejestr;
+}
 
-    emit daneStacjiPobrane(sortedArray);
+/**
+ * @brief Zwraca otwarte archiwum historii pomiarów.
+ *
+ * @return Magazyn kolumnowy lub pusty wskaźnik.
+ */
+QSharedPointer<const MagazynKolumnowy> APIService::magazynHistorii() const {
+    return magazyn;
 }
@@ -16,9 +16,27 @@
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QJsonObject>
-#include <QCache>
 #include <QFile>
 #include <QStandardPaths>
+#include <QThread>
+#include <QSharedPointer>
+#include <QHash>
+#include <QGeoCoordinate>
+#include <QScopedPointer>
+
+#include "Rejestr_stacji.h"
+#include "Pamiec_odpowiedzi.h"
+#include "Pamiec_wspolbiezna.h"
+#include "Zapis_w_tle.h"
+#include "Dziennik_pomiarow.h"
+#include "Magazyn_kolumnowy.h"
+#include "Migawka_cbor.h"
+#include "Harmonogram_zadan.h"
+#include "Seria_pomiarowa.h"
+#include "Geokoder.h"
+#include "Pamiec_geokodowania.h"
+#include "Skorowidz_miejsc.h"
+#include "Statystyki_strumieniowe.h"
 
 /**
  * @class APIService
@@ -27,6 +45,15 @@
  * Klasa wykorzystuje QNetworkAccessManager do wysyłania żądań HTTP
  * i przetwarza otrzymane odpowiedzi w formacie JSON. Zapewnia cache'owanie
  * danych oraz automatyczne zapisywanie wyników do pliku.
+ *
+ * Odpowiedzi są zapisywane w dyskowej pamięci podręcznej (PamiecOdpowiedzi) i zwracane
+ * przed zapytaniem sieciowym, dopóki nie minie ich czas ważności; później są rewalidowane
+ * nagłówkami If-None-Match / If-Modified-Since.
+ *
+ * Zapytania przechodzą przez HarmonogramZadan (limit równoczesności, priorytety, ponawianie
+ * przejściowych błędów), więc blad() jest emitowany dopiero po wyczerpaniu prób.
+ * Równoczesne żądania o ten sam adres współdzielą jedno zapytanie sieciowe (wToku);
+ * odpowiedź jest przetwarzana raz i przekazywana wszystkim oczekującym.
  */
 class APIService : public QObject
 {
@@ -38,15 +65,24 @@ public:
      * @brief Konstruktor klasy APIService
      * @param parent Wskaźnik na obiekt rodzica (domyślnie nullptr)
      *
-     * Inicjalizuje menedżera sieci i wczytuje zapisane dane z pliku.
+     * Inicjalizuje menedżera sieci, wątek zapisu i dziennik pomiarów.
+     * Plik danych nie jest wczytywany przy starcie, a dziennik jedynie mapuje swój indeks.
      */
     explicit APIService(QObject *parent = nullptr);
 
+    /**
+     * @brief Destruktor klasy APIService
+     *
+     * Zapisuje oczekujące zmiany danych i zatrzymuje wątek zapisu.
+     */
+    ~APIService();
+
     /**
      * @brief Pobiera wszystkie dostępne stacje pomiarowe
      *
      * Wysyła żądanie GET do endpointa /station/findAll i emituje sygnał
-     * daneStacjiPobrane po otrzymaniu odpowiedzi.
+     * daneStacjiPobrane po otrzymaniu odpowiedzi. Przy liście podzielonej na strony
+     * sygnał jest emitowany ponownie po dołączeniu każdej kolejnej strony.
      */
     void pobierzWszystkieStacje();
 
@@ -86,6 +122,11 @@ public:
      * @brief Zapisuje aktualne dane do pliku
      * @param sciezka Pełna ścieżka do pliku docelowego
      * @return true jeśli zapis się powiódł, false w przeciwnym przypadku
+     *
+     * Dla rozszerzenia ".kol" cała historia z dziennika pomiarów jest zapisywana
+     * w magazynie kolumnowym (MagazynKolumnowy) zamiast w JSON, po jednym stanowisku
+     * naraz i bez wczytywania historii do pamięci, a dla ".cbor"
+     * pamięć podręczna jest zapisywana w binarnym formacie CBOR (MigawkaCbor).
      */
     bool zapiszDaneDoPliku(const QString& sciezka);
 
@@ -93,15 +134,29 @@ public:
      * @brief Wczytuje dane z pliku
      * @param sciezka Pełna ścieżka do pliku źródłowego
      * @return true jeśli wczytanie się powiodło, false w przeciwnym przypadku
+     *
+     * Plik ".kol" jest mapowany do pamięci i staje się archiwum historii (magazynHistorii()).
+     * Plik ".cbor" jest czytany strumieniowo, wpis po wpisie.
      */
     bool wczytajDaneZPliku(const QString& sciezka);
 
+    /**
+     * @brief Zwraca otwarte archiwum historii pomiarów
+     * @return Magazyn kolumnowy lub pusty wskaźnik, jeśli żadne archiwum nie jest otwarte
+     *
+     * Widoki z magazynu są ważne, dopóki istnieje zwrócony wskaźnik.
+     */
+    QSharedPointer<const MagazynKolumnowy> magazynHistorii() const;
+
     /**
      * @brief Wyszukuje stacje w określonym promieniu od lokalizacji
      * @param lokalizacja Adres lub nazwa miejsca (np. "Warszawa, Krakowskie Przedmieście 1")
      * @param promienKm Promień w kilometrach (min 0.1, max 1000)
      *
-     * Wykorzystuje geokodowanie do znalezienia współrzędnych lokalizacji.
+     * Miejscowość, kod pocztowy lub ulica bez numeru są rozpoznawane lokalnie w skorowidzu miejsc.
+     * Dla adresu z numerem budynku (lub nieznanego skorowidzowi) używane jest geokodowanie;
+     * współrzędne adresu wyszukanego wcześniej są brane z pamięci geokodowania bez zapytania sieciowego.
+     * Gdy geokodowanie zawiedzie, używany jest przybliżony wynik ze skorowidza (jeśli jest).
      */
     void znajdzStacjeWPromieniu(const QString& lokalizacja, double promienKm);
 
@@ -113,12 +168,97 @@ public:
      */
     void filtrujStacjeWPromieniu(double lat, double lon, double promienKm);
 
+    /**
+     * @brief Zwraca k stacji najbliższych podanym współrzędnym
+     * @param lat Szerokość geograficzna (WGS84)
+     * @param lon Długość geograficzna (WGS84)
+     * @param k Maksymalna liczba stacji
+     * @return Numery wierszy rejestru stacji wraz z odległościami, posortowane rosnąco
+     */
+    QVector<IndeksPrzestrzenny::Wynik> najblizszeStacje(double lat, double lon, int k) const;
+
+    /**
+     * @brief Zwraca rejestr stacji zbudowany po ostatnim pobraniu listy stacji
+     * @return Referencja do rejestru stacji
+     *
+     * Numery wierszy przekazywane w sygnale daneStacjiPobrane odnoszą się do tego rejestru.
+     */
+    const RejestrStacji& rejestrStacji() const;
+
+    /**
+     * @brief Ustawia adres bazowy API
+     * @param adres Adres bazowy zakończony ukośnikiem (domyślnie https://api.gios.gov.pl/pjp-api/v1/rest/)
+     *
+     * Pozwala skierować zapytania np. do lokalnego serwera testowego.
+     */
+    void ustawAdresBazowy(const QString& adres);
+
+    /**
+     * @brief Ustawia maksymalną liczbę równoczesnych zapytań do API
+     * @param maks Limit zapytań w toku (domyślnie 4)
+     */
+    void ustawLimitZapytan(int maks);
+
+    /**
+     * @brief Zwraca offline'owy skorowidz miejsc (np. do podpowiedzi przy wpisywaniu adresu)
+     * @return Referencja do skorowidza (zamkniętego, jeśli brak pliku skorowidz.skm)
+     */
+    const SkorowidzMiejsc& skorowidzMiejsc() const;
+
+    /**
+     * @brief Zwraca bieżące statystyki stanowiska pobranego w tej sesji (także w tle)
+     * @param stanowiskoId Identyfikator stanowiska
+     * @return Statystyki (puste, jeśli stanowisko nie było pobierane albo nie ma żadnej wartości)
+     *
+     * Przy pierwszym pobraniu statystyki obejmują archiwum historii, dziennik i pobrane próbki;
+     * potem są aktualizowane przyrostowo przy każdej odpowiedzi z pomiarami, a po poprawce
+     * wcześniejszych wartości budowane od nowa. To jedyne źródło statystyk dla widoku.
+     */
+    StatystykiStrumieniowe statystykiStanowiska(int stanowiskoId) const;
+
+    /**
+     * @brief Zwraca scaloną historię stanowiska pobranego w tej sesji
+     * @param stanowiskoId Identyfikator stanowiska
+     * @return Historia (pusta, jeśli stanowiska nie ma wśród ostatnio wyświetlanych)
+     *
+     * Zwrócona seria współdzieli dane z usługą, więc następne scalenie ją skopiuje;
+     * do bieżących aktualizacji służy pomiaryDolaczone().
+     */
+    SeriaPomiarowa historiaStanowiska(int stanowiskoId) const;
+
+    /**
+     * @brief Zastępuje usługę geokodowania
+     * @param nowy Geokoder (APIService przejmuje własność; nullptr przywraca GeokoderOsm)
+     *
+     * Pozwala użyć np. lokalnej atrapy zamiast OpenStreetMap.
+     */
+    void ustawGeokoder(Geokoder *nowy);
+
+    /**
+     * @brief Pobiera stanowiska i bieżące pomiary wszystkich stacji w sieci
+     * @param zapytanNaSekunde Maksymalna liczba zapytań w tle na sekundę
+     *
+     * Dla każdej stacji z rejestru (pobieranego najpierw, jeśli jest pusty) wysyłane jest żądanie
+     * station/sensors/{id}, a dla każdego otrzymanego stanowiska data/getData/{id}. Żądania mają
+     * priorytet tła, więc kliknięcia użytkownika są obsługiwane przed nimi. Wyniki trafiają
+     * do pamięci podręcznej i dziennika pomiarów na bieżąco, bez zmiany widoków; postęp jest
+     * raportowany sygnałem postepPobieraniaSieci(). Adres API można zmienić (ustawAdresBazowy),
+     * np. na lokalny serwer z odpowiedziami testowymi.
+     */
+    void pobierzCalaSiec(int zapytanNaSekunde = 5);
+
+    /**
+     * @brief Sprawdza, czy trwa pobieranie całej sieci
+     * @return true jeśli nie wszystkie żądania zostały zakończone
+     */
+    bool pobieranieSieciTrwa() const;
+
 signals:
     /**
-     * @brief Sygnał emitowany po pobraniu danych stacji
-     * @param stacje Tablica JSON z danymi stacji
+     * @brief Sygnał emitowany po pobraniu lub przefiltrowaniu danych stacji
+     * @param wiersze Numery wierszy w rejestrze stacji (rejestrStacji())
      */
-    void daneStacjiPobrane(const QJsonArray& stacje);
+    void daneStacjiPobrane(const QVector<int>& wiersze);
 
     /**
      * @brief Sygnał emitowany po pobraniu danych stanowisk
@@ -128,10 +268,26 @@ signals:
 
     /**
      * @brief Sygnał emitowany po pobraniu danych pomiarowych
-     * @param pomiary Tablica JSON z pomiarami
-     * @param parametrKod Kod parametru (np. "PM10", "NO2")
+     * @param seria Szereg czasowy pomiarów wraz z kodem parametru (np. "PM10", "NO2")
+     */
+    void danePomiarowePobrane(const SeriaPomiarowa& seria);
+
+    /**
+     * @brief Sygnał emitowany, gdy ponowne pobranie dodało do historii stanowiska tylko nowe próbki
+     * @param stanowiskoId Identyfikator stanowiska
+     * @param nowe Próbki dopisane na końcu historii (pusta seria, jeśli nic się nie zmieniło)
+     *
+     * Poprzednie próbki historii są niezmienione, więc odbiorca dopisuje nowe próbki do swojej kopii.
+     * Historia nie jest udostępniana odbiorcy, dzięki czemu scalanie nie kopiuje jej kolumn.
+     * Gdy zmieniły się próbki wcześniejsze, emitowany jest danePomiarowePobrane().
+     */
+    void pomiaryDolaczone(int stanowiskoId, const SeriaPomiarowa& nowe);
+
+    /**
+     * @brief Sygnał emitowany po zmianie statystyk stanowiska (patrz statystykiStanowiska())
+     * @param stanowiskoId Identyfikator stanowiska
      */
-    void danePomiarowePobrane(const QJsonArray& pomiary, const QString& parametrKod);
+    void statystykiZaktualizowane(int stanowiskoId);
 
     /**
      * @brief Sygnał emitowany po pobraniu indeksu jakości powietrza
@@ -139,6 +295,16 @@ signals:
      */
     void indeksJakosciPobrany(const QJsonObject& indeks);
 
+    /**
+     * @brief Sygnał emitowany po każdym zakończonym żądaniu pobierania całej sieci
+     * @param gotowe Liczba zakończonych żądań
+     * @param wszystkie Liczba wszystkich dotąd zaplanowanych żądań (rośnie wraz z odkrywaniem stanowisk)
+     * @param bledy Liczba żądań zakończonych błędem
+     *
+     * Pobieranie jest zakończone, gdy gotowe == wszystkie.
+     */
+    void postepPobieraniaSieci(int gotowe, int wszystkie, int bledy);
+
     /**
      * @brief Sygnał emitowany w przypadku błędu
      * @param opisBledu Opis błędu
@@ -158,7 +324,7 @@ signals:
     void daneWczytane(bool sukces);
 
     /**
-     * @brief Sygnał emitowany przy automatycznym zapisie danych
+     * @brief Sygnał emitowany po automatycznym zapisie danych (w tle, z opóźnieniem)
      */
     void daneAutomatycznieZapisane();
 
@@ -171,47 +337,224 @@ private slots:
 
 private:
     QNetworkAccessManager *networkManager; ///< Menedżer połączeń sieciowych
-    QCache<QString, QJsonDocument> cache;  ///< Cache przechowujący odpowiedzi API
+    HarmonogramZadan *harmonogram;         ///< Kolejka zapytań (limit, priorytety, ponawianie)
+    PamiecWspolbiezna<QString, QJsonDocument> cache; ///< Zdekodowane odpowiedzi API (bezpieczne wątkowo, limit w bajtach)
+    QHash<QString, qint64> waznoscCache;   ///< Koniec ważności dokumentów w cache [ms od epoki] (tylko wątek GUI)
+    PamiecOdpowiedzi pamiecDyskowa;        ///< Dyskowa pamięć podręczna odpowiedzi HTTP
+    QScopedPointer<Geokoder> geokoder;     ///< Usługa geokodowania (jedna na cały czas życia obiektu)
+    PamiecGeokodowania pamiecGeokodowania; ///< Zapamiętane współrzędne wyszukiwanych adresów
+    SkorowidzMiejsc skorowidz;             ///< Offline'owy skorowidz kodów pocztowych, miejscowości i ulic
+    QString adresBazowy = "https://api.gios.gov.pl/pjp-api/v1/rest/"; ///< Adres bazowy API
+    QHash<QString, QVector<QNetworkRequest>> wToku; ///< Żądania w toku: adres URL -> oczekujące żądania
+    QHash<QString, QString> ostatnieZadania;        ///< Widok -> adres ostatniego żądania tego widoku
+
+    /**
+     * @struct PostepPobierania
+     * @brief Stan pobierania całej sieci
+     */
+    struct PostepPobierania {
+        bool aktywne = false;   ///< Czy pobieranie trwa
+        int wszystkie = 0;      ///< Liczba zaplanowanych żądań
+        int gotowe = 0;         ///< Liczba zakończonych żądań
+        int bledy = 0;          ///< Liczba żądań zakończonych błędem
+    };
+    PostepPobierania pobieranieSieci; ///< Postęp pobierania całej sieci
+    QHash<int, SeriaPomiarowa> historie; ///< Scalona historia ostatnio wyświetlanych stanowisk (najwyżej MAKS_HISTORII)
+    QVector<int> kolejnoscHistorii;      ///< Stanowiska z historie od najdawniej do ostatnio używanego
+    QHash<int, StatystykiStrumieniowe> statystyki; ///< Statystyki wszystkich pobranych stanowisk
+    QVector<QNetworkRequest> odbiorcyStacji; ///< Żądania listy stacji czekające na kolejne strony
+    int pozostaleStronyStacji = 0;           ///< Liczba stron listy stacji, które jeszcze nie dotarły
 
     /**
-     * @brief Przetwarza odpowiedź z danymi stacji
-     * @param odpowiedz Dane odpowiedzi w formacie JSON
+     * @brief Buduje pełny adres endpointu
+     * @param sciezka Ścieżka względem adresu bazowego (np. "station/sensors/14")
+     * @return Pełny adres URL
      */
-    void przetworzOdpowiedzStacje(const QByteArray& odpowiedz);
+    QUrl adresEndpointu(const QString& sciezka) const;
+
+    /**
+     * @brief Zwraca żądanie strony listy wszystkich stacji
+     * @param strona Numer strony (od 0)
+     * @return Żądanie endpointu station/findAll (jeden klucz dla wszystkich ścieżek wywołania)
+     */
+    QNetworkRequest zadanieListyStacji(int strona = 0) const;
+
+    /**
+     * @brief Pobiera listę stacji z pamięci podręcznej lub z sieci
+     * @param request Żądanie z zadanieListyStacji(), z atrybutami filtra (miasto lub promień)
+     */
+    void pobierzListeStacji(const QNetworkRequest& request);
+
+    /**
+     * @brief Filtruje stacje w promieniu od współrzędnych, pobierając najpierw listę stacji, jeśli trzeba
+     * @param wspolrzedne Środek obszaru
+     * @param promienKm Promień w kilometrach
+     */
+    void szukajStacjiWPromieniu(const QGeoCoordinate& wspolrzedne, double promienKm);
+
+    /**
+     * @brief Dołącza żądanie do odbiorców kolejnych stron listy stacji, jeśli strony są w drodze
+     * @param request Żądanie z zadanieListyStacji(), z atrybutami filtra
+     * @return true jeśli lista stacji nie jest jeszcze kompletna
+     */
+    bool czekajNaStronyStacji(const QNetworkRequest& request);
+
+    /**
+     * @brief Przekazuje bieżącą zawartość rejestru do odbiorców listy stacji
+     * @param kompletna Czy dotarły wszystkie strony (dopiero wtedy startuje pobieranie całej sieci)
+     */
+    void rozeslijStacje(bool kompletna);
+
+    /**
+     * @brief Odnotowuje stronę listy stacji, której nie udało się pobrać
+     * @param url Adres żądania
+     */
+    void pominStroneStacji(const QString& url);
+
+    /**
+     * @brief Wysyła żądanie GET, korzystając z dyskowej pamięci podręcznej
+     * @param request Żądanie sieciowe
+     *
+     * Aktualna kopia jest przetwarzana bez zapytania sieciowego (asynchronicznie, jak odpowiedź z sieci);
+     * jeśli jej dokument jest w pamięci podręcznej, nie jest ponownie parsowany.
+     * Dla nieaktualnej kopii do żądania dodawane są nagłówki warunkowe.
+     * Żądanie o adres, który jest już w toku, jest dołączane do oczekujących zamiast wysyłane ponownie.
+     */
+    void wyslij(QNetworkRequest request, HarmonogramZadan::Priorytet priorytet = HarmonogramZadan::Interaktywny);
+
+    /**
+     * @brief Wysyła żądanie dla widoku, anulując jego poprzednie żądanie
+     * @param widok Nazwa widoku (np. "stanowiska", "pomiary")
+     * @param request Żądanie sieciowe
+     *
+     * Każdy widok wyświetla tylko ostatni wybór użytkownika; odpowiedź na wcześniejsze
+     * żądanie jest przerywana lub odrzucana przed przetworzeniem.
+     */
+    void wyslijNajnowsze(const QString& widok, const QNetworkRequest& request);
+
+    /**
+     * @brief Anuluje żądanie w toku
+     * @param klucz Adres żądania
+     */
+    void anuluj(const QString& klucz);
+
+    /**
+     * @brief Wysyła żądanie pobierania całej sieci (priorytet tła, wynik poza widokami)
+     * @param request Żądanie sieciowe
+     */
+    void pobierzWTle(QNetworkRequest request);
+
+    /**
+     * @brief Kolejkuje pobranie stanowisk wszystkich stacji z rejestru
+     */
+    void pobierzStanowiskaWszystkichStacji();
+
+    /**
+     * @brief Zlicza zakończone żądanie pobierania całej sieci i emituje postęp
+     * @param oczekujace Żądania, których dotyczy odpowiedź
+     * @param sukces Czy odpowiedź została przetworzona
+     */
+    void oznaczPobranieWTle(const QVector<QNetworkRequest>& oczekujace, bool sukces);
+
+    /**
+     * @brief Dekoduje treść odpowiedzi, zapisuje ją w pamięci podręcznej i przekazuje do przetworzDokument()
+     * @param oczekujace Żądania o ten sam adres oczekujące na odpowiedź
+     * @param odpowiedz Treść odpowiedzi w formacie JSON
+     * @return true jeśli treść była poprawnym dokumentem JSON
+     */
+    bool przetworzOdpowiedz(const QVector<QNetworkRequest>& oczekujace, const QByteArray& odpowiedz);
+
+    /**
+     * @brief Kieruje zdekodowaną odpowiedź do właściwej metody przetwarzającej
+     * @param oczekujace Żądania o ten sam adres oczekujące na odpowiedź
+     * @param doc Dokument odpowiedzi (np. wprost z pamięci podręcznej, bez ponownego parsowania)
+     */
+    void przetworzDokument(const QVector<QNetworkRequest>& oczekujace, const QJsonDocument& doc);
 
     /**
      * @brief Przetwarza odpowiedź z danymi stanowisk
-     * @param odpowiedz Dane odpowiedzi w formacie JSON
+     * @param doc Dokument odpowiedzi
+     * @param dlaWidoku Czy wynik ma trafić do widoku (sygnał daneStanowiskPobrane)
+     * @return Znormalizowana lista stanowisk (pusta w razie błędu)
      */
-    void przetworzOdpowiedzStanowiska(const QByteArray& odpowiedz);
+    QJsonArray przetworzOdpowiedzStanowiska(const QJsonDocument& doc, bool dlaWidoku = true);
 
     /**
      * @brief Przetwarza odpowiedź z danymi pomiarowymi
-     * @param odpowiedz Dane odpowiedzi w formacie JSON
+     * @param doc Dokument odpowiedzi
+     * @param stanowiskoId Identyfikator stanowiska, którego dotyczy odpowiedź
+     * @param dlaWidoku Czy wynik ma trafić do widoku; w przeciwnym razie tylko do dziennika
      */
-    void przetworzOdpowiedzPomiary(const QByteArray& odpowiedz);
+    void przetworzOdpowiedzPomiary(const QJsonDocument& doc, int stanowiskoId, bool dlaWidoku = true);
+
+    /**
+     * @brief Zapisuje znormalizowane pomiary w dzienniku i przekazuje je do widoku
+     *
+     * Dla stanowiska pobranego już w tej sesji scala nowe próbki z zapamiętaną historią
+     * i emituje pomiaryDolaczone().
+     *
+     * @param stanowiskoId Identyfikator stanowiska
+     * @param pomiary Obiekt {"key", "values"}
+     * @param dlaWidoku Czy emitować danePomiarowePobrane i aktualizować bieżące dane
+     */
+    void opublikujPomiary(int stanowiskoId, const QJsonObject& pomiary, bool dlaWidoku);
+
+    /**
+     * @brief Dopisuje serię do dziennika pomiarów i zwraca pełną historię stanowiska
+     * @param stanowiskoId Identyfikator stanowiska
+     * @param seria Seria pobrana z API
+     * @return Historia stanowiska z dziennika (lub sama seria, gdy dziennik jest niedostępny)
+     */
+    SeriaPomiarowa dolaczDoDziennika(int stanowiskoId, const SeriaPomiarowa& seria);
+
+    /**
+     * @brief Oznacza historię stanowiska jako ostatnio używaną i usuwa najdawniej używane ponad limit
+     * @param stanowiskoId Identyfikator stanowiska
+     *
+     * Usunięta historia jest przy następnym pobraniu wczytywana ponownie z dziennika.
+     */
+    void uzyjHistorii(int stanowiskoId);
+
+    /**
+     * @brief Uzupełnia statystyki stanowiska o nowe próbki albo buduje je od nowa
+     * @param stanowiskoId Identyfikator stanowiska
+     * @param seria Seria stanowiska (uwzględniane są próbki nowsze od ostatniej znanej)
+     * @param odNowa Czy zbudować statystyki od początku (zmieniły się próbki, które już obejmują)
+     * @param zDziennika Czy przy budowaniu od nowa przejrzeć dziennik (seria to tylko okno z API)
+     *
+     * Statystyki budowane od nowa (także przy pierwszym użyciu stanowiska) obejmują archiwum historii
+     * sprzed pierwszej próbki dziennika lub serii, historię z dziennika i na końcu serię.
+     */
+    void aktualizujStatystyki(int stanowiskoId, const SeriaPomiarowa& seria, bool odNowa, bool zDziennika);
 
     /**
      * @brief Przetwarza odpowiedź z indeksem jakości powietrza
-     * @param odpowiedz Dane odpowiedzi w formacie JSON
+     * @param doc Dokument odpowiedzi
      */
-    void przetworzOdpowiedzIndeks(const QByteArray& odpowiedz);
+    void przetworzOdpowiedzIndeks(const QJsonDocument& doc);
 
     /**
-     * @brief Filtruje stacje po nazwie miasta
-     * @param stacje Tablica JSON ze stacjami
+     * @brief Filtruje stacje z rejestru po nazwie miasta
      * @param miasto Nazwa miasta do filtrowania
-     * @return Przefiltrowana tablica JSON
+     * @return Numery pasujących wierszy rejestru stacji
      */
-    QJsonArray filtrujStacjePoMiescie(const QJsonArray& stacje, const QString& miasto);
+    QVector<int> filtrujStacjePoMiescie(const QString& miasto) const;
 
     /**
-     * @brief Automatycznie zapisuje dane do domyślnego pliku
+     * @brief Zleca automatyczny zapis sekcji danych do domyślnego pliku
+     * @param sekcja Nazwa zmienionej sekcji aktualneDane
+     *
+     * Zapis wykonuje ZapisWTle w osobnym wątku, łącząc kolejne zmiany.
      */
-    void zapiszDaneAutomatycznie();
+    void zapiszDaneAutomatycznie(const QString& sekcja);
 
     QString sciezkaPliku = "dane_pomiarowe.json"; ///< Domyślna ścieżka pliku danych
     QJsonObject aktualneDane; ///< Bieżące dane w pamięci
+    QThread watekZapisu;      ///< Wątek zapisu danych w tle
+    ZapisWTle *zapisWTle;     ///< Obiekt zapisu (żyje w watekZapisu)
+    DziennikPomiarow dziennik{"dziennik_pomiarow.bin"}; ///< Historia pobranych serii wszystkich stanowisk
+    QSharedPointer<const MagazynKolumnowy> magazyn; ///< Zmapowane archiwum historii (plik ".kol")
+    QString sciezkaArchiwum = "archiwum_pomiarow.kol"; ///< Domyślna ścieżka archiwum otwieranego przy starcie
 
     /**
      * @brief Przetwarza odpowiedź geokodowania
@@ -228,9 +571,12 @@ private:
      * @param lon2 Długość geograficzna punktu 2
      * @return Odległość w kilometrach
      *
-     * Wykorzystuje wzór haversine do obliczeń.
+     * Wykorzystuje wzór haversine (Odleglosci::haversine); dla wielu punktów naraz
+     * należy użyć Odleglosci::odPunktu lub Odleglosci::macierz.
      */
     double obliczOdleglosc(double lat1, double lon1, double lat2, double lon2);
+
+    RejestrStacji rejestr; ///< Stacje zdekodowane z ostatniej listy (wraz z indeksem przestrzennym)
 };
 
 #endif // API_POBIERANIE_H
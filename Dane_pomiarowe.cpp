@@ -4,6 +4,7 @@
  */
 
 #include "dane_pomiarowe.h"
+#include "Parser_czasu.h"
 
 /**
  * @brief Domyślny konstruktor klasy DanePomiarowe.
@@ -27,13 +28,16 @@ DanePomiarowe::DanePomiarowe(const QDateTime& data, float wartosc, const QString
 /**
  * @brief Tworzy obiekt DanePomiarowe na podstawie danych z obiektu JSON.
  *
- * Oczekiwane klucze JSON: "date" (w formacie ISO), "value" (liczba), "key" (nazwa parametru).
+ * Oczekiwane klucze JSON: "date" (ISO lub "yyyy-MM-dd HH:mm:ss"), "value" (liczba), "key" (nazwa parametru).
  *
  * @param json Obiekt JSON zawierający dane.
  * @return Obiekt DanePomiarowe utworzony na podstawie JSON.
  */
 DanePomiarowe DanePomiarowe::fromJson(const QJsonObject& json) {
-    QDateTime data = QDateTime::fromString(json["date"].toString(), Qt::ISODate);
+    QDateTime data;
+    qint64 czasMs;
+    if (ParserCzasu::parsuj(json["date"].toString(), &czasMs))
+        data = QDateTime::fromMSecsSinceEpoch(czasMs);
     float wartosc = json["value"].isNull() ? 0.0f : static_cast<float>(json["value"].toDouble());
     QString parametr = json["key"].toString();
 
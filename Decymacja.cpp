@@ -0,0 +1,133 @@
+/**
+ * @file Decymacja.cpp
+ * @brief Plik źródłowy klasy Decymacja
+ */
+
+#include "Decymacja.h"
+
+#include <QtMath>
+
+namespace {
+
+/**
+ * @brief Zwraca wszystkie próbki widoku z wartością.
+ * @param widok Widok serii (WidokSerii lub WidokSklejony).
+ * @return Punkty wykresu.
+ */
+template <typename Widok>
+QVector<QPointF> wszystkiePunkty(const Widok& widok) {
+    QVector<QPointF> wynik;
+    wynik.reserve(widok.rozmiar());
+    for (int i = 0; i < widok.rozmiar(); ++i) {
+        if (!widok.jestBrak(i))
+            wynik.append(QPointF(widok.czas(i), widok.wartosc(i)));
+    }
+    return wynik;
+}
+
+/**
+ * @brief Redukuje widok metodą Largest-Triangle-Three-Buckets.
+ *
+ * Pierwsza i ostatnia próbka z wartością są zawsze zachowane. Pozostałe próbki dzielone są na
+ * (liczbaPunktow - 2) kubełki; kubełki bez żadnej wartości nie dają punktu.
+ *
+ * @param widok Widok na posortowane próbki (WidokSerii lub WidokSklejony).
+ * @param liczbaPunktow Docelowa liczba punktów.
+ * @return Zdecymowane punkty.
+ */
+template <typename Widok>
+QVector<QPointF> lttbWidoku(const Widok& widok, int liczbaPunktow) {
+    const int n = widok.rozmiar();
+    if (liczbaPunktow < 3 || n <= liczbaPunktow)
+        return wszystkiePunkty(widok);
+
+    int pierwszy = 0;
+    while (pierwszy < n && widok.jestBrak(pierwszy)) ++pierwszy;
+    int ostatni = n - 1;
+    while (ostatni > pierwszy && widok.jestBrak(ostatni)) --ostatni;
+    if (ostatni <= pierwszy)
+        return wszystkiePunkty(widok);
+
+    // Współrzędne x liczone względem pierwszej próbki, żeby iloczyny w polu trójkąta nie traciły precyzji.
+    const qint64 czas0 = widok.czas(pierwszy);
+
+    QVector<QPointF> wynik;
+    wynik.reserve(liczbaPunktow);
+    wynik.append(QPointF(widok.czas(pierwszy), widok.wartosc(pierwszy)));
+
+    const int srodek = ostatni - pierwszy - 1;
+    const double krok = double(srodek) / (liczbaPunktow - 2);
+
+    double ax = 0.0;
+    double ay = widok.wartosc(pierwszy);
+
+    for (int k = 0; k < liczbaPunktow - 2; ++k) {
+        const int odK = pierwszy + 1 + int(qFloor(k * krok));
+        const int doK = qMin(ostatni, pierwszy + 1 + int(qFloor((k + 1) * krok)));
+
+        // Średnia następnego kubełka (dla ostatniego kubełka: ostatnia próbka).
+        const int odN = doK;
+        const int doN = qMin(ostatni, pierwszy + 1 + int(qFloor((k + 2) * krok)));
+        double sx = 0.0, sy = 0.0;
+        int ile = 0;
+        for (int i = odN; i < doN; ++i) {
+            if (widok.jestBrak(i)) continue;
+            sx += double(widok.czas(i) - czas0);
+            sy += widok.wartosc(i);
+            ++ile;
+        }
+        if (ile == 0) {
+            sx = double(widok.czas(ostatni) - czas0);
+            sy = widok.wartosc(ostatni);
+            ile = 1;
+        }
+        const double cx = sx / ile;
+        const double cy = sy / ile;
+
+        int wybrany = -1;
+        double maxPole = -1.0;
+        for (int i = odK; i < doK; ++i) {
+            if (widok.jestBrak(i)) continue;
+            const double bx = double(widok.czas(i) - czas0);
+            const double by = widok.wartosc(i);
+            const double pole = qAbs((ax - cx) * (by - ay) - (ax - bx) * (cy - ay));
+            if (pole > maxPole) {
+                maxPole = pole;
+                wybrany = i;
+            }
+        }
+
+        if (wybrany < 0) continue;
+
+        wynik.append(QPointF(widok.czas(wybrany), widok.wartosc(wybrany)));
+        ax = double(widok.czas(wybrany) - czas0);
+        ay = widok.wartosc(wybrany);
+    }
+
+    wynik.append(QPointF(widok.czas(ostatni), widok.wartosc(ostatni)));
+    return wynik;
+}
+
+} // namespace
+
+/**
+ * @brief Redukuje widok serii metodą LTTB.
+ *
+ * @param widok Widok na posortowane próbki.
+ * @param liczbaPunktow Docelowa liczba punktów.
+ * @return Zdecymowane punkty.
+ */
+QVector<QPointF> Decymacja::lttb(const WidokSerii& widok, int liczbaPunktow) {
+    return lttbWidoku(widok, liczbaPunktow);
+}
+
+/**
+ * @brief Redukuje widok złożony z archiwum i serii metodą LTTB.
+ *
+ * @param widok Widok na dwa kolejne odcinki próbek.
+ * @param liczbaPunktow Docelowa liczba punktów.
+ * @return Zdecymowane punkty.
+ */
+QVector<QPointF> Decymacja::lttb(const WidokSklejony& widok, int liczbaPunktow) {
+    return lttbWidoku(widok, liczbaPunktow);
+}
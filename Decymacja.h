@@ -0,0 +1,48 @@
+/**
+ * @file Decymacja.h
+ * @brief Plik nagłówkowy klasy Decymacja
+ *
+ * Klasa Decymacja redukuje liczbę punktów szeregu czasowego przed przekazaniem go do wykresu,
+ * zachowując jego kształt wizualny (algorytm Largest-Triangle-Three-Buckets).
+*/
+
+#ifndef DECYMACJA_H
+#define DECYMACJA_H
+
+#include <QVector>
+#include <QPointF>
+
+#include "Widok_serii.h"
+#include "Widok_sklejony.h"
+
+/**
+ * @class Decymacja
+ * @brief Decymacja szeregów czasowych dla wykresów.
+ *
+ * Algorytm LTTB dzieli próbki na kubełki i z każdego wybiera punkt tworzący największy trójkąt
+ * z punktem wybranym w poprzednim kubełku oraz średnią kolejnego kubełka.
+ * Próbki bez wartości są pomijane, a dane wejściowe nie są kopiowane.
+ */
+class Decymacja
+{
+public:
+    /**
+     * @brief Redukuje widok serii do zadanej liczby punktów metodą LTTB.
+     * @param widok Widok na posortowane próbki.
+     * @param liczbaPunktow Docelowa liczba punktów (np. szerokość wykresu w pikselach).
+     * @return Punkty (x = ms od epoki, y = wartość) gotowe dla QLineSeries.
+     *
+     * Jeśli widok zawiera nie więcej próbek niż liczbaPunktow, zwracane są wszystkie próbki z wartością.
+     */
+    static QVector<QPointF> lttb(const WidokSerii& widok, int liczbaPunktow);
+
+    /**
+     * @brief Redukuje widok złożony z archiwum i serii w pamięci do zadanej liczby punktów metodą LTTB.
+     * @param widok Widok na dwa kolejne odcinki próbek.
+     * @param liczbaPunktow Docelowa liczba punktów.
+     * @return Punkty (x = ms od epoki, y = wartość); kubełki mogą obejmować granicę odcinków.
+     */
+    static QVector<QPointF> lttb(const WidokSklejony& widok, int liczbaPunktow);
+};
+
+#endif // DECYMACJA_H
@@ -0,0 +1,669 @@
+/**
+ * @file Dziennik_pomiarow.cpp
+ * @brief Plik źródłowy klasy DziennikPomiarow
+ */
+
+#include "Dziennik_pomiarow.h"
+#include "Kompresja_gorilla.h"
+
+#include <QDebug>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace {
+const char ZNACZNIK_DANYCH[4] = {'G', 'D', 'Z', '1'};
+const char ZNACZNIK_INDEKSU[4] = {'G', 'D', 'Z', 'I'};
+const quint32 WERSJA = 1;
+const quint32 ZNACZNIK_REKORDU = 0x52454B31;           // 'REK1': próbki zapisane wprost
+const quint32 ZNACZNIK_REKORDU_GORILLA_V1 = 0x52454B32;   // 'REK2': strumień z własną liczbą próbek i czasem
+const quint32 ZNACZNIK_REKORDU_GORILLA = 0x52454B33;   // 'REK3': czas pierwszej próbki względem poprzedniego rekordu
+
+const qint64 ROZMIAR_NAGLOWKA = 8;            // znacznik + wersja
+const qint64 ROZMIAR_NAGLOWKA_INDEKSU = 24;   // znacznik + wersja + pokryta długość + liczba + rezerwa
+const qint64 ROZMIAR_WPISU = 32;
+const int ROZMIAR_PROBKI = 13;                // czas i64 + wartość f32 + brak u8
+const int ROZMIAR_GLOWY_REKORDU = 14;         // znacznik + id + liczba + długość parametru
+const int ROZMIAR_GLOWY_STRUMIENIA_V1 = 12;   // liczba u32 + czas i64 (big-endian) w rekordach 'REK2'
+
+/**
+ * @brief Dopisuje liczbę w porządku little-endian.
+ */
+template <typename T>
+void dopiszLE(QByteArray& bufor, T wartosc) {
+    uchar bajty[sizeof(T)];
+    qToLittleEndian<T>(wartosc, bajty);
+    bufor.append(reinterpret_cast<const char*>(bajty), sizeof(T));
+}
+
+/**
+ * @brief Odczytuje liczbę zapisaną w porządku little-endian.
+ */
+template <typename T>
+T czytajLE(const uchar* p) {
+    return qFromLittleEndian<T>(p);
+}
+
+/**
+ * @brief Dopisuje liczbę ze znakiem jako varint (kodowanie zigzag, 7 bitów na bajt).
+ */
+void dopiszVarint(QByteArray& bufor, qint64 wartosc) {
+    quint64 x = (quint64(wartosc) << 1) ^ quint64(wartosc >> 63);
+    while (x >= 0x80) {
+        bufor.append(char(uchar(x) | 0x80));
+        x >>= 7;
+    }
+    bufor.append(char(x));
+}
+
+/**
+ * @brief Odczytuje liczbę zapisaną przez dopiszVarint().
+ * @return Liczba odczytanych bajtów (0, jeśli zapis jest niepełny lub za długi).
+ */
+int czytajVarint(const uchar* p, int rozmiar, qint64* wartosc) {
+    quint64 x = 0;
+    for (int i = 0; i < rozmiar && i < 10; ++i) {
+        x |= quint64(p[i] & 0x7F) << (7 * i);
+        if (!(p[i] & 0x80)) {
+            *wartosc = qint64(x >> 1) ^ -qint64(x & 1);
+            return i + 1;
+        }
+    }
+    return 0;
+}
+}
+
+/**
+ * @brief Konstruktor klasy DziennikPomiarow.
+ * @param sciezka Ścieżka pliku danych.
+ */
+DziennikPomiarow::DziennikPomiarow(const QString& sciezka) :
+    m_sciezkaIndeksu(QFileInfo(sciezka).path() + "/" + QFileInfo(sciezka).completeBaseName() + ".idx"),
+    m_dane(sciezka),
+    m_indeks(m_sciezkaIndeksu)
+{}
+
+/**
+ * @brief Destruktor klasy DziennikPomiarow.
+ */
+DziennikPomiarow::~DziennikPomiarow() {
+    zamknij();
+}
+
+/**
+ * @brief Otwiera dziennik.
+ *
+ * Sprawdzany jest tylko nagłówek pliku danych i indeksu; wpisy indeksu są mapowane, a nie wczytywane.
+ *
+ * @return true jeśli plik danych został otwarty.
+ */
+bool DziennikPomiarow::otworz() {
+    if (jestOtwarty())
+        return true;
+
+    if (!m_dane.open(QIODevice::ReadWrite)) {
+        qWarning() << "Nie można otworzyć dziennika pomiarów:" << m_dane.fileName();
+        return false;
+    }
+
+    if (m_dane.size() < ROZMIAR_NAGLOWKA) {
+        QByteArray naglowek(ZNACZNIK_DANYCH, 4);
+        dopiszLE<quint32>(naglowek, WERSJA);
+        m_dane.resize(0);
+        m_dane.write(naglowek);
+        m_dane.flush();
+    } else if (m_dane.read(4) != QByteArray(ZNACZNIK_DANYCH, 4)) {
+        qWarning() << "Nieprawidłowy format dziennika pomiarów:" << m_dane.fileName();
+        m_dane.close();
+        return false;
+    }
+
+    qint64 pokryte = ROZMIAR_NAGLOWKA;
+
+    if (m_indeks.open(QIODevice::ReadOnly) && m_indeks.size() >= ROZMIAR_NAGLOWKA_INDEKSU) {
+        uchar* p = m_indeks.map(0, m_indeks.size());
+        if (p && std::memcmp(p, ZNACZNIK_INDEKSU, 4) == 0 && czytajLE<quint32>(p + 4) == WERSJA) {
+            const qint64 pokryteIndeksu = czytajLE<qint64>(p + 8);
+            const quint32 liczba = czytajLE<quint32>(p + 16);
+
+            if (ROZMIAR_NAGLOWKA_INDEKSU + liczba * ROZMIAR_WPISU <= m_indeks.size() &&
+                pokryteIndeksu >= ROZMIAR_NAGLOWKA && pokryteIndeksu <= m_dane.size()) {
+                m_mapa = p + ROZMIAR_NAGLOWKA_INDEKSU;
+                m_liczbaMapowanych = static_cast<int>(liczba);
+                pokryte = pokryteIndeksu;
+            }
+        }
+        if (!m_mapa) {
+            if (p) m_indeks.unmap(p);
+            m_indeks.close();
+        }
+    }
+
+    indeksujKoncowke(pokryte);
+    return true;
+}
+
+/**
+ * @brief Zapisuje indeks i zamyka dziennik.
+ */
+void DziennikPomiarow::zamknij() {
+    if (!jestOtwarty())
+        return;
+
+    if (!m_nowe.isEmpty() && !zapiszIndeks())
+        qWarning() << "Nie można zapisać indeksu dziennika:" << m_sciezkaIndeksu;
+
+    if (m_mapa) {
+        m_indeks.unmap(const_cast<uchar*>(m_mapa) - ROZMIAR_NAGLOWKA_INDEKSU);
+        m_mapa = nullptr;
+    }
+    m_liczbaMapowanych = 0;
+    m_nowe.clear();
+    m_indeks.close();
+    m_dane.close();
+}
+
+/**
+ * @brief Sprawdza, czy dziennik jest otwarty.
+ * @return true jeśli plik danych jest otwarty.
+ */
+bool DziennikPomiarow::jestOtwarty() const {
+    return m_dane.isOpen();
+}
+
+/**
+ * @brief Dopisuje nowe lub zmienione próbki serii.
+ *
+ * Seria jest porównywana z historią z tego samego przedziału czasu; zapisywane są tylko próbki,
+ * których w dzienniku nie ma albo których wartość się zmieniła.
+ *
+ * @param stanowiskoId Identyfikator stanowiska.
+ * @param seria Seria pobrana z API.
+ * @param pierwszyCzas Czas najwcześniejszej dopisanej próbki (opcjonalnie).
+ * @return Liczba dopisanych próbek.
+ */
+int DziennikPomiarow::dopisz(int stanowiskoId, const SeriaPomiarowa& seria, qint64* pierwszyCzas) {
+    if (!jestOtwarty() || seria.jestPusta())
+        return 0;
+
+    SeriaPomiarowa nowa = seria;
+    if (!nowa.jestPosortowana())
+        nowa.uporzadkuj();
+
+    const qint64 ostatni = ostatniCzas(stanowiskoId);
+    const SeriaPomiarowa historia = (ostatni < nowa.czas(0))
+                                        ? SeriaPomiarowa()
+                                        : wczytaj(stanowiskoId, nowa.czas(0), nowa.czas(nowa.rozmiar() - 1));
+
+    QVector<qint64> czasy;
+    QVector<float> wartosci;
+    QVector<quint64> braki((nowa.rozmiar() + 63) / 64, 0);
+    czasy.reserve(nowa.rozmiar());
+    wartosci.reserve(nowa.rozmiar());
+    int j = 0;
+
+    for (int i = 0; i < nowa.rozmiar(); ++i) {
+        const qint64 czas = nowa.czas(i);
+        while (j < historia.rozmiar() && historia.czas(j) < czas)
+            ++j;
+
+        if (j < historia.rozmiar() && historia.czas(j) == czas &&
+            historia.jestBrak(j) == nowa.jestBrak(i) &&
+            (nowa.jestBrak(i) || historia.wartosc(j) == nowa.wartosc(i)))
+            continue;
+
+        if (nowa.jestBrak(i))
+            braki[czasy.size() >> 6] |= quint64(1) << (czasy.size() & 63);
+        czasy.append(czas);
+        wartosci.append(nowa.jestBrak(i) ? 0.0f : nowa.wartosc(i));
+    }
+
+    const quint32 liczba = static_cast<quint32>(czasy.size());
+    if (liczba == 0)
+        return 0;
+
+    const qint64 odMs = czasy.first();
+    const qint64 doMs = czasy.last();
+
+    // Poprzednie rekordy stanowiska kończą się na 'ostatni': pierwsza próbka jest zapisana względem niego,
+    // a odstęp od niego jest punktem odniesienia dla kolejnych odstępów (zwykle 0 bitów na próbkę).
+    const qint64 krok = (ostatni >= 0 && odMs > ostatni) ? odMs - ostatni : 0;
+    const QByteArray probki = KompresjaGorilla::koduj(
+        WidokSerii(czasy.constData(), wartosci.constData(), braki.constData(), 0, czasy.size()), krok);
+    const QByteArray parametr = nowa.parametr().toUtf8();
+
+    QByteArray rekord;
+    rekord.reserve(4 + ROZMIAR_GLOWY_REKORDU + parametr.size() + 10 + probki.size());
+    dopiszLE<quint32>(rekord, 0);
+    dopiszLE<quint32>(rekord, ZNACZNIK_REKORDU_GORILLA);
+    dopiszLE<qint32>(rekord, stanowiskoId);
+    dopiszLE<quint32>(rekord, liczba);
+    dopiszLE<quint16>(rekord, static_cast<quint16>(parametr.size()));
+    rekord.append(parametr);
+    dopiszVarint(rekord, odMs - qMax<qint64>(ostatni, 0));
+    rekord.append(probki);
+    qToLittleEndian<quint32>(quint32(rekord.size() - 4), rekord.data());
+
+    const qint64 przesuniecie = m_dane.size();
+    if (!m_dane.seek(przesuniecie) || m_dane.write(rekord) != rekord.size()) {
+        qWarning() << "Nie można dopisać rekordu do dziennika:" << m_dane.fileName();
+        m_dane.resize(przesuniecie);
+        return 0;
+    }
+    m_dane.flush();
+
+    m_nowe.append(WpisIndeksu{stanowiskoId, static_cast<quint32>(rekord.size()), odMs, doMs, przesuniecie});
+    if (pierwszyCzas)
+        *pierwszyCzas = odMs;
+    return static_cast<int>(liczba);
+}
+
+/**
+ * @brief Wczytuje całą historię stanowiska.
+ * @param stanowiskoId Identyfikator stanowiska.
+ * @return Posortowana seria.
+ */
+SeriaPomiarowa DziennikPomiarow::wczytaj(int stanowiskoId) const {
+    return wczytaj(stanowiskoId, std::numeric_limits<qint64>::min(), std::numeric_limits<qint64>::max());
+}
+
+/**
+ * @brief Wczytuje historię stanowiska z przedziału czasu.
+ *
+ * Odczytywane są tylko rekordy, których zakres czasu nachodzi na przedział.
+ *
+ * @param stanowiskoId Identyfikator stanowiska.
+ * @param odMs Początek przedziału.
+ * @param doMs Koniec przedziału.
+ * @return Posortowana seria.
+ */
+SeriaPomiarowa DziennikPomiarow::wczytaj(int stanowiskoId, qint64 odMs, qint64 doMs) const {
+    SeriaPomiarowa seria;
+    const QString parametr = przegladaj(stanowiskoId, odMs, doMs, [&seria](const WidokSerii& blok) {
+        for (int i = 0; i < blok.rozmiar(); ++i) {
+            if (blok.jestBrak(i))
+                seria.dodajBrak(blok.czas(i));
+            else
+                seria.dodaj(blok.czas(i), blok.wartosc(i));
+        }
+    });
+    seria.setParametr(parametr);
+    return seria;
+}
+
+/**
+ * @brief Przekazuje historię stanowiska z przedziału czasu kolejnymi blokami.
+ *
+ * Czas pierwszej próbki rekordu jest zapisany względem ostatniej próbki wcześniejszych rekordów,
+ * więc przeglądane są wpisy indeksu wszystkich rekordów stanowiska, ale odczytywane i dekodowane
+ * tylko te, które nachodzą na przedział. Jeśli rekordy z przedziału nakładają się czasem
+ * (poprawki wcześniejszych próbek), próbki są scalane i przekazywane jednym blokiem.
+ *
+ * @param stanowiskoId Identyfikator stanowiska.
+ * @param odMs Początek przedziału.
+ * @param doMs Koniec przedziału.
+ * @param odbiorca Funkcja wywoływana dla kolejnych bloków.
+ * @return Kod parametru stanowiska.
+ */
+QString DziennikPomiarow::przegladaj(int stanowiskoId, qint64 odMs, qint64 doMs,
+                                     const std::function<void(const WidokSerii&)>& odbiorca) const {
+    QString parametr;
+    if (!jestOtwarty())
+        return parametr;
+
+    const QVector<WpisIndeksu> wpisy = wpisyStanowiska(stanowiskoId, std::numeric_limits<qint64>::min(),
+                                                       std::numeric_limits<qint64>::max());
+
+    bool rozlaczne = true;
+    qint64 koniecPoprzedniego = std::numeric_limits<qint64>::min();
+    for (const WpisIndeksu& wpis : wpisy) {
+        if (wpis.doMs < odMs || wpis.odMs > doMs)
+            continue;
+        if (wpis.odMs <= koniecPoprzedniego) {
+            rozlaczne = false;
+            break;
+        }
+        koniecPoprzedniego = wpis.doMs;
+    }
+
+    QVector<Probka> wszystkie;
+    qint64 kotwica = -1;
+
+    for (const WpisIndeksu& wpis : wpisy) {
+        const qint64 kotwicaRekordu = kotwica;
+        kotwica = qMax(kotwica, wpis.doMs);
+        if (wpis.doMs < odMs || wpis.odMs > doMs)
+            continue;
+
+        Rekord rekord;
+        if (!czytajRekord(wpis.przesuniecie, &rekord) || rekord.stanowiskoId != stanowiskoId)
+            continue;
+        parametr = rekord.parametr;
+
+        if (rozlaczne) {
+            dekodujRekord(rekord, kotwicaRekordu, [&](const WidokSerii& blok) {
+                const WidokSerii wycinek = blok.zakres(odMs, doMs);
+                if (!wycinek.jestPusty())
+                    odbiorca(wycinek);
+            });
+            continue;
+        }
+
+        dekodujRekord(rekord, kotwicaRekordu, [&](const WidokSerii& blok) {
+            for (int i = 0; i < blok.rozmiar(); ++i) {
+                if (blok.czas(i) >= odMs && blok.czas(i) <= doMs)
+                    wszystkie.append(Probka{blok.czas(i), blok.wartosc(i), blok.jestBrak(i)});
+            }
+        });
+    }
+
+    if (rozlaczne || wszystkie.isEmpty())
+        return parametr;
+
+    // Rekordy są w kolejności zapisu, więc stabilne sortowanie zostawia najnowszą wersję próbki jako ostatnią.
+    std::stable_sort(wszystkie.begin(), wszystkie.end(),
+                     [](const Probka& a, const Probka& b) { return a.czas < b.czas; });
+
+    QVector<qint64> czasy;
+    QVector<float> wartosci;
+    QVector<quint64> braki((wszystkie.size() + 63) / 64, 0);
+    czasy.reserve(wszystkie.size());
+    wartosci.reserve(wszystkie.size());
+    for (int i = 0; i < wszystkie.size(); ++i) {
+        if (i + 1 < wszystkie.size() && wszystkie[i + 1].czas == wszystkie[i].czas)
+            continue;
+        if (wszystkie[i].brak)
+            braki[czasy.size() >> 6] |= quint64(1) << (czasy.size() & 63);
+        czasy.append(wszystkie[i].czas);
+        wartosci.append(wszystkie[i].wartosc);
+    }
+    odbiorca(WidokSerii(czasy.constData(), wartosci.constData(), braki.constData(), 0, czasy.size()));
+    return parametr;
+}
+
+/**
+ * @brief Zwraca czas najnowszej zapisanej próbki stanowiska.
+ * @param stanowiskoId Identyfikator stanowiska.
+ * @return Czas w ms lub -1.
+ */
+qint64 DziennikPomiarow::ostatniCzas(int stanowiskoId) const {
+    qint64 wynik = -1;
+    for (const WpisIndeksu& wpis : wpisyStanowiska(stanowiskoId, std::numeric_limits<qint64>::min(),
+                                                    std::numeric_limits<qint64>::max()))
+        wynik = qMax(wynik, wpis.doMs);
+    return wynik;
+}
+
+/**
+ * @brief Zwraca identyfikatory stanowisk obecnych w dzienniku.
+ * @return Identyfikatory stanowisk.
+ */
+QVector<int> DziennikPomiarow::stanowiska() const {
+    QVector<int> wynik;
+    for (int i = 0; i < m_liczbaMapowanych; ++i) {
+        const qint32 id = czytajLE<qint32>(m_mapa + i * ROZMIAR_WPISU);
+        if (wynik.isEmpty() || wynik.last() != id)
+            wynik.append(id);
+    }
+    for (const WpisIndeksu& wpis : m_nowe)
+        wynik.append(wpis.stanowiskoId);
+
+    std::sort(wynik.begin(), wynik.end());
+    wynik.erase(std::unique(wynik.begin(), wynik.end()), wynik.end());
+    return wynik;
+}
+
+/**
+ * @brief Dekoduje wpis zmapowanego indeksu.
+ * @param i Numer wpisu.
+ * @return Wpis indeksu.
+ */
+DziennikPomiarow::WpisIndeksu DziennikPomiarow::wpisMapowany(int i) const {
+    const uchar* p = m_mapa + i * ROZMIAR_WPISU;
+    return WpisIndeksu{czytajLE<qint32>(p), czytajLE<quint32>(p + 4),
+                       czytajLE<qint64>(p + 8), czytajLE<qint64>(p + 16), czytajLE<qint64>(p + 24)};
+}
+
+/**
+ * @brief Zbiera wpisy indeksu stanowiska nachodzące na przedział.
+ *
+ * W zmapowanym indeksie wpisy stanowiska są wyszukiwane binarnie (indeks jest posortowany po stanowisku).
+ *
+ * @param stanowiskoId Identyfikator stanowiska.
+ * @param odMs Początek przedziału.
+ * @param doMs Koniec przedziału.
+ * @return Wpisy w kolejności położenia w pliku danych.
+ */
+QVector<DziennikPomiarow::WpisIndeksu> DziennikPomiarow::wpisyStanowiska(int stanowiskoId, qint64 odMs, qint64 doMs) const {
+    QVector<WpisIndeksu> wynik;
+
+    int lewy = 0;
+    int prawy = m_liczbaMapowanych;
+    while (lewy < prawy) {
+        const int srodek = lewy + (prawy - lewy) / 2;
+        if (czytajLE<qint32>(m_mapa + srodek * ROZMIAR_WPISU) < stanowiskoId)
+            lewy = srodek + 1;
+        else
+            prawy = srodek;
+    }
+
+    for (int i = lewy; i < m_liczbaMapowanych; ++i) {
+        const WpisIndeksu wpis = wpisMapowany(i);
+        if (wpis.stanowiskoId != stanowiskoId)
+            break;
+        if (wpis.doMs >= odMs && wpis.odMs <= doMs)
+            wynik.append(wpis);
+    }
+
+    for (const WpisIndeksu& wpis : m_nowe) {
+        if (wpis.stanowiskoId == stanowiskoId && wpis.doMs >= odMs && wpis.odMs <= doMs)
+            wynik.append(wpis);
+    }
+
+    std::sort(wynik.begin(), wynik.end(),
+              [](const WpisIndeksu& a, const WpisIndeksu& b) { return a.przesuniecie < b.przesuniecie; });
+    return wynik;
+}
+
+/**
+ * @brief Odczytuje rekord z pliku danych.
+ * @param przesuniecie Położenie rekordu.
+ * @param rekord Rekord (wynik).
+ * @return false jeśli rekord jest niepełny lub uszkodzony.
+ */
+bool DziennikPomiarow::czytajRekord(qint64 przesuniecie, Rekord* rekord) const {
+    if (!m_dane.seek(przesuniecie))
+        return false;
+
+    const QByteArray prefiks = m_dane.read(4);
+    if (prefiks.size() != 4)
+        return false;
+
+    const quint32 dlugoscTresci = czytajLE<quint32>(reinterpret_cast<const uchar*>(prefiks.constData()));
+    if (dlugoscTresci < quint32(ROZMIAR_GLOWY_REKORDU) || przesuniecie + 4 + dlugoscTresci > m_dane.size())
+        return false;
+
+    rekord->tresc = m_dane.read(dlugoscTresci);
+    if (rekord->tresc.size() != int(dlugoscTresci))
+        return false;
+
+    const uchar* p = reinterpret_cast<const uchar*>(rekord->tresc.constData());
+    rekord->znacznik = czytajLE<quint32>(p);
+    if (rekord->znacznik != ZNACZNIK_REKORDU && rekord->znacznik != ZNACZNIK_REKORDU_GORILLA_V1 &&
+        rekord->znacznik != ZNACZNIK_REKORDU_GORILLA)
+        return false;
+
+    rekord->liczba = czytajLE<quint32>(p + 8);
+    const quint16 dlugoscParametru = czytajLE<quint16>(p + 12);
+    if (ROZMIAR_GLOWY_REKORDU + dlugoscParametru > dlugoscTresci)
+        return false;
+
+    rekord->stanowiskoId = czytajLE<qint32>(p + 4);
+    rekord->parametr = QString::fromUtf8(rekord->tresc.constData() + ROZMIAR_GLOWY_REKORDU, dlugoscParametru);
+    rekord->dlugosc = 4 + dlugoscTresci;
+    rekord->poczatekProbek = ROZMIAR_GLOWY_REKORDU + dlugoscParametru;
+
+    if (rekord->znacznik == ZNACZNIK_REKORDU)
+        return rekord->poczatekProbek + quint64(rekord->liczba) * ROZMIAR_PROBKI == dlugoscTresci;
+    return true;
+}
+
+/**
+ * @brief Dekoduje próbki rekordu blokami.
+ *
+ * Rekordy zapisane wprost są przekazywane jednym blokiem, a skompresowane - blokami dekodera.
+ *
+ * @param rekord Rekord odczytany z pliku.
+ * @param kotwica Czas ostatniej próbki stanowiska z wcześniejszych rekordów (-1, jeśli ich nie ma).
+ * @param odbiorca Funkcja wywoływana dla kolejnych bloków.
+ * @return false jeśli próbki są uszkodzone.
+ */
+bool DziennikPomiarow::dekodujRekord(const Rekord& rekord, qint64 kotwica,
+                                     const std::function<void(const WidokSerii&)>& odbiorca) const {
+    const uchar* p = reinterpret_cast<const uchar*>(rekord.tresc.constData()) + rekord.poczatekProbek;
+    int rozmiar = rekord.tresc.size() - rekord.poczatekProbek;
+
+    if (rekord.znacznik == ZNACZNIK_REKORDU) {
+        const int n = static_cast<int>(rekord.liczba);
+        QVector<qint64> czasy(n);
+        QVector<float> wartosci(n);
+        QVector<quint64> braki((n + 63) / 64, 0);
+        for (int i = 0; i < n; ++i, p += ROZMIAR_PROBKI) {
+            const quint32 bityWartosci = czytajLE<quint32>(p + 8);
+            czasy[i] = czytajLE<qint64>(p);
+            std::memcpy(&wartosci[i], &bityWartosci, sizeof(float));
+            if (p[12] != 0)
+                braki[i >> 6] |= quint64(1) << (i & 63);
+        }
+        if (n > 0)
+            odbiorca(WidokSerii(czasy.constData(), wartosci.constData(), braki.constData(), 0, n));
+        return true;
+    }
+
+    qint64 pierwszyCzas = 0;
+    qint64 krok = 0;
+
+    if (rekord.znacznik == ZNACZNIK_REKORDU_GORILLA_V1) {
+        if (rozmiar < ROZMIAR_GLOWY_STRUMIENIA_V1 || qFromBigEndian<quint32>(p) != rekord.liczba)
+            return false;
+        pierwszyCzas = qFromBigEndian<qint64>(p + 4);
+        p += ROZMIAR_GLOWY_STRUMIENIA_V1;
+        rozmiar -= ROZMIAR_GLOWY_STRUMIENIA_V1;
+    } else {
+        qint64 przesuniecie = 0;
+        const int dlugoscVarint = czytajVarint(p, rozmiar, &przesuniecie);
+        if (dlugoscVarint == 0)
+            return false;
+        pierwszyCzas = qMax<qint64>(kotwica, 0) + przesuniecie;
+        krok = (kotwica >= 0 && pierwszyCzas > kotwica) ? pierwszyCzas - kotwica : 0;
+        p += dlugoscVarint;
+        rozmiar -= dlugoscVarint;
+    }
+
+    KompresjaGorilla::Dekoder dekoder(reinterpret_cast<const char*>(p), rozmiar,
+                                      static_cast<int>(rekord.liczba), pierwszyCzas, krok);
+    while (!dekoder.koniec()) {
+        const WidokSerii blok = dekoder.nastepnyBlok();
+        if (!blok.jestPusty())
+            odbiorca(blok);
+    }
+    return !dekoder.blad();
+}
+
+/**
+ * @brief Indeksuje rekordy dopisane po ostatnim zapisie indeksu.
+ *
+ * Niepełny rekord na końcu pliku (przerwany zapis) jest obcinany.
+ *
+ * @param od Położenie pierwszego nieindeksowanego rekordu.
+ */
+void DziennikPomiarow::indeksujKoncowke(qint64 od) {
+    qint64 pozycja = od;
+    const qint64 rozmiar = m_dane.size();
+
+    while (pozycja < rozmiar) {
+        Rekord rekord;
+        qint64 odMs = 0;
+        qint64 doMs = -1;
+        int liczba = 0;
+
+        // Wszystkie wcześniejsze rekordy są już w indeksie, więc ostatniCzas() jest kotwicą tego rekordu.
+        const bool poprawny = czytajRekord(pozycja, &rekord) &&
+            dekodujRekord(rekord, ostatniCzas(rekord.stanowiskoId), [&](const WidokSerii& blok) {
+                if (liczba == 0)
+                    odMs = blok.pierwszyCzas();
+                doMs = blok.ostatniCzas();
+                liczba += blok.rozmiar();
+            });
+
+        if (!poprawny) {
+            qWarning() << "Obcięto uszkodzoną końcówkę dziennika pomiarów od pozycji" << pozycja;
+            m_dane.resize(pozycja);
+            break;
+        }
+
+        if (liczba > 0)
+            m_nowe.append(WpisIndeksu{rekord.stanowiskoId, rekord.dlugosc, odMs, doMs, pozycja});
+        pozycja += rekord.dlugosc;
+    }
+}
+
+/**
+ * @brief Zapisuje scalony indeks na dysk.
+ *
+ * Wpisy są sortowane po stanowisku i czasie, a plik zapisywany atomowo (QSaveFile).
+ *
+ * @return true jeśli zapis się powiódł.
+ */
+bool DziennikPomiarow::zapiszIndeks() {
+    QVector<WpisIndeksu> wpisy;
+    wpisy.reserve(m_liczbaMapowanych + m_nowe.size());
+    for (int i = 0; i < m_liczbaMapowanych; ++i)
+        wpisy.append(wpisMapowany(i));
+    wpisy += m_nowe;
+
+    std::sort(wpisy.begin(), wpisy.end(), [](const WpisIndeksu& a, const WpisIndeksu& b) {
+        if (a.stanowiskoId != b.stanowiskoId) return a.stanowiskoId < b.stanowiskoId;
+        if (a.odMs != b.odMs) return a.odMs < b.odMs;
+        return a.przesuniecie < b.przesuniecie;
+    });
+
+    QByteArray bufor;
+    bufor.reserve(ROZMIAR_NAGLOWKA_INDEKSU + wpisy.size() * ROZMIAR_WPISU);
+    bufor.append(ZNACZNIK_INDEKSU, 4);
+    dopiszLE<quint32>(bufor, WERSJA);
+    dopiszLE<qint64>(bufor, m_dane.size());
+    dopiszLE<quint32>(bufor, static_cast<quint32>(wpisy.size()));
+    dopiszLE<quint32>(bufor, 0);
+
+    for (const WpisIndeksu& wpis : wpisy) {
+        dopiszLE<qint32>(bufor, wpis.stanowiskoId);
+        dopiszLE<quint32>(bufor, wpis.dlugosc);
+        dopiszLE<qint64>(bufor, wpis.odMs);
+        dopiszLE<qint64>(bufor, wpis.doMs);
+        dopiszLE<qint64>(bufor, wpis.przesuniecie);
+    }
+
+    if (m_mapa) {
+        m_indeks.unmap(const_cast<uchar*>(m_mapa) - ROZMIAR_NAGLOWKA_INDEKSU);
+        m_mapa = nullptr;
+    }
+    m_liczbaMapowanych = 0;
+    m_indeks.close();
+
+    // Do czasu udanego zapisu wszystkie wpisy pozostają w pamięci.
+    m_nowe = wpisy;
+
+    QSaveFile plik(m_sciezkaIndeksu);
+    if (!plik.open(QIODevice::WriteOnly))
+        return false;
+    plik.write(bufor);
+    if (!plik.commit())
+        return false;
+
+    m_nowe.clear();
+    return true;
+}
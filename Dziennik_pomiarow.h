@@ -0,0 +1,216 @@
+/**
+ * @file Dziennik_pomiarow.h
+ * @brief Plik nagłówkowy klasy DziennikPomiarow
+ *
+ * Klasa DziennikPomiarow przechowuje historię pobranych pomiarów wszystkich stanowisk
+ * w binarnym pliku, do którego rekordy są wyłącznie dopisywane, oraz w posortowanym pliku indeksu.
+*/
+
+#ifndef DZIENNIK_POMIAROW_H
+#define DZIENNIK_POMIAROW_H
+
+#include <QFile>
+#include <QString>
+#include <QVector>
+
+#include <functional>
+
+#include "Seria_pomiarowa.h"
+
+/**
+ * @class DziennikPomiarow
+ * @brief Dziennik pomiarów z leniwym odczytem serii.
+ *
+ * Plik danych ("*.bin") to nagłówek i ciąg rekordów z prefiksem długości; każdy rekord zawiera
+ * nowe lub zmienione próbki jednego stanowiska. Plik indeksu ("*.idx") zawiera posortowane
+ * wpisy (stanowisko, pierwsza i ostatnia godzina, położenie rekordu) i jest przy otwarciu
+ * jedynie mapowany do pamięci, więc czas startu nie zależy od długości historii.
+ * Rekordy dopisane w bieżącej sesji są indeksowane w pamięci, a indeks na dysku
+ * jest przepisywany atomowo przy zamknięciu. Jeśli program zakończył się przed zapisem indeksu,
+ * przy następnym otwarciu skanowana jest tylko nieindeksowana końcówka pliku danych.
+ *
+ * Próbki rekordu są kompresowane (KompresjaGorilla). Czas pierwszej próbki rekordu jest zapisany
+ * względem ostatniej próbki stanowiska z wcześniejszych rekordów, a krok między nimi jest punktem
+ * odniesienia dla kodowania czasu, więc dopisanie kilku godzinnych próbek zajmuje kilkanaście bajtów
+ * ponad nagłówek. Rekordy zapisane przez wcześniejsze wersje programu (wprost lub ze strumieniem
+ * zawierającym własny nagłówek) są nadal odczytywane.
+ *
+ * Przy odczycie próbki z późniejszych rekordów zastępują wcześniejsze o tym samym czasie,
+ * dzięki czemu uzupełnione przez GIOŚ wartości nadpisują wcześniejsze braki.
+ */
+class DziennikPomiarow
+{
+public:
+    /**
+     * @brief Konstruktor klasy DziennikPomiarow.
+     * @param sciezka Ścieżka pliku danych; indeks zapisywany jest obok, z rozszerzeniem ".idx".
+     */
+    explicit DziennikPomiarow(const QString& sciezka);
+
+    /**
+     * @brief Destruktor; zapisuje indeks i zamyka pliki.
+     */
+    ~DziennikPomiarow();
+
+    /**
+     * @brief Otwiera dziennik (tworzy pliki, jeśli nie istnieją).
+     * @return true jeśli plik danych został otwarty.
+     */
+    bool otworz();
+
+    /**
+     * @brief Zapisuje indeks i zamyka dziennik.
+     */
+    void zamknij();
+
+    /**
+     * @brief Dopisuje próbki serii, których dziennik jeszcze nie zawiera lub które się zmieniły.
+     * @param stanowiskoId Identyfikator stanowiska.
+     * @param seria Posortowana seria pobrana z API.
+     * @param pierwszyCzas Jeśli podany, otrzymuje czas najwcześniejszej dopisanej próbki (gdy dopisano choć jedną).
+     * @return Liczba dopisanych próbek.
+     */
+    int dopisz(int stanowiskoId, const SeriaPomiarowa& seria, qint64* pierwszyCzas = nullptr);
+
+    /**
+     * @brief Wczytuje całą historię stanowiska.
+     * @param stanowiskoId Identyfikator stanowiska.
+     * @return Posortowana seria (pusta, jeśli dziennik nie zawiera stanowiska).
+     */
+    SeriaPomiarowa wczytaj(int stanowiskoId) const;
+
+    /**
+     * @brief Wczytuje historię stanowiska z przedziału czasu.
+     * @param stanowiskoId Identyfikator stanowiska.
+     * @param odMs Początek przedziału [ms od epoki, UTC].
+     * @param doMs Koniec przedziału (włącznie).
+     * @return Posortowana seria z próbkami z przedziału.
+     */
+    SeriaPomiarowa wczytaj(int stanowiskoId, qint64 odMs, qint64 doMs) const;
+
+    /**
+     * @brief Przekazuje historię stanowiska z przedziału czasu kolejnymi blokami, prosto z dekodera.
+     * @param stanowiskoId Identyfikator stanowiska.
+     * @param odMs Początek przedziału [ms od epoki, UTC].
+     * @param doMs Koniec przedziału (włącznie).
+     * @param odbiorca Funkcja wywoływana dla kolejnych bloków; bloki są posortowane po czasie
+     *                 i nie powtarzają próbek, a widok bloku jest ważny tylko w czasie wywołania.
+     * @return Kod parametru stanowiska (pusty, jeśli żaden rekord stanowiska nie nachodzi na przedział).
+     *
+     * Dopóki rekordy stanowiska nie nakładają się czasem (zwykłe dopisywanie), próbki nie są
+     * kopiowane do serii ani sortowane. Rekordy z poprawkami wcześniejszych próbek są najpierw scalane.
+     */
+    QString przegladaj(int stanowiskoId, qint64 odMs, qint64 doMs,
+                       const std::function<void(const WidokSerii&)>& odbiorca) const;
+
+    /**
+     * @brief Zwraca czas najnowszej zapisanej próbki stanowiska.
+     * @param stanowiskoId Identyfikator stanowiska.
+     * @return Czas w ms od epoki lub -1, jeśli brak danych.
+     */
+    qint64 ostatniCzas(int stanowiskoId) const;
+
+    /**
+     * @brief Zwraca identyfikatory stanowisk obecnych w dzienniku.
+     * @return Identyfikatory w kolejności rosnącej.
+     */
+    QVector<int> stanowiska() const;
+
+    /**
+     * @brief Sprawdza, czy dziennik jest otwarty.
+     * @return true jeśli otworz() się powiodło.
+     */
+    bool jestOtwarty() const;
+
+private:
+    /**
+     * @struct WpisIndeksu
+     * @brief Położenie jednego rekordu w pliku danych.
+     */
+    struct WpisIndeksu {
+        qint32 stanowiskoId;   /**< Identyfikator stanowiska */
+        quint32 dlugosc;       /**< Długość rekordu w bajtach (z prefiksem) */
+        qint64 odMs;           /**< Czas pierwszej próbki rekordu */
+        qint64 doMs;           /**< Czas ostatniej próbki rekordu */
+        qint64 przesuniecie;   /**< Położenie rekordu w pliku danych */
+    };
+
+    /**
+     * @struct Probka
+     * @brief Próbka odczytana z rekordu.
+     */
+    struct Probka {
+        qint64 czas;       /**< Czas [ms od epoki] */
+        float wartosc;     /**< Wartość */
+        bool brak;         /**< Czy brak wartości */
+    };
+
+    /**
+     * @struct Rekord
+     * @brief Rekord odczytany z pliku danych (przed zdekodowaniem próbek).
+     */
+    struct Rekord {
+        quint32 znacznik = 0;      /**< Format rekordu */
+        qint32 stanowiskoId = 0;   /**< Identyfikator stanowiska */
+        quint32 liczba = 0;        /**< Liczba próbek */
+        QString parametr;          /**< Kod parametru */
+        quint32 dlugosc = 0;       /**< Długość rekordu z prefiksem */
+        QByteArray tresc;          /**< Treść rekordu (bez prefiksu długości) */
+        int poczatekProbek = 0;    /**< Położenie próbek w treści */
+    };
+
+    /**
+     * @brief Zwraca wpis indeksu zmapowanego z dysku.
+     * @param i Numer wpisu.
+     * @return Zdekodowany wpis.
+     */
+    WpisIndeksu wpisMapowany(int i) const;
+
+    /**
+     * @brief Zbiera wpisy indeksu stanowiska nachodzące na przedział, w kolejności zapisu.
+     * @param stanowiskoId Identyfikator stanowiska.
+     * @param odMs Początek przedziału.
+     * @param doMs Koniec przedziału.
+     * @return Wpisy indeksu.
+     */
+    QVector<WpisIndeksu> wpisyStanowiska(int stanowiskoId, qint64 odMs, qint64 doMs) const;
+
+    /**
+     * @brief Odczytuje rekord z pliku danych i sprawdza jego nagłówek.
+     * @param przesuniecie Położenie rekordu.
+     * @param rekord Wskaźnik na rekord (wynik).
+     * @return false jeśli rekord jest niepełny lub uszkodzony.
+     */
+    bool czytajRekord(qint64 przesuniecie, Rekord* rekord) const;
+
+    /**
+     * @brief Dekoduje próbki rekordu blokami.
+     * @param rekord Rekord odczytany przez czytajRekord().
+     * @param kotwica Czas ostatniej próbki stanowiska z wcześniejszych rekordów (-1, jeśli ich nie ma).
+     * @param odbiorca Funkcja wywoływana dla kolejnych bloków próbek.
+     * @return false jeśli próbki są uszkodzone.
+     */
+    bool dekodujRekord(const Rekord& rekord, qint64 kotwica,
+                       const std::function<void(const WidokSerii&)>& odbiorca) const;
+
+    /**
+     * @brief Indeksuje rekordy dopisane po ostatnim zapisie indeksu.
+     * @param od Położenie pierwszego nieindeksowanego rekordu.
+     */
+    void indeksujKoncowke(qint64 od);
+
+    /**
+     * @brief Zapisuje scalony indeks na dysk.
+     * @return true jeśli zapis się powiódł.
+     */
+    bool zapiszIndeks();
+
+    QString m_sciezkaIndeksu;            /**< Ścieżka pliku indeksu */
+    mutable QFile m_dane;                /**< Plik danych */
+    QFile m_indeks;                      /**< Plik indeksu (zmapowany) */
+    const uchar* m_mapa = nullptr;       /**< Zmapowane wpisy indeksu */
+    int m_liczbaMapowanych = 0;          /**< Liczba zmapowanych wpisów */
+    QVector<WpisIndeksu> m_nowe;         /**< Wpisy rekordów spoza zapisanego indeksu */
+};
+
+#endif // DZIENNIK_POMIAROW_H
@@ -0,0 +1,42 @@
+/**
+ * @file Geokoder.h
+ * @brief Plik nagłówkowy interfejsu Geokoder
+ *
+ * Interfejs Geokoder zamienia adres lub nazwę miejsca na współrzędne geograficzne.
+ * Pozwala podmienić usługę geokodowania (np. na lokalną atrapę bez dostępu do sieci).
+*/
+
+#ifndef GEOKODER_H
+#define GEOKODER_H
+
+#include <QGeoCoordinate>
+#include <QString>
+
+#include <functional>
+
+/**
+ * @class Geokoder
+ * @brief Interfejs usługi geokodowania.
+ *
+ * Wynik jest przekazywany do funkcji zwrotnej dokładnie raz: z poprawnymi współrzędnymi
+ * albo z niepoprawnymi współrzędnymi i komunikatem błędu.
+ */
+class Geokoder
+{
+public:
+    typedef std::function<void(const QGeoCoordinate& wspolrzedne, const QString& blad)> Wynik;   /**< Funkcja odbierająca wynik */
+
+    /**
+     * @brief Destruktor wirtualny.
+     */
+    virtual ~Geokoder() {}
+
+    /**
+     * @brief Wyznacza współrzędne adresu.
+     * @param adres Adres lub nazwa miejsca.
+     * @param wynik Funkcja wywoływana z wynikiem (także przed powrotem, jeśli usługa jest niedostępna).
+     */
+    virtual void geokoduj(const QString& adres, const Wynik& wynik) = 0;
+};
+
+#endif // GEOKODER_H
@@ -0,0 +1,62 @@
+/**
+ * @file Geokoder_osm.cpp
+ * @brief Plik źródłowy klasy GeokoderOsm
+ */
+
+#include "Geokoder_osm.h"
+
+#include <QGeoCodeReply>
+#include <QGeoCodingManager>
+#include <QGeoLocation>
+#include <QGeoServiceProvider>
+
+/**
+ * @brief Konstruktor klasy GeokoderOsm.
+ *
+ * @param wtyczka Nazwa wtyczki.
+ */
+GeokoderOsm::GeokoderOsm(const QString& wtyczka) :
+    m_wtyczka(wtyczka)
+{}
+
+/**
+ * @brief Destruktor klasy GeokoderOsm.
+ */
+GeokoderOsm::~GeokoderOsm()
+{}
+
+/**
+ * @brief Wysyła zapytanie geokodowania.
+ *
+ * Odpowiedź może być zakończona już w chwili utworzenia (np. błąd wtyczki), dlatego jest
+ * wtedy obsługiwana od razu zamiast przez sygnał finished.
+ *
+ * @param adres Adres.
+ * @param wynik Funkcja odbierająca wynik.
+ */
+void GeokoderOsm::geokoduj(const QString& adres, const Wynik& wynik) {
+    if (!m_dostawca)
+        m_dostawca.reset(new QGeoServiceProvider(m_wtyczka));
+
+    QGeoCodingManager *manager = m_dostawca->geocodingManager();
+    if (!manager) {
+        wynik(QGeoCoordinate(), "Nie można zainicjować usługi geokodowania");
+        return;
+    }
+
+    QGeoCodeReply *reply = manager->geocode(adres);
+    auto obsluz = [reply, wynik]() {
+        if (reply->error() != QGeoCodeReply::NoError)
+            wynik(QGeoCoordinate(), "Błąd geokodowania: " + reply->errorString());
+        else if (reply->locations().isEmpty())
+            wynik(QGeoCoordinate(), "Nie znaleziono lokalizacji");
+        else
+            wynik(reply->locations().first().coordinate(), QString());
+        reply->deleteLater();
+    };
+
+    if (reply->isFinished())
+        obsluz();
+    else
+        QObject::connect(reply, &QGeoCodeReply::finished, reply, obsluz);
+}
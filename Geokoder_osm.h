@@ -0,0 +1,50 @@
+/**
+ * @file Geokoder_osm.h
+ * @brief Plik nagłówkowy klasy GeokoderOsm
+ *
+ * Klasa GeokoderOsm realizuje interfejs Geokoder przy użyciu wtyczki Qt Location
+ * (domyślnie OpenStreetMap / Nominatim).
+*/
+
+#ifndef GEOKODER_OSM_H
+#define GEOKODER_OSM_H
+
+#include "Geokoder.h"
+
+#include <QScopedPointer>
+
+class QGeoServiceProvider;
+
+/**
+ * @class GeokoderOsm
+ * @brief Geokodowanie przez QGeoServiceProvider.
+ *
+ * Dostawca usługi jest tworzony przy pierwszym zapytaniu i używany przez cały czas życia obiektu.
+ */
+class GeokoderOsm : public Geokoder
+{
+public:
+    /**
+     * @brief Konstruktor klasy GeokoderOsm.
+     * @param wtyczka Nazwa wtyczki Qt Location.
+     */
+    explicit GeokoderOsm(const QString& wtyczka = "osm");
+
+    /**
+     * @brief Destruktor; usuwa dostawcę usługi (wraz z niezakończonymi zapytaniami).
+     */
+    ~GeokoderOsm() override;
+
+    /**
+     * @brief Wyznacza współrzędne adresu (pierwsza znaleziona lokalizacja).
+     * @param adres Adres lub nazwa miejsca.
+     * @param wynik Funkcja odbierająca wynik.
+     */
+    void geokoduj(const QString& adres, const Wynik& wynik) override;
+
+private:
+    QString m_wtyczka;                               /**< Nazwa wtyczki Qt Location */
+    QScopedPointer<QGeoServiceProvider> m_dostawca;  /**< Dostawca usługi (tworzony przy pierwszym użyciu) */
+};
+
+#endif // GEOKODER_OSM_H
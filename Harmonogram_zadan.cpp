@@ -0,0 +1,293 @@
+/**
+ * @file Harmonogram_zadan.cpp
+ * @brief Plik źródłowy klasy HarmonogramZadan
+ */
+
+#include "Harmonogram_zadan.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QRandomGenerator>
+#include <QTimer>
+
+namespace {
+const qint64 OPOZNIENIE_BAZOWE_MS = 500;
+const qint64 OPOZNIENIE_MAKS_MS = 30 * 1000;
+const qint64 RETRY_AFTER_MAKS_MS = 5 * 60 * 1000;
+}
+
+/**
+ * @brief Konstruktor klasy HarmonogramZadan.
+ *
+ * @param siec Menedżer sieci.
+ * @param maksWToku Limit równoczesnych zapytań.
+ * @param parent Obiekt rodzica.
+ */
+HarmonogramZadan::HarmonogramZadan(QNetworkAccessManager *siec, int maksWToku, QObject *parent) :
+    QObject(parent),
+    m_siec(siec),
+    m_maksWToku(qMax(1, maksWToku)),
+    m_wznowienie(new QTimer(this))
+{
+    m_wznowienie->setSingleShot(true);
+    connect(m_wznowienie, &QTimer::timeout, this, &HarmonogramZadan::uruchomKolejne);
+}
+
+/**
+ * @brief Dodaje żądanie do kolejki i wysyła je, jeśli jest wolne miejsce.
+ *
+ * @param request Żądanie sieciowe.
+ * @param priorytet Klasa priorytetu.
+ */
+void HarmonogramZadan::dodaj(const QNetworkRequest& request, Priorytet priorytet) {
+    m_kolejki[priorytet].enqueue(Zadanie{request, priorytet, 0, m_nastepnyNumer++});
+    uruchomKolejne();
+}
+
+/**
+ * @brief Przenosi żądanie z kolejki tła do kolejki interaktywnej.
+ *
+ * @param url Adres żądania.
+ * @return true jeśli żądanie zostało przeniesione.
+ */
+bool HarmonogramZadan::podniesPriorytet(const QUrl& url) {
+    QQueue<Zadanie>& tlo = m_kolejki[Tlo];
+    for (int i = 0; i < tlo.size(); ++i) {
+        if (tlo[i].request.url() == url) {
+            Zadanie zadanie = tlo.takeAt(i);
+            zadanie.priorytet = Interaktywny;
+            m_kolejki[Interaktywny].enqueue(zadanie);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Anuluje żądania o podany adres.
+ *
+ * @param url Adres żądania.
+ */
+void HarmonogramZadan::anuluj(const QUrl& url) {
+    for (QQueue<Zadanie>& kolejka : m_kolejki)
+        kolejka.removeIf([&url](const Zadanie& zadanie) { return zadanie.request.url() == url; });
+    for (auto it = m_odroczone.begin(); it != m_odroczone.end();) {
+        if (it->request.url() == url)
+            it = m_odroczone.erase(it);
+        else
+            ++it;
+    }
+
+    QVector<QNetworkReply*> przerwane;
+    for (auto it = m_wToku.cbegin(); it != m_wToku.cend(); ++it) {
+        if (it->request.url() == url)
+            przerwane.append(it.key());
+    }
+    for (QNetworkReply *reply : przerwane) {
+        // Oznaczenie przed abort(): sygnał finished może zostać wyemitowany od razu.
+        m_anulowane.insert(reply);
+        reply->abort();
+    }
+}
+
+/**
+ * @brief Ustawia limit równoczesnych zapytań.
+ *
+ * @param maks Limit.
+ */
+void HarmonogramZadan::ustawMaksWToku(int maks) {
+    m_maksWToku = qMax(1, maks);
+    uruchomKolejne();
+}
+
+/**
+ * @brief Ogranicza częstość wysyłania żądań w tle.
+ *
+ * @param naSekunde Liczba żądań na sekundę (0 - bez limitu).
+ */
+void HarmonogramZadan::ustawLimitTla(int naSekunde) {
+    m_odstepTla = naSekunde > 0 ? 1000 / naSekunde : 0;
+    uruchomKolejne();
+}
+
+/**
+ * @brief Ustawia maksymalną liczbę prób.
+ *
+ * @param maks Liczba prób.
+ */
+void HarmonogramZadan::ustawMaksProb(int maks) {
+    m_maksProb = qMax(1, maks);
+}
+
+/**
+ * @brief Zwraca liczbę zapytań w toku.
+ * @return Liczba zapytań.
+ */
+int HarmonogramZadan::wToku() const {
+    return m_wToku.size();
+}
+
+/**
+ * @brief Zwraca liczbę żądań w kolejkach.
+ * @return Liczba żądań.
+ */
+int HarmonogramZadan::oczekujace() const {
+    return m_kolejki[Interaktywny].size() + m_kolejki[Tlo].size();
+}
+
+/**
+ * @brief Wysyła żądania z kolejek (najpierw interaktywne), dopóki nie zostanie osiągnięty limit.
+ *
+ * Podczas wstrzymania po odpowiedzi 429 nic nie jest wysyłane, a żądania w tle nie są wysyłane
+ * częściej, niż pozwala limit; licznik wznawia wysyłanie.
+ */
+void HarmonogramZadan::uruchomKolejne() {
+    const qint64 teraz = QDateTime::currentMSecsSinceEpoch();
+    if (teraz < m_wstrzymaneDo) {
+        zaplanujWznowienie(m_wstrzymaneDo - teraz);
+        return;
+    }
+
+    while (m_wToku.size() < m_maksWToku) {
+        QQueue<Zadanie>& kolejka = !m_kolejki[Interaktywny].isEmpty() ? m_kolejki[Interaktywny] : m_kolejki[Tlo];
+        if (kolejka.isEmpty())
+            return;
+
+        if (&kolejka == &m_kolejki[Tlo]) {
+            if (teraz < m_nastepneTlo) {
+                zaplanujWznowienie(m_nastepneTlo - teraz);
+                return;
+            }
+            m_nastepneTlo = teraz + m_odstepTla;
+        }
+
+        const Zadanie zadanie = kolejka.dequeue();
+        QNetworkReply *reply = m_siec->get(zadanie.request);
+        m_wToku.insert(reply, zadanie);
+        connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+            obsluzZakonczenie(reply);
+        });
+    }
+}
+
+/**
+ * @brief Uruchamia licznik wznowienia.
+ *
+ * @param ms Opóźnienie w ms.
+ */
+void HarmonogramZadan::zaplanujWznowienie(qint64 ms) {
+    if (!m_wznowienie->isActive() || m_wznowienie->remainingTime() > ms)
+        m_wznowienie->start(int(ms));
+}
+
+/**
+ * @brief Obsługuje zakończenie zapytania.
+ *
+ * Przejściowy błąd jest ponawiany po opóźnieniu (odpowiedź jest usuwana), a pozostałe wyniki
+ * są przekazywane sygnałem zakonczono().
+ *
+ * @param reply Zakończona odpowiedź.
+ */
+void HarmonogramZadan::obsluzZakonczenie(QNetworkReply *reply) {
+    Zadanie zadanie = m_wToku.take(reply);
+
+    if (m_anulowane.remove(reply)) {
+        reply->deleteLater();
+        uruchomKolejne();
+        return;
+    }
+
+    if (bladPrzejsciowy(reply) && zadanie.proba + 1 < m_maksProb) {
+        const qint64 serwer = opoznienieSerwera(reply);
+        const qint64 opoznienie = serwer >= 0 ? serwer : opoznienieProby(zadanie.proba);
+        const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+
+        if (status == 429)
+            m_wstrzymaneDo = qMax(m_wstrzymaneDo, QDateTime::currentMSecsSinceEpoch() + opoznienie);
+
+        qWarning() << "Ponowienie żądania" << zadanie.request.url().toString()
+                   << "za" << opoznienie << "ms (próba" << zadanie.proba + 2 << ")";
+
+        ++zadanie.proba;
+        m_odroczone.insert(zadanie.numer, zadanie);
+        const quint64 numer = zadanie.numer;
+        QTimer::singleShot(int(opoznienie), this, [this, numer]() {
+            // Ponowienie (jeśli nie zostało anulowane) wraca na początek kolejki swojej klasy.
+            if (!m_odroczone.contains(numer))
+                return;
+            const Zadanie odroczone = m_odroczone.take(numer);
+            m_kolejki[odroczone.priorytet].prepend(odroczone);
+            uruchomKolejne();
+        });
+
+        reply->deleteLater();
+        uruchomKolejne();
+        return;
+    }
+
+    emit zakonczono(reply);
+    uruchomKolejne();
+}
+
+/**
+ * @brief Sprawdza, czy błąd odpowiedzi jest przejściowy.
+ *
+ * @param reply Odpowiedź.
+ * @return true dla przekroczenia czasu, błędów połączenia oraz HTTP 429 i 5xx.
+ */
+bool HarmonogramZadan::bladPrzejsciowy(QNetworkReply *reply) {
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (status == 429 || status == 500 || status == 502 || status == 503 || status == 504)
+        return true;
+
+    switch (reply->error()) {
+    case QNetworkReply::RemoteHostClosedError:
+    case QNetworkReply::TimeoutError:
+    case QNetworkReply::TemporaryNetworkFailureError:
+    case QNetworkReply::NetworkSessionFailedError:
+    case QNetworkReply::ProxyTimeoutError:
+    case QNetworkReply::UnknownNetworkError:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Odczytuje nagłówek Retry-After (liczba sekund lub data HTTP).
+ *
+ * @param reply Odpowiedź.
+ * @return Opóźnienie w ms (ograniczone do 5 minut) lub -1.
+ */
+qint64 HarmonogramZadan::opoznienieSerwera(QNetworkReply *reply) {
+    const QByteArray naglowek = reply->rawHeader("Retry-After").trimmed();
+    if (naglowek.isEmpty())
+        return -1;
+
+    bool ok = false;
+    qint64 ms = naglowek.toLongLong(&ok) * 1000;
+    if (!ok) {
+        const QDateTime termin = QDateTime::fromString(QString::fromLatin1(naglowek), Qt::RFC2822Date);
+        if (!termin.isValid())
+            return -1;
+        ms = QDateTime::currentDateTimeUtc().msecsTo(termin);
+    }
+
+    return qBound<qint64>(0, ms, RETRY_AFTER_MAKS_MS);
+}
+
+/**
+ * @brief Wylicza opóźnienie ponowienia.
+ *
+ * Opóźnienie rośnie dwukrotnie z każdą próbą (0,5 s, 1 s, 2 s, ... do 30 s); losowana jest wartość
+ * z przedziału [połowa, całość], aby wiele klientów nie ponawiało żądań w tej samej chwili.
+ *
+ * @param proba Numer nieudanej próby.
+ * @return Opóźnienie w ms.
+ */
+qint64 HarmonogramZadan::opoznienieProby(int proba) {
+    const qint64 limit = qMin(OPOZNIENIE_MAKS_MS, OPOZNIENIE_BAZOWE_MS << qMin(proba, 16));
+    return limit / 2 + QRandomGenerator::global()->bounded(limit / 2 + 1);
+}
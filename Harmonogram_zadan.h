@@ -0,0 +1,183 @@
+/**
+ * @file Harmonogram_zadan.h
+ * @brief Plik nagłówkowy klasy HarmonogramZadan
+ *
+ * Klasa HarmonogramZadan kolejkuje żądania HTTP przed QNetworkAccessManager:
+ * ogranicza liczbę równoczesnych zapytań, obsługuje priorytety i ponawia przejściowe błędy.
+*/
+
+#ifndef HARMONOGRAM_ZADAN_H
+#define HARMONOGRAM_ZADAN_H
+
+#include <QObject>
+#include <QHash>
+#include <QNetworkRequest>
+#include <QQueue>
+#include <QSet>
+
+class QNetworkAccessManager;
+class QNetworkReply;
+class QTimer;
+
+/**
+ * @class HarmonogramZadan
+ * @brief Kolejka żądań GET z limitem równoczesności, priorytetami i ponawianiem.
+ *
+ * Żądania interaktywne (kliknięcia użytkownika) są zawsze wysyłane przed żądaniami w tle
+ * (np. pobieranie całej sieci stanowisk), a żądania w tle mogą mieć dodatkowo ograniczoną
+ * częstość wysyłania. Błędy przejściowe (przekroczenie czasu, zerwane połączenie,
+ * HTTP 429 i 5xx) są ponawiane z wykładniczo rosnącym opóźnieniem z losowym rozrzutem.
+ * Nagłówek Retry-After ma pierwszeństwo przed wyliczonym opóźnieniem, a odpowiedź 429
+ * wstrzymuje wysyłanie wszystkich żądań do upływu wskazanego czasu.
+ *
+ * Sygnał zakonczono() jest emitowany tylko dla ostatecznego wyniku; odbiorca usuwa odpowiedź (deleteLater).
+ * Anulowane żądania są usuwane z kolejek, a zapytania w toku przerywane bez emitowania sygnału.
+ */
+class HarmonogramZadan : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @enum Priorytet
+     * @brief Klasa priorytetu żądania.
+     */
+    enum Priorytet {
+        Interaktywny = 0,   /**< Żądanie wywołane przez użytkownika */
+        Tlo = 1             /**< Żądanie w tle (może czekać) */
+    };
+
+    /**
+     * @brief Konstruktor klasy HarmonogramZadan.
+     * @param siec Menedżer sieci wysyłający żądania.
+     * @param maksWToku Maksymalna liczba równoczesnych zapytań.
+     * @param parent Wskaźnik na obiekt rodzica (domyślnie nullptr).
+     */
+    explicit HarmonogramZadan(QNetworkAccessManager *siec, int maksWToku = 4, QObject *parent = nullptr);
+
+    /**
+     * @brief Dodaje żądanie GET do kolejki.
+     * @param request Żądanie sieciowe.
+     * @param priorytet Klasa priorytetu.
+     */
+    void dodaj(const QNetworkRequest& request, Priorytet priorytet = Interaktywny);
+
+    /**
+     * @brief Przenosi oczekujące żądanie w tle do kolejki interaktywnej.
+     * @param url Adres żądania.
+     * @return true jeśli żądanie czekało w kolejce tła.
+     */
+    bool podniesPriorytet(const QUrl& url);
+
+    /**
+     * @brief Anuluje żądania o podany adres.
+     * @param url Adres żądania.
+     *
+     * Żądanie jest usuwane z kolejki lub z oczekujących ponowień, a zapytanie w toku przerywane.
+     * Anulowana odpowiedź nie jest przekazywana sygnałem zakonczono().
+     */
+    void anuluj(const QUrl& url);
+
+    /**
+     * @brief Ustawia maksymalną liczbę równoczesnych zapytań.
+     * @param maks Limit (co najmniej 1).
+     */
+    void ustawMaksWToku(int maks);
+
+    /**
+     * @brief Ogranicza częstość wysyłania żądań w tle.
+     * @param naSekunde Maksymalna liczba żądań w tle na sekundę (0 - bez limitu).
+     */
+    void ustawLimitTla(int naSekunde);
+
+    /**
+     * @brief Ustawia maksymalną liczbę prób jednego żądania.
+     * @param maks Liczba prób (co najmniej 1).
+     */
+    void ustawMaksProb(int maks);
+
+    /**
+     * @brief Zwraca liczbę zapytań w toku.
+     * @return Liczba wysłanych, niezakończonych zapytań.
+     */
+    int wToku() const;
+
+    /**
+     * @brief Zwraca liczbę żądań czekających w kolejkach (bez odroczonych ponowień).
+     * @return Liczba żądań.
+     */
+    int oczekujace() const;
+
+signals:
+    /**
+     * @brief Sygnał emitowany po ostatecznym zakończeniu żądania.
+     * @param reply Odpowiedź (sukces, błąd nieprzejściowy lub ostatnia nieudana próba).
+     */
+    void zakonczono(QNetworkReply *reply);
+
+private slots:
+    /**
+     * @brief Wysyła kolejne żądania, dopóki nie zostanie osiągnięty limit.
+     */
+    void uruchomKolejne();
+
+private:
+    /**
+     * @struct Zadanie
+     * @brief Żądanie w kolejce.
+     */
+    struct Zadanie {
+        QNetworkRequest request;   /**< Żądanie */
+        Priorytet priorytet;       /**< Klasa priorytetu */
+        int proba;                 /**< Numer próby (od 0) */
+        quint64 numer;             /**< Numer zadania (identyfikuje odroczone ponowienie) */
+    };
+
+    /**
+     * @brief Obsługuje zakończenie zapytania: ponawia je albo przekazuje wynik.
+     * @param reply Zakończona odpowiedź.
+     */
+    void obsluzZakonczenie(QNetworkReply *reply);
+
+    /**
+     * @brief Sprawdza, czy błąd odpowiedzi jest przejściowy.
+     * @param reply Odpowiedź.
+     * @return true jeśli żądanie warto ponowić.
+     */
+    static bool bladPrzejsciowy(QNetworkReply *reply);
+
+    /**
+     * @brief Odczytuje nagłówek Retry-After.
+     * @param reply Odpowiedź.
+     * @return Opóźnienie w ms lub -1, jeśli nagłówka nie ma.
+     */
+    static qint64 opoznienieSerwera(QNetworkReply *reply);
+
+    /**
+     * @brief Wylicza opóźnienie ponowienia (wykładnicze, z losowym rozrzutem).
+     * @param proba Numer nieudanej próby (od 0).
+     * @return Opóźnienie w ms.
+     */
+    static qint64 opoznienieProby(int proba);
+
+    /**
+     * @brief Uruchamia licznik wznowienia, jeśli nie jest już ustawiony na wcześniejszy czas.
+     * @param ms Opóźnienie w ms.
+     */
+    void zaplanujWznowienie(qint64 ms);
+
+    QNetworkAccessManager *m_siec;            /**< Menedżer sieci */
+    int m_maksWToku;                          /**< Limit równoczesnych zapytań */
+    int m_maksProb = 4;                       /**< Maksymalna liczba prób żądania */
+    QQueue<Zadanie> m_kolejki[2];             /**< Kolejki oczekujących (według priorytetu) */
+    QHash<QNetworkReply*, Zadanie> m_wToku;   /**< Zapytania w toku */
+    QHash<quint64, Zadanie> m_odroczone;      /**< Ponowienia czekające na upływ opóźnienia */
+    QSet<QNetworkReply*> m_anulowane;         /**< Przerwane zapytania, których wynik jest pomijany */
+    quint64 m_nastepnyNumer = 0;              /**< Numer kolejnego zadania */
+    qint64 m_wstrzymaneDo = 0;                /**< Czas, do którego wysyłanie jest wstrzymane (po 429) */
+    qint64 m_odstepTla = 0;                   /**< Minimalny odstęp między żądaniami w tle [ms] */
+    qint64 m_nastepneTlo = 0;                 /**< Najwcześniejszy czas wysłania kolejnego żądania w tle */
+    QTimer *m_wznowienie;                     /**< Licznik wznowienia po wstrzymaniu */
+};
+
+#endif // HARMONOGRAM_ZADAN_H
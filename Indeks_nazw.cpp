@@ -0,0 +1,190 @@
+/**
+ * @file Indeks_nazw.cpp
+ * @brief Plik źródłowy klasy IndeksNazw
+ */
+
+#include "Indeks_nazw.h"
+
+#include <algorithm>
+
+namespace {
+/// Minimalne podobieństwo (współczynnik Dice'a trigramów) nazwy zwracanej jako rozmyta.
+const float PROG_PODOBIENSTWA = 0.5f;
+
+/**
+ * @brief Koduje trzy znaki jako jedną liczbę.
+ */
+quint64 trigram(QChar a, QChar b, QChar c) {
+    return (quint64(a.unicode()) << 32) | (quint64(b.unicode()) << 16) | quint64(c.unicode());
+}
+}
+
+/**
+ * @brief Składa tekst do postaci porównywanej.
+ *
+ * Rozkład NFKD oddziela znaki diakrytyczne od liter, które są następnie pomijane;
+ * "ł" i "Ł" nie mają rozkładu w Unicode, więc są zamieniane jawnie.
+ *
+ * @param tekst Tekst.
+ * @return Złożony tekst.
+ */
+QString IndeksNazw::zloz(const QString& tekst) {
+    const QString rozlozony = tekst.normalized(QString::NormalizationForm_KD);
+
+    QString wynik;
+    wynik.reserve(rozlozony.size());
+    bool odstep = true;
+    for (QChar znak : rozlozony) {
+        if (znak.category() == QChar::Mark_NonSpacing)
+            continue;
+        if (znak == QChar(0x0141) || znak == QChar(0x0142))
+            znak = QLatin1Char('l');
+
+        if (znak.isLetterOrNumber()) {
+            wynik.append(znak.toCaseFolded());
+            odstep = false;
+        } else if (!odstep) {
+            wynik.append(QLatin1Char(' '));
+            odstep = true;
+        }
+    }
+    if (wynik.endsWith(QLatin1Char(' ')))
+        wynik.chop(1);
+    return wynik;
+}
+
+/**
+ * @brief Buduje indeks.
+ *
+ * @param nazwy Nazwy.
+ */
+void IndeksNazw::zbuduj(const QVector<QString>& nazwy) {
+    wyczysc();
+
+    m_zlozone.reserve(nazwy.size());
+    m_liczbaTrigramow.reserve(nazwy.size());
+    for (int i = 0; i < nazwy.size(); ++i) {
+        const QString zlozona = zloz(nazwy[i]);
+        m_zlozone.append(zlozona);
+
+        for (int p = 0; p < zlozona.size(); ++p) {
+            if (p == 0 || zlozona[p - 1] == QLatin1Char(' '))
+                m_sufiksy.append(Sufiks{zlozona.mid(p), i, p == 0});
+        }
+
+        const QVector<quint64> t = trigramy(zlozona);
+        m_liczbaTrigramow.append(t.size());
+        for (quint64 k : t)
+            m_listy[k].append(i);
+    }
+
+    std::sort(m_sufiksy.begin(), m_sufiksy.end(), [](const Sufiks& a, const Sufiks& b) {
+        return a.tekst < b.tekst;
+    });
+}
+
+/**
+ * @brief Usuwa wszystkie nazwy z indeksu.
+ */
+void IndeksNazw::wyczysc() {
+    m_zlozone.clear();
+    m_liczbaTrigramow.clear();
+    m_sufiksy.clear();
+    m_listy.clear();
+}
+
+/**
+ * @brief Zwraca liczbę nazw.
+ * @return Liczba nazw.
+ */
+int IndeksNazw::rozmiar() const {
+    return m_zlozone.size();
+}
+
+/**
+ * @brief Wyszukuje nazwy pasujące do zapytania.
+ *
+ * Prefiksy są znajdowane wyszukiwaniem binarnym w posortowanych sufiksach. Dla zapytań
+ * od trzech znaków zliczane są wspólne trigramy: nazwa zawierająca wszystkie trigramy
+ * zapytania jest sprawdzana jako fragment, a pozostałe (przy rozmyte) oceniane współczynnikiem Dice'a.
+ *
+ * @param zapytanie Zapytanie.
+ * @param limit Maksymalna liczba wyników.
+ * @param rozmyte Czy zwracać nazwy podobne.
+ * @return Trafienia.
+ */
+QVector<IndeksNazw::Trafienie> IndeksNazw::szukaj(const QString& zapytanie, int limit, bool rozmyte) const {
+    const QString q = zloz(zapytanie);
+    if (q.isEmpty())
+        return QVector<Trafienie>();
+
+    QHash<int, float> oceny;
+    auto ocen = [&oceny](int indeks, float ocena) {
+        float& biezaca = oceny[indeks];
+        biezaca = qMax(biezaca, ocena);
+    };
+
+    auto it = std::lower_bound(m_sufiksy.cbegin(), m_sufiksy.cend(), q,
+                               [](const Sufiks& s, const QString& tekst) { return s.tekst < tekst; });
+    for (; it != m_sufiksy.cend() && it->tekst.startsWith(q); ++it) {
+        if (!it->poczatek)
+            ocen(it->indeks, 0.8f);
+        else
+            ocen(it->indeks, it->tekst.size() == q.size() ? 1.0f : 0.9f);
+    }
+
+    const QVector<quint64> t = trigramy(q);
+    if (!t.isEmpty()) {
+        QHash<int, int> wspolne;
+        for (quint64 k : t) {
+            const auto lista = m_listy.constFind(k);
+            if (lista == m_listy.cend())
+                continue;
+            for (int indeks : *lista)
+                ++wspolne[indeks];
+        }
+
+        for (auto w = wspolne.cbegin(); w != wspolne.cend(); ++w) {
+            if (w.value() == t.size() && m_zlozone[w.key()].contains(q)) {
+                ocen(w.key(), 0.7f);
+            } else if (rozmyte) {
+                const float dice = 2.0f * w.value() / float(t.size() + m_liczbaTrigramow[w.key()]);
+                if (dice >= PROG_PODOBIENSTWA)
+                    ocen(w.key(), 0.6f * dice);
+            }
+        }
+    }
+
+    QVector<Trafienie> wynik;
+    wynik.reserve(oceny.size());
+    for (auto o = oceny.cbegin(); o != oceny.cend(); ++o)
+        wynik.append(Trafienie{o.key(), o.value()});
+
+    std::sort(wynik.begin(), wynik.end(), [this](const Trafienie& a, const Trafienie& b) {
+        if (a.ocena != b.ocena)
+            return a.ocena > b.ocena;
+        if (m_zlozone[a.indeks].size() != m_zlozone[b.indeks].size())
+            return m_zlozone[a.indeks].size() < m_zlozone[b.indeks].size();
+        return a.indeks < b.indeks;
+    });
+
+    if (limit >= 0 && wynik.size() > limit)
+        wynik.resize(limit);
+    return wynik;
+}
+
+/**
+ * @brief Zwraca unikalne trigramy tekstu.
+ *
+ * @param tekst Złożony tekst.
+ * @return Trigramy (pusta tablica dla tekstu krótszego niż 3 znaki).
+ */
+QVector<quint64> IndeksNazw::trigramy(const QString& tekst) {
+    QVector<quint64> wynik;
+    for (int i = 0; i + 2 < tekst.size(); ++i)
+        wynik.append(trigram(tekst[i], tekst[i + 1], tekst[i + 2]));
+
+    std::sort(wynik.begin(), wynik.end());
+    wynik.erase(std::unique(wynik.begin(), wynik.end()), wynik.end());
+    return wynik;
+}
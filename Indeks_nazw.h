@@ -0,0 +1,95 @@
+/**
+ * @file Indeks_nazw.h
+ * @brief Plik nagłówkowy klasy IndeksNazw
+ *
+ * Klasa IndeksNazw wyszukuje nazwy (miast, stacji) bez rozróżniania wielkości liter i znaków
+ * diakrytycznych, po prefiksie, fragmencie i z tolerancją literówek, z wynikami uszeregowanymi.
+*/
+
+#ifndef INDEKS_NAZW_H
+#define INDEKS_NAZW_H
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+/**
+ * @class IndeksNazw
+ * @brief Indeks prefiksowy i trigramowy znormalizowanych nazw.
+ *
+ * Nazwy są sprowadzane do postaci złożonej (zloz()): bez znaków diakrytycznych (także "ł" -> "l"),
+ * małymi literami, z pojedynczą spacją między słowami, więc "lodz" znajduje "Łódź".
+ * Indeks zawiera posortowane sufiksy zaczynające się na początku słów (wyszukiwanie prefiksu
+ * przez wyszukiwanie binarne) oraz listy nazw dla każdego trigramu (fragmenty i literówki).
+ * Zapytanie kosztuje wyszukiwanie binarne i przejście krótkich list, a nie przegląd wszystkich nazw.
+ */
+class IndeksNazw
+{
+public:
+    /**
+     * @struct Trafienie
+     * @brief Wynik wyszukiwania.
+     */
+    struct Trafienie {
+        int indeks;     /**< Numer nazwy w tablicy przekazanej do zbuduj() */
+        float ocena;    /**< Trafność: 1 - cała nazwa, 0.9 - początek nazwy, 0.8 - początek słowa, 0.7 - fragment, poniżej 0.6 - podobieństwo */
+    };
+
+    /**
+     * @brief Sprowadza tekst do postaci porównywanej w indeksie.
+     * @param tekst Tekst.
+     * @return Tekst bez znaków diakrytycznych i interpunkcji, małymi literami.
+     */
+    static QString zloz(const QString& tekst);
+
+    /**
+     * @brief Buduje indeks od nowa.
+     * @param nazwy Nazwy; ich numery są zwracane w trafieniach.
+     */
+    void zbuduj(const QVector<QString>& nazwy);
+
+    /**
+     * @brief Usuwa wszystkie nazwy z indeksu.
+     */
+    void wyczysc();
+
+    /**
+     * @brief Zwraca liczbę nazw w indeksie.
+     * @return Liczba nazw.
+     */
+    int rozmiar() const;
+
+    /**
+     * @brief Wyszukuje nazwy pasujące do zapytania.
+     * @param zapytanie Tekst wpisany przez użytkownika (np. początek nazwy).
+     * @param limit Maksymalna liczba wyników (-1 - bez limitu).
+     * @param rozmyte Czy zwracać też nazwy tylko podobne (literówki).
+     * @return Trafienia od najlepszego; przy równej ocenie krótsza nazwa jest pierwsza.
+     */
+    QVector<Trafienie> szukaj(const QString& zapytanie, int limit = -1, bool rozmyte = true) const;
+
+private:
+    /**
+     * @struct Sufiks
+     * @brief Fragment nazwy od początku jednego ze słów.
+     */
+    struct Sufiks {
+        QString tekst;   /**< Złożona nazwa od początku słowa do końca */
+        int indeks;      /**< Numer nazwy */
+        bool poczatek;   /**< Czy fragment zaczyna się na początku nazwy */
+    };
+
+    /**
+     * @brief Zwraca unikalne trigramy złożonego tekstu.
+     * @param tekst Złożony tekst.
+     * @return Trigramy zakodowane jako liczby.
+     */
+    static QVector<quint64> trigramy(const QString& tekst);
+
+    QVector<QString> m_zlozone;                 /**< Złożone nazwy */
+    QVector<int> m_liczbaTrigramow;             /**< Liczba unikalnych trigramów każdej nazwy */
+    QVector<Sufiks> m_sufiksy;                  /**< Sufiksy od początków słów, posortowane */
+    QHash<quint64, QVector<int>> m_listy;       /**< Trigram -> rosnące numery nazw */
+};
+
+#endif // INDEKS_NAZW_H
@@ -0,0 +1,299 @@
+/**
+ * @file Indeks_przestrzenny.cpp
+ * @brief Plik źródłowy klasy IndeksPrzestrzenny
+ */
+
+#include "Indeks_przestrzenny.h"
+
+#include <QtMath>
+#include <algorithm>
+#include <limits>
+#include <queue>
+
+namespace {
+
+const double PROMIEN_ZIEMI_KM = 6371.0; /**< Średni promień Ziemi */
+const int ROZMIAR_LISCIA = 8;           /**< Maksymalna liczba punktów w liściu */
+
+/**
+ * @brief Zamienia współrzędne geograficzne na wektor jednostkowy.
+ */
+void naWektor(double lat, double lon, double p[3]) {
+    const double phi = qDegreesToRadians(lat);
+    const double lambda = qDegreesToRadians(lon);
+    const double cosPhi = qCos(phi);
+    p[0] = cosPhi * qCos(lambda);
+    p[1] = cosPhi * qSin(lambda);
+    p[2] = qSin(phi);
+}
+
+/**
+ * @brief Zamienia kwadrat długości cięciwy na odległość po wielkim okręgu.
+ */
+double cieciwaNaKm(double cieciwa2) {
+    const double polowa = qMin(1.0, qSqrt(cieciwa2) / 2.0);
+    return 2.0 * PROMIEN_ZIEMI_KM * qAsin(polowa);
+}
+
+} // namespace
+
+/**
+ * @brief Domyślny konstruktor klasy IndeksPrzestrzenny.
+ */
+IndeksPrzestrzenny::IndeksPrzestrzenny()
+{}
+
+/**
+ * @brief Buduje drzewo k-d nad podanymi punktami.
+ *
+ * Punkty są sortowane częściowo (std::nth_element) wzdłuż najdłuższej osi prostopadłościanu,
+ * a następnie współrzędne są przepisywane w kolejności drzewa, żeby liście zajmowały ciągłe fragmenty pamięci.
+ *
+ * @param lat Szerokości geograficzne punktów.
+ * @param lon Długości geograficzne punktów.
+ */
+void IndeksPrzestrzenny::zbuduj(const QVector<double>& lat, const QVector<double>& lon) {
+    wyczysc();
+
+    const int n = qMin(lat.size(), lon.size());
+    if (n == 0) return;
+
+    m_x.resize(n);
+    m_y.resize(n);
+    m_z.resize(n);
+    m_indeksy.resize(n);
+
+    for (int i = 0; i < n; ++i) {
+        double p[3];
+        naWektor(lat[i], lon[i], p);
+        m_x[i] = p[0];
+        m_y[i] = p[1];
+        m_z[i] = p[2];
+        m_indeksy[i] = i;
+    }
+
+    m_wezly.reserve(2 * (n / ROZMIAR_LISCIA + 1));
+    zbudujWezel(0, n);
+
+    QVector<double> x(n), y(n), z(n);
+    for (int i = 0; i < n; ++i) {
+        const int zrodlo = m_indeksy[i];
+        x[i] = m_x[zrodlo];
+        y[i] = m_y[zrodlo];
+        z[i] = m_z[zrodlo];
+    }
+    m_x.swap(x);
+    m_y.swap(y);
+    m_z.swap(z);
+}
+
+/**
+ * @brief Usuwa wszystkie punkty i węzły indeksu.
+ */
+void IndeksPrzestrzenny::wyczysc() {
+    m_x.clear();
+    m_y.clear();
+    m_z.clear();
+    m_indeksy.clear();
+    m_wezly.clear();
+}
+
+/**
+ * @brief Rekurencyjnie buduje węzeł drzewa.
+ *
+ * W trakcie budowy m_x/m_y/m_z są jeszcze w kolejności wejściowej, a permutowana jest tylko tablica m_indeksy.
+ *
+ * @param poczatek Pierwszy punkt zakresu.
+ * @param koniec Punkt za ostatnim punktem zakresu.
+ * @return Indeks utworzonego węzła.
+ */
+int IndeksPrzestrzenny::zbudujWezel(int poczatek, int koniec) {
+    const QVector<double>* osie[3] = { &m_x, &m_y, &m_z };
+
+    Wezel w;
+    w.poczatek = poczatek;
+    w.koniec = koniec;
+    w.lewy = -1;
+    w.prawy = -1;
+    for (int o = 0; o < 3; ++o) {
+        w.min[o] = std::numeric_limits<double>::max();
+        w.max[o] = std::numeric_limits<double>::lowest();
+    }
+    for (int i = poczatek; i < koniec; ++i) {
+        const int idx = m_indeksy[i];
+        for (int o = 0; o < 3; ++o) {
+            const double v = (*osie[o])[idx];
+            w.min[o] = qMin(w.min[o], v);
+            w.max[o] = qMax(w.max[o], v);
+        }
+    }
+
+    const int numer = m_wezly.size();
+    m_wezly.append(w);
+
+    if (koniec - poczatek <= ROZMIAR_LISCIA)
+        return numer;
+
+    int os = 0;
+    for (int o = 1; o < 3; ++o) {
+        if (w.max[o] - w.min[o] > w.max[os] - w.min[os])
+            os = o;
+    }
+
+    const QVector<double>& wsp = *osie[os];
+    const int srodek = poczatek + (koniec - poczatek) / 2;
+    std::nth_element(m_indeksy.begin() + poczatek, m_indeksy.begin() + srodek,
+                     m_indeksy.begin() + koniec,
+                     [&wsp](int a, int b) { return wsp[a] < wsp[b]; });
+
+    const int lewy = zbudujWezel(poczatek, srodek);
+    const int prawy = zbudujWezel(srodek, koniec);
+    m_wezly[numer].lewy = lewy;
+    m_wezly[numer].prawy = prawy;
+    return numer;
+}
+
+/**
+ * @brief Oblicza kwadrat odległości punktu od prostopadłościanu węzła.
+ * @param w Węzeł drzewa.
+ * @param p Punkt w przestrzeni 3D.
+ * @return Kwadrat odległości.
+ */
+double IndeksPrzestrzenny::odlegloscDoPudelka2(const Wezel& w, const double p[3]) {
+    double d2 = 0.0;
+    for (int o = 0; o < 3; ++o) {
+        double d = 0.0;
+        if (p[o] < w.min[o]) d = w.min[o] - p[o];
+        else if (p[o] > w.max[o]) d = p[o] - w.max[o];
+        d2 += d * d;
+    }
+    return d2;
+}
+
+/**
+ * @brief Wyszukuje punkty w zadanym promieniu.
+ *
+ * Promień jest zamieniany na długość cięciwy, a poddrzewa, których prostopadłościan leży dalej, są pomijane.
+ *
+ * @param lat Szerokość geograficzna punktu odniesienia.
+ * @param lon Długość geograficzna punktu odniesienia.
+ * @param promienKm Promień w kilometrach.
+ * @return Wyniki posortowane według odległości.
+ */
+QVector<IndeksPrzestrzenny::Wynik> IndeksPrzestrzenny::wPromieniu(double lat, double lon, double promienKm) const {
+    QVector<Wynik> wynik;
+    if (m_wezly.isEmpty() || promienKm < 0) return wynik;
+
+    double q[3];
+    naWektor(lat, lon, q);
+
+    const double kat = qMin(promienKm / PROMIEN_ZIEMI_KM, M_PI);
+    const double cieciwa = 2.0 * qSin(kat / 2.0);
+    const double prog2 = cieciwa * cieciwa;
+
+    int stos[64];
+    int wierzch = 0;
+    stos[wierzch++] = 0;
+
+    while (wierzch > 0) {
+        const Wezel& w = m_wezly[stos[--wierzch]];
+        if (odlegloscDoPudelka2(w, q) > prog2) continue;
+
+        if (w.lewy < 0) {
+            for (int i = w.poczatek; i < w.koniec; ++i) {
+                const double dx = m_x[i] - q[0];
+                const double dy = m_y[i] - q[1];
+                const double dz = m_z[i] - q[2];
+                const double d2 = dx * dx + dy * dy + dz * dz;
+                if (d2 <= prog2)
+                    wynik.append({ m_indeksy[i], cieciwaNaKm(d2) });
+            }
+            continue;
+        }
+
+        stos[wierzch++] = w.lewy;
+        stos[wierzch++] = w.prawy;
+    }
+
+    std::sort(wynik.begin(), wynik.end(), [](const Wynik& a, const Wynik& b) {
+        return a.odlegloscKm < b.odlegloscKm;
+    });
+    return wynik;
+}
+
+/**
+ * @brief Wyszukuje k najbliższych punktów.
+ *
+ * Węzły odwiedzane są w kolejności rosnącej odległości prostopadłościanu od punktu zapytania,
+ * a przeszukiwanie kończy się, gdy najbliższy nieodwiedzony węzeł jest dalej niż k-ty znaleziony punkt.
+ *
+ * @param lat Szerokość geograficzna punktu odniesienia.
+ * @param lon Długość geograficzna punktu odniesienia.
+ * @param k Maksymalna liczba wyników.
+ * @return Wyniki posortowane według odległości.
+ */
+QVector<IndeksPrzestrzenny::Wynik> IndeksPrzestrzenny::najblizsze(double lat, double lon, int k) const {
+    QVector<Wynik> wynik;
+    if (m_wezly.isEmpty() || k <= 0) return wynik;
+
+    double q[3];
+    naWektor(lat, lon, q);
+
+    typedef QPair<double, int> Para; // (kwadrat odległości, indeks)
+    std::priority_queue<Para, std::vector<Para>, std::greater<Para>> wezly;
+    std::priority_queue<Para> najlepsze;
+
+    wezly.push(qMakePair(odlegloscDoPudelka2(m_wezly[0], q), 0));
+
+    while (!wezly.empty()) {
+        const Para biezacy = wezly.top();
+        wezly.pop();
+
+        if (int(najlepsze.size()) == k && biezacy.first > najlepsze.top().first)
+            break;
+
+        const Wezel& w = m_wezly[biezacy.second];
+        if (w.lewy < 0) {
+            for (int i = w.poczatek; i < w.koniec; ++i) {
+                const double dx = m_x[i] - q[0];
+                const double dy = m_y[i] - q[1];
+                const double dz = m_z[i] - q[2];
+                const double d2 = dx * dx + dy * dy + dz * dz;
+                if (int(najlepsze.size()) < k) {
+                    najlepsze.push(qMakePair(d2, i));
+                } else if (d2 < najlepsze.top().first) {
+                    najlepsze.pop();
+                    najlepsze.push(qMakePair(d2, i));
+                }
+            }
+            continue;
+        }
+
+        wezly.push(qMakePair(odlegloscDoPudelka2(m_wezly[w.lewy], q), w.lewy));
+        wezly.push(qMakePair(odlegloscDoPudelka2(m_wezly[w.prawy], q), w.prawy));
+    }
+
+    wynik.resize(int(najlepsze.size()));
+    for (int i = wynik.size() - 1; i >= 0; --i) {
+        const Para p = najlepsze.top();
+        najlepsze.pop();
+        wynik[i] = { m_indeksy[p.second], cieciwaNaKm(p.first) };
+    }
+    return wynik;
+}
+
+/**
+ * @brief Zwraca liczbę punktów w indeksie.
+ * @return Liczba punktów.
+ */
+int IndeksPrzestrzenny::rozmiar() const {
+    return m_indeksy.size();
+}
+
+/**
+ * @brief Sprawdza, czy indeks jest pusty.
+ * @return true jeśli indeks nie zawiera punktów.
+ */
+bool IndeksPrzestrzenny::jestPusty() const {
+    return m_indeksy.isEmpty();
+}
@@ -0,0 +1,124 @@
+/**
+ * @file Indeks_przestrzenny.h
+ * @brief Plik nagłówkowy klasy IndeksPrzestrzenny
+ *
+ * Klasa IndeksPrzestrzenny jest drzewem k-d zbudowanym nad współrzędnymi stacji pomiarowych.
+ * Umożliwia szybkie wyszukiwanie stacji w promieniu oraz k najbliższych stacji od zadanego punktu.
+*/
+
+#ifndef INDEKS_PRZESTRZENNY_H
+#define INDEKS_PRZESTRZENNY_H
+
+#include <QVector>
+
+/**
+ * @class IndeksPrzestrzenny
+ * @brief Drzewo k-d nad punktami na powierzchni Ziemi.
+ *
+ * Punkty (szerokość i długość geograficzna WGS84) są zamieniane na wektory jednostkowe w przestrzeni 3D,
+ * dzięki czemu odległość euklidesowa (cięciwa) jest monotoniczna względem odległości po wielkim okręgu.
+ * Każdy węzeł drzewa przechowuje prostopadłościan ograniczający swoje punkty, co pozwala odrzucać
+ * całe poddrzewa bez liczenia odległości do pojedynczych stacji.
+ * Indeks budowany jest raz, po pobraniu listy stacji, i nie odwołuje się do obiektów JSON.
+ */
+class IndeksPrzestrzenny
+{
+public:
+    /**
+     * @struct Wynik
+     * @brief Pojedynczy wynik zapytania do indeksu.
+     */
+    struct Wynik {
+        int indeks;          /**< Indeks punktu w tablicach przekazanych do zbuduj() */
+        double odlegloscKm;  /**< Odległość od punktu zapytania w kilometrach */
+    };
+
+    /**
+     * @brief Konstruktor domyślny.
+     *
+     * Tworzy pusty indeks.
+     */
+    IndeksPrzestrzenny();
+
+    /**
+     * @brief Buduje indeks od nowa na podstawie współrzędnych punktów.
+     * @param lat Szerokości geograficzne punktów (WGS84, w stopniach).
+     * @param lon Długości geograficzne punktów (WGS84, w stopniach).
+     *
+     * Obie tablice muszą mieć ten sam rozmiar. Indeks i-tego punktu zwracany jest w polu Wynik::indeks.
+     */
+    void zbuduj(const QVector<double>& lat, const QVector<double>& lon);
+
+    /**
+     * @brief Usuwa wszystkie punkty z indeksu.
+     */
+    void wyczysc();
+
+    /**
+     * @brief Wyszukuje punkty w zadanym promieniu.
+     * @param lat Szerokość geograficzna punktu odniesienia.
+     * @param lon Długość geograficzna punktu odniesienia.
+     * @param promienKm Promień w kilometrach.
+     * @return Wyniki posortowane rosnąco według odległości.
+     */
+    QVector<Wynik> wPromieniu(double lat, double lon, double promienKm) const;
+
+    /**
+     * @brief Wyszukuje k najbliższych punktów.
+     * @param lat Szerokość geograficzna punktu odniesienia.
+     * @param lon Długość geograficzna punktu odniesienia.
+     * @param k Maksymalna liczba zwracanych punktów.
+     * @return Wyniki posortowane rosnąco według odległości.
+     */
+    QVector<Wynik> najblizsze(double lat, double lon, int k) const;
+
+    /**
+     * @brief Zwraca liczbę punktów w indeksie.
+     * @return Liczba punktów.
+     */
+    int rozmiar() const;
+
+    /**
+     * @brief Sprawdza, czy indeks jest pusty.
+     * @return true jeśli indeks nie zawiera punktów.
+     */
+    bool jestPusty() const;
+
+private:
+    /**
+     * @struct Wezel
+     * @brief Węzeł drzewa k-d z prostopadłościanem ograniczającym.
+     */
+    struct Wezel {
+        double min[3];   /**< Dolny narożnik prostopadłościanu */
+        double max[3];   /**< Górny narożnik prostopadłościanu */
+        int poczatek;    /**< Pierwszy punkt węzła (w kolejności drzewa) */
+        int koniec;      /**< Punkt za ostatnim punktem węzła */
+        int lewy;        /**< Indeks lewego potomka lub -1 dla liścia */
+        int prawy;       /**< Indeks prawego potomka lub -1 dla liścia */
+    };
+
+    /**
+     * @brief Rekurencyjnie buduje węzeł dla zakresu punktów.
+     * @param poczatek Pierwszy punkt zakresu.
+     * @param koniec Punkt za ostatnim punktem zakresu.
+     * @return Indeks utworzonego węzła.
+     */
+    int zbudujWezel(int poczatek, int koniec);
+
+    /**
+     * @brief Oblicza kwadrat odległości punktu od prostopadłościanu węzła.
+     * @param w Węzeł drzewa.
+     * @param p Punkt w przestrzeni 3D.
+     * @return Kwadrat odległości (0 jeśli punkt leży wewnątrz).
+     */
+    static double odlegloscDoPudelka2(const Wezel& w, const double p[3]);
+
+    QVector<double> m_x;       /**< Współrzędna X punktów (kolejność drzewa) */
+    QVector<double> m_y;       /**< Współrzędna Y punktów (kolejność drzewa) */
+    QVector<double> m_z;       /**< Współrzędna Z punktów (kolejność drzewa) */
+    QVector<int> m_indeksy;    /**< Odwzorowanie kolejności drzewa na indeksy wejściowe */
+    QVector<Wezel> m_wezly;    /**< Węzły drzewa, korzeń pod indeksem 0 */
+};
+
+#endif // INDEKS_PRZESTRZENNY_H
@@ -0,0 +1,297 @@
+/**
+ * @file Kompresja_gorilla.cpp
+ * @brief Plik źródłowy klasy KompresjaGorilla
+ */
+
+#include "Kompresja_gorilla.h"
+
+#include <QtAlgorithms>
+#include <cstring>
+
+namespace {
+/**
+ * @class PisarzBitow
+ * @brief Zapisuje bity do QByteArray (najstarszy bit pierwszy).
+ */
+class PisarzBitow
+{
+public:
+    /**
+     * @brief Zapisuje najmłodsze bity wartości.
+     * @param wartosc Wartość.
+     * @param liczba Liczba bitów (0..64).
+     */
+    void pisz(quint64 wartosc, int liczba) {
+        while (liczba > 0) {
+            const int wolne = 8 - m_zajete;
+            const int n = qMin(wolne, liczba);
+            const uint kawalek = uint(wartosc >> (liczba - n)) & ((1u << n) - 1);
+            m_biezacy |= uchar(kawalek << (wolne - n));
+            m_zajete += n;
+            liczba -= n;
+            if (m_zajete == 8) {
+                m_bufor.append(char(m_biezacy));
+                m_biezacy = 0;
+                m_zajete = 0;
+            }
+        }
+    }
+
+    /**
+     * @brief Zapisuje jeden bit.
+     * @param bit Wartość bitu.
+     */
+    void piszBit(bool bit) {
+        pisz(bit ? 1 : 0, 1);
+    }
+
+    /**
+     * @brief Kończy zapis, uzupełniając ostatni bajt zerami.
+     * @return Zapisany strumień.
+     */
+    QByteArray zakoncz() {
+        if (m_zajete > 0)
+            m_bufor.append(char(m_biezacy));
+        m_biezacy = 0;
+        m_zajete = 0;
+        return m_bufor;
+    }
+
+    /**
+     * @brief Rezerwuje miejsce w buforze.
+     * @param bajty Oczekiwana liczba bajtów.
+     */
+    void zarezerwuj(int bajty) {
+        m_bufor.reserve(bajty);
+    }
+
+private:
+    QByteArray m_bufor;    /**< Zapisane pełne bajty */
+    uchar m_biezacy = 0;   /**< Bieżący, niepełny bajt */
+    int m_zajete = 0;      /**< Liczba zajętych bitów bieżącego bajtu */
+};
+
+/**
+ * @brief Zwraca bity liczby float.
+ */
+quint32 bityFloat(float wartosc) {
+    quint32 bity;
+    std::memcpy(&bity, &wartosc, sizeof(float));
+    return bity;
+}
+}
+
+/**
+ * @brief Koduje próbki widoku.
+ *
+ * @param widok Widok na posortowane próbki.
+ * @param poprzedniaDelta Różnica czasu poprzedzająca pierwszą próbkę.
+ * @return Skompresowany strumień.
+ */
+QByteArray KompresjaGorilla::koduj(const WidokSerii& widok, qint64 poprzedniaDelta) {
+    PisarzBitow pisarz;
+    pisarz.zarezerwuj(4 + widok.rozmiar() * 2);
+
+    const int n = widok.rozmiar();
+    if (n == 0)
+        return pisarz.zakoncz();
+
+    qint64 poprzedniCzas = widok.czas(0);
+
+    quint32 poprzedniaWartosc = 0;
+    int zeraWiodace = 0;
+    int dlugosc = 0;
+
+    for (int i = 0; i < n; ++i) {
+        if (i > 0) {
+            const qint64 delta = widok.czas(i) - poprzedniCzas;
+            const qint64 dod = delta - poprzedniaDelta;
+
+            if (dod == 0) {
+                pisarz.piszBit(false);
+            } else if (dod >= -63 && dod <= 64) {
+                pisarz.pisz(0b10, 2);
+                pisarz.pisz(quint64(dod + 63), 7);
+            } else if (dod >= -255 && dod <= 256) {
+                pisarz.pisz(0b110, 3);
+                pisarz.pisz(quint64(dod + 255), 9);
+            } else if (dod >= -2047 && dod <= 2048) {
+                pisarz.pisz(0b1110, 4);
+                pisarz.pisz(quint64(dod + 2047), 12);
+            } else {
+                pisarz.pisz(0b1111, 4);
+                pisarz.pisz(quint64(dod), 64);
+            }
+
+            poprzedniaDelta = delta;
+            poprzedniCzas = widok.czas(i);
+        }
+
+        const bool brak = widok.jestBrak(i);
+        pisarz.piszBit(brak);
+        if (brak)
+            continue;
+
+        const quint32 bity = bityFloat(widok.wartosc(i));
+        const quint32 x = bity ^ poprzedniaWartosc;
+        poprzedniaWartosc = bity;
+
+        if (x == 0) {
+            pisarz.piszBit(false);
+            continue;
+        }
+
+        const int lz = qCountLeadingZeroBits(x);
+        const int tz = qCountTrailingZeroBits(x);
+
+        if (dlugosc > 0 && lz >= zeraWiodace && tz >= 32 - zeraWiodace - dlugosc) {
+            pisarz.pisz(0b10, 2);
+            pisarz.pisz(x >> (32 - zeraWiodace - dlugosc), dlugosc);
+        } else {
+            zeraWiodace = lz;
+            dlugosc = 32 - lz - tz;
+            pisarz.pisz(0b11, 2);
+            pisarz.pisz(quint64(zeraWiodace), 5);
+            pisarz.pisz(quint64(dlugosc - 1), 5);
+            pisarz.pisz(x >> tz, dlugosc);
+        }
+    }
+
+    return pisarz.zakoncz();
+}
+
+/**
+ * @brief Konstruktor dekodera.
+ *
+ * @param dane Skompresowany strumień.
+ * @param rozmiar Rozmiar strumienia w bajtach.
+ * @param liczbaProbek Liczba próbek w strumieniu.
+ * @param pierwszyCzas Czas pierwszej próbki.
+ * @param poprzedniaDelta Różnica czasu podana przy kodowaniu.
+ */
+KompresjaGorilla::Dekoder::Dekoder(const char* dane, int rozmiar, int liczbaProbek, qint64 pierwszyCzas,
+                                   qint64 poprzedniaDelta) :
+    m_dane(reinterpret_cast<const uchar*>(dane)),
+    m_liczbaBitow(qint64(rozmiar) * 8),
+    m_liczbaProbek(qMax(0, liczbaProbek)),
+    m_czas(pierwszyCzas),
+    m_delta(poprzedniaDelta)
+{}
+
+/**
+ * @brief Zwraca liczbę próbek w strumieniu.
+ * @return Liczba próbek.
+ */
+int KompresjaGorilla::Dekoder::liczbaProbek() const {
+    return m_liczbaProbek;
+}
+
+/**
+ * @brief Sprawdza, czy zdekodowano wszystkie próbki.
+ * @return true jeśli koniec strumienia.
+ */
+bool KompresjaGorilla::Dekoder::koniec() const {
+    return m_blad || m_zdekodowane >= m_liczbaProbek;
+}
+
+/**
+ * @brief Sprawdza, czy strumień był uszkodzony.
+ * @return true jeśli wystąpił błąd.
+ */
+bool KompresjaGorilla::Dekoder::blad() const {
+    return m_blad;
+}
+
+/**
+ * @brief Dekoduje kolejny blok próbek.
+ *
+ * @param maksProbek Maksymalna liczba próbek.
+ * @return Widok na blok (ważny do następnego wywołania).
+ */
+WidokSerii KompresjaGorilla::Dekoder::nastepnyBlok(int maksProbek) {
+    const int n = koniec() ? 0 : qMin(maksProbek, m_liczbaProbek - m_zdekodowane);
+
+    m_blokCzas.resize(n);
+    m_blokWartosci.resize(n);
+    m_blokBraki.resize((n + 63) / 64);
+    m_blokBraki.fill(0);
+
+    int i = 0;
+    for (; i < n; ++i) {
+        if (m_zdekodowane > 0) {
+            qint64 dod = 0;
+            if (czytajBit()) {
+                if (!czytajBit())
+                    dod = qint64(czytajBity(7)) - 63;
+                else if (!czytajBit())
+                    dod = qint64(czytajBity(9)) - 255;
+                else if (!czytajBit())
+                    dod = qint64(czytajBity(12)) - 2047;
+                else
+                    dod = qint64(czytajBity(64));
+            }
+            m_delta += dod;
+            m_czas += m_delta;
+        }
+
+        m_blokCzas[i] = m_czas;
+
+        if (czytajBit()) {
+            m_blokBraki[i >> 6] |= quint64(1) << (i & 63);
+            m_blokWartosci[i] = 0.0f;
+        } else {
+            if (czytajBit()) {
+                if (czytajBit()) {
+                    m_zeraWiodace = int(czytajBity(5));
+                    m_dlugosc = int(czytajBity(5)) + 1;
+                }
+                if (m_dlugosc == 0 || m_zeraWiodace + m_dlugosc > 32) {
+                    m_blad = true;
+                    break;
+                }
+                m_wartosc ^= quint32(czytajBity(m_dlugosc)) << (32 - m_zeraWiodace - m_dlugosc);
+            }
+            std::memcpy(&m_blokWartosci[i], &m_wartosc, sizeof(float));
+        }
+
+        // Uszkodzona próbka nie trafia do bloku.
+        if (m_blad)
+            break;
+        ++m_zdekodowane;
+    }
+
+    return WidokSerii(m_blokCzas.constData(), m_blokWartosci.constData(), m_blokBraki.constData(), 0, i);
+}
+
+/**
+ * @brief Odczytuje bity ze strumienia.
+ *
+ * @param liczba Liczba bitów (0..64).
+ * @return Odczytane bity.
+ */
+quint64 KompresjaGorilla::Dekoder::czytajBity(int liczba) {
+    if (m_pozycja + liczba > m_liczbaBitow) {
+        m_blad = true;
+        m_pozycja = m_liczbaBitow;
+        return 0;
+    }
+
+    quint64 wynik = 0;
+    while (liczba > 0) {
+        const uchar bajt = m_dane[m_pozycja >> 3];
+        const int dostepne = 8 - int(m_pozycja & 7);
+        const int k = qMin(dostepne, liczba);
+        wynik = (wynik << k) | ((bajt >> (dostepne - k)) & ((1u << k) - 1));
+        liczba -= k;
+        m_pozycja += k;
+    }
+    return wynik;
+}
+
+/**
+ * @brief Odczytuje jeden bit.
+ * @return Wartość bitu.
+ */
+bool KompresjaGorilla::Dekoder::czytajBit() {
+    return czytajBity(1) != 0;
+}
@@ -0,0 +1,122 @@
+/**
+ * @file Kompresja_gorilla.h
+ * @brief Plik nagłówkowy klasy KompresjaGorilla
+ *
+ * Klasa KompresjaGorilla kompresuje szeregi czasowe pomiarów metodą znaną z bazy Gorilla:
+ * znaczniki czasu kodowane są jako różnice drugiego rzędu, a wartości jako XOR z poprzednią wartością.
+*/
+
+#ifndef KOMPRESJA_GORILLA_H
+#define KOMPRESJA_GORILLA_H
+
+#include <QByteArray>
+#include <QVector>
+
+#include "Widok_serii.h"
+
+/**
+ * @class KompresjaGorilla
+ * @brief Bitowe kodowanie szeregów czasowych (delta-of-delta + XOR float).
+ *
+ * Strumień nie zawiera liczby próbek ani czasu pierwszej próbki - przechowuje je nagłówek rekordu
+ * (DziennikPomiarow) i są przekazywane do dekodera. Różnica czasu drugiej próbki jest liczona
+ * względem podanej różnicy odniesienia (np. odstępu od ostatniej próbki poprzedniego rekordu),
+ * więc przy regularnym dopisywaniu kosztuje jeden bit.
+ * Dla każdej kolejnej próbki zapisywana jest różnica drugiego rzędu czasu w ms:
+ * "0" dla zera (stały krok, np. dokładnie godzina), a w pozostałych przypadkach prefiks
+ * "10", "110", "1110" lub "1111" i 7, 9, 12 albo 64 bity wartości.
+ * Następnie 1 bit braku wartości i, dla próbek z wartością, XOR bitów float32 z poprzednią wartością:
+ * "0" dla identycznej wartości, "10" i bity znaczące w poprzednim oknie
+ * lub "11", 5 bitów liczby zer wiodących, 5 bitów długości i bity znaczące.
+ * Dla wolno zmiennych serii godzinowych daje to zwykle kilka bitów na próbkę zamiast 13 bajtów.
+ */
+class KompresjaGorilla
+{
+public:
+    /**
+     * @brief Koduje próbki widoku.
+     * @param widok Widok na próbki posortowane rosnąco po czasie.
+     * @param poprzedniaDelta Różnica czasu poprzedzająca pierwszą próbkę (0, jeśli nieznana).
+     * @return Skompresowany strumień bitów (bez liczby próbek i czasu pierwszej próbki).
+     */
+    static QByteArray koduj(const WidokSerii& widok, qint64 poprzedniaDelta = 0);
+
+    /**
+     * @class Dekoder
+     * @brief Strumieniowy dekoder blokowy.
+     *
+     * Dekoduje strumień porcjami i udostępnia każdą porcję jako WidokSerii,
+     * dzięki czemu statystyki i wykres mogą przetwarzać dane bez rozpakowywania całej serii.
+     */
+    class Dekoder
+    {
+    public:
+        /**
+         * @brief Konstruktor dekodera.
+         * @param dane Skompresowany strumień (musi istnieć przez cały czas dekodowania).
+         * @param rozmiar Rozmiar strumienia w bajtach.
+         * @param liczbaProbek Liczba próbek zapisanych w strumieniu.
+         * @param pierwszyCzas Czas pierwszej próbki (ms od epoki).
+         * @param poprzedniaDelta Różnica czasu podana przy kodowaniu.
+         */
+        Dekoder(const char* dane, int rozmiar, int liczbaProbek, qint64 pierwszyCzas, qint64 poprzedniaDelta = 0);
+
+        /**
+         * @brief Zwraca liczbę próbek zapisanych w strumieniu.
+         * @return Liczba próbek.
+         */
+        int liczbaProbek() const;
+
+        /**
+         * @brief Sprawdza, czy zdekodowano już wszystkie próbki.
+         * @return true jeśli nie ma kolejnych bloków.
+         */
+        bool koniec() const;
+
+        /**
+         * @brief Sprawdza, czy strumień okazał się uszkodzony (za krótki).
+         * @return true jeśli wystąpił błąd.
+         */
+        bool blad() const;
+
+        /**
+         * @brief Dekoduje kolejny blok próbek.
+         * @param maksProbek Maksymalna liczba próbek w bloku.
+         * @return Widok na zdekodowany blok, ważny do następnego wywołania.
+         */
+        WidokSerii nastepnyBlok(int maksProbek = 1024);
+
+    private:
+        /**
+         * @brief Odczytuje bity ze strumienia (najstarszy bit pierwszy).
+         * @param liczba Liczba bitów (0..64).
+         * @return Odczytane bity; po końcu strumienia zwracane są zera i ustawiany jest błąd.
+         */
+        quint64 czytajBity(int liczba);
+
+        /**
+         * @brief Odczytuje jeden bit.
+         * @return Wartość bitu.
+         */
+        bool czytajBit();
+
+        const uchar* m_dane;          /**< Strumień */
+        qint64 m_liczbaBitow;         /**< Długość strumienia w bitach */
+        qint64 m_pozycja = 0;         /**< Pozycja odczytu w bitach */
+        bool m_blad = false;          /**< Czy strumień był za krótki */
+
+        int m_liczbaProbek = 0;       /**< Liczba próbek w strumieniu */
+        int m_zdekodowane = 0;        /**< Liczba zdekodowanych próbek */
+        qint64 m_czas = 0;            /**< Czas poprzedniej próbki */
+        qint64 m_delta = 0;           /**< Poprzednia różnica czasu */
+        quint32 m_wartosc = 0;        /**< Bity poprzedniej wartości */
+        int m_zeraWiodace = 0;        /**< Okno XOR: zera wiodące */
+        int m_dlugosc = 0;            /**< Okno XOR: liczba bitów znaczących */
+
+        QVector<qint64> m_blokCzas;       /**< Czas próbek bloku */
+        QVector<float> m_blokWartosci;    /**< Wartości próbek bloku */
+        QVector<quint64> m_blokBraki;     /**< Mapa braków bloku */
+    };
+};
+
+#endif // KOMPRESJA_GORILLA_H
@@ -0,0 +1,354 @@
+/**
+ * @file Magazyn_kolumnowy.cpp
+ * @brief Plik źródłowy klasy MagazynKolumnowy
+ */
+
+#include "Magazyn_kolumnowy.h"
+
+#include <QDebug>
+#include <QSaveFile>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace {
+const char ZNACZNIK[4] = {'G', 'K', 'O', 'L'};
+const quint32 WERSJA = 1;
+const quint32 ZNACZNIK_KOLEJNOSCI = 0x01020304;
+
+/**
+ * @struct Naglowek
+ * @brief Nagłówek pliku magazynu.
+ */
+struct Naglowek {
+    char znacznik[4];            /**< "GKOL" */
+    quint32 wersja;              /**< Wersja formatu */
+    quint32 liczbaStanowisk;     /**< Liczba wpisów katalogu */
+    quint32 kolejnoscBajtow;     /**< ZNACZNIK_KOLEJNOSCI zapisany natywnie */
+    qint64 rozmiarPliku;         /**< Rozmiar pliku w bajtach */
+    qint64 zarezerwowane;        /**< Do przyszłego użycia */
+};
+
+static_assert(sizeof(Naglowek) == 32, "Nieoczekiwany rozmiar nagłówka magazynu");
+
+/**
+ * @brief Zaokrągla położenie w górę do wielokrotności 8 bajtów.
+ */
+qint64 wyrownaj(qint64 polozenie) {
+    return (polozenie + 7) & ~qint64(7);
+}
+}
+
+/**
+ * @brief Konstruktor klasy MagazynKolumnowy.
+ */
+MagazynKolumnowy::MagazynKolumnowy()
+{
+    static_assert(sizeof(WpisKatalogu) == 64, "Nieoczekiwany rozmiar wpisu katalogu magazynu");
+}
+
+/**
+ * @brief Destruktor klasy MagazynKolumnowy.
+ */
+MagazynKolumnowy::~MagazynKolumnowy() {
+    zamknij();
+}
+
+/**
+ * @brief Zapisuje serie stanowisk do pliku magazynu.
+ *
+ * Serie są porządkowane po identyfikatorze i przekazywane kolejno do zapisu strumieniowego (Zapis).
+ *
+ * @param sciezka Ścieżka pliku docelowego.
+ * @param serie Pary (identyfikator stanowiska, seria).
+ * @return true jeśli zapis się powiódł.
+ */
+bool MagazynKolumnowy::zapisz(const QString& sciezka, const QVector<QPair<int, SeriaPomiarowa>>& serie) {
+    QVector<QPair<int, SeriaPomiarowa>> posortowane;
+    posortowane.reserve(serie.size());
+    for (const auto& para : serie) {
+        if (para.second.jestPusta()) continue;
+        SeriaPomiarowa seria = para.second;
+        if (!seria.jestPosortowana()) seria.uporzadkuj();
+        posortowane.append(qMakePair(para.first, seria));
+    }
+    std::sort(posortowane.begin(), posortowane.end(),
+              [](const QPair<int, SeriaPomiarowa>& a, const QPair<int, SeriaPomiarowa>& b) { return a.first < b.first; });
+
+    Zapis zapis(sciezka, posortowane.size());
+    for (const auto& para : posortowane) {
+        zapis.dopisz(para.second.calosc());
+        zapis.zakonczStanowisko(para.first, para.second.parametr());
+    }
+    return zapis.zatwierdz();
+}
+
+/**
+ * @brief Konstruktor klasy MagazynKolumnowy::Zapis.
+ *
+ * Nagłówek i katalog są zapisywane dopiero w zatwierdz(), więc na początku pliku
+ * rezerwowane jest miejsce na katalog o maksLiczbaStanowisk wpisach.
+ *
+ * @param sciezka Ścieżka pliku docelowego.
+ * @param maksLiczbaStanowisk Największa liczba stanowisk.
+ */
+MagazynKolumnowy::Zapis::Zapis(const QString& sciezka, int maksLiczbaStanowisk) :
+    m_plik(sciezka),
+    m_maksLiczbaStanowisk(maksLiczbaStanowisk),
+    m_polozenie(sizeof(Naglowek) + qint64(maksLiczbaStanowisk) * sizeof(WpisKatalogu))
+{
+    m_katalog.reserve(maksLiczbaStanowisk);
+    m_blad = !m_plik.open(QIODevice::WriteOnly) ||
+             m_plik.write(QByteArray(m_polozenie, '\0')) != m_polozenie;
+}
+
+/**
+ * @brief Dopisuje blok próbek bieżącego stanowiska do kolumn w pamięci.
+ * @param blok Posortowane próbki, późniejsze od dopisanych wcześniej.
+ */
+void MagazynKolumnowy::Zapis::dopisz(const WidokSerii& blok) {
+    if (m_blad || blok.rozmiar() == 0)
+        return;
+
+    if (m_przesuniecia.isEmpty())
+        m_bazaMs = blok.pierwszyCzas();
+
+    if ((blok.ostatniCzas() - m_bazaMs) / 1000 > std::numeric_limits<qint32>::max()) {
+        qWarning() << "Seria stanowiska jest zbyt długa dla magazynu";
+        m_blad = true;
+        return;
+    }
+
+    const int n = m_przesuniecia.size();
+    const int razem = n + blok.rozmiar();
+    m_przesuniecia.resize(razem);
+    m_wartosci.resize(razem);
+    m_braki.resize((razem + 63) / 64);
+    for (int i = 0; i < blok.rozmiar(); ++i) {
+        const int j = n + i;
+        m_przesuniecia[j] = static_cast<qint32>((blok.czas(i) - m_bazaMs) / 1000);
+        if (blok.jestBrak(i)) {
+            m_wartosci[j] = 0.0f;
+            m_braki[j >> 6] |= quint64(1) << (j & 63);
+        } else {
+            m_wartosci[j] = blok.wartosc(i);
+        }
+    }
+}
+
+/**
+ * @brief Zapisuje kolumny bieżącego stanowiska z wypełnieniem do granicy 8 bajtów.
+ * @param stanowiskoId Identyfikator stanowiska.
+ * @param parametr Kod parametru.
+ * @return false jeśli zapis się nie powiódł.
+ */
+bool MagazynKolumnowy::Zapis::zakonczStanowisko(int stanowiskoId, const QString& parametr) {
+    const qint64 n = m_przesuniecia.size();
+    if (!m_blad && n > 0) {
+        if (m_katalog.size() >= m_maksLiczbaStanowisk ||
+            (!m_katalog.isEmpty() && m_katalog.last().stanowiskoId >= stanowiskoId)) {
+            qWarning() << "Nieprawidłowa kolejność stanowisk w zapisie magazynu:" << stanowiskoId;
+            m_blad = true;
+        } else {
+            WpisKatalogu w;
+            std::memset(&w, 0, sizeof(WpisKatalogu));
+            w.stanowiskoId = stanowiskoId;
+            w.liczba = static_cast<qint32>(n);
+            w.bazaMs = m_bazaMs;
+            const QByteArray kod = parametr.toUtf8();
+            std::memcpy(w.parametr, kod.constData(), qMin<qsizetype>(kod.size(), sizeof(w.parametr) - 1));
+
+            static const char zera[8] = {};
+            w.przesuniecieCzasu = m_polozenie;
+            w.przesuniecieWartosci = wyrownaj(w.przesuniecieCzasu + n * qint64(sizeof(qint32)));
+            w.przesuniecieBrakow = wyrownaj(w.przesuniecieWartosci + n * qint64(sizeof(float)));
+            m_polozenie = w.przesuniecieBrakow + m_braki.size() * qint64(sizeof(quint64));
+
+            m_plik.write(reinterpret_cast<const char*>(m_przesuniecia.constData()), n * qint64(sizeof(qint32)));
+            m_plik.write(zera, w.przesuniecieWartosci - (w.przesuniecieCzasu + n * qint64(sizeof(qint32))));
+            m_plik.write(reinterpret_cast<const char*>(m_wartosci.constData()), n * qint64(sizeof(float)));
+            m_plik.write(zera, w.przesuniecieBrakow - (w.przesuniecieWartosci + n * qint64(sizeof(float))));
+            m_plik.write(reinterpret_cast<const char*>(m_braki.constData()), m_braki.size() * qint64(sizeof(quint64)));
+            m_katalog.append(w);
+        }
+    }
+
+    m_przesuniecia.clear();
+    m_wartosci.clear();
+    m_braki.clear();
+    return !m_blad;
+}
+
+/**
+ * @brief Zapisuje nagłówek i katalog na początku pliku i zatwierdza plik.
+ *
+ * Niewykorzystana część miejsca zarezerwowanego na katalog pozostaje wypełniona zerami.
+ *
+ * @return true jeśli zapis się powiódł.
+ */
+bool MagazynKolumnowy::Zapis::zatwierdz() {
+    if (m_blad) {
+        m_plik.cancelWriting();
+        return false;
+    }
+
+    Naglowek naglowek;
+    std::memcpy(naglowek.znacznik, ZNACZNIK, 4);
+    naglowek.wersja = WERSJA;
+    naglowek.liczbaStanowisk = static_cast<quint32>(m_katalog.size());
+    naglowek.kolejnoscBajtow = ZNACZNIK_KOLEJNOSCI;
+    naglowek.rozmiarPliku = m_polozenie;
+    naglowek.zarezerwowane = 0;
+
+    m_plik.seek(0);
+    m_plik.write(reinterpret_cast<const char*>(&naglowek), sizeof(Naglowek));
+    m_plik.write(reinterpret_cast<const char*>(m_katalog.constData()), qint64(m_katalog.size()) * sizeof(WpisKatalogu));
+    return m_plik.commit();
+}
+
+/**
+ * @brief Otwiera i mapuje plik magazynu.
+ *
+ * Sprawdzany jest nagłówek oraz to, czy wszystkie bloki katalogu mieszczą się w pliku.
+ *
+ * @param sciezka Ścieżka pliku.
+ * @return true jeśli plik ma poprawny format.
+ */
+bool MagazynKolumnowy::otworz(const QString& sciezka) {
+    zamknij();
+
+    m_plik.setFileName(sciezka);
+    if (!m_plik.open(QIODevice::ReadOnly) || m_plik.size() < qint64(sizeof(Naglowek))) {
+        m_plik.close();
+        return false;
+    }
+
+    const qint64 rozmiar = m_plik.size();
+    uchar* mapa = m_plik.map(0, rozmiar);
+    if (!mapa) {
+        m_plik.close();
+        return false;
+    }
+
+    const Naglowek* naglowek = reinterpret_cast<const Naglowek*>(mapa);
+    bool poprawny = std::memcmp(naglowek->znacznik, ZNACZNIK, 4) == 0 &&
+                    naglowek->wersja == WERSJA &&
+                    naglowek->kolejnoscBajtow == ZNACZNIK_KOLEJNOSCI &&
+                    naglowek->rozmiarPliku == rozmiar &&
+                    qint64(sizeof(Naglowek)) + qint64(naglowek->liczbaStanowisk) * qint64(sizeof(WpisKatalogu)) <= rozmiar;
+
+    const WpisKatalogu* katalog = reinterpret_cast<const WpisKatalogu*>(mapa + sizeof(Naglowek));
+    for (quint32 s = 0; poprawny && s < naglowek->liczbaStanowisk; ++s) {
+        const WpisKatalogu& w = katalog[s];
+        const qint64 n = w.liczba;
+        poprawny = n > 0 &&
+                   w.przesuniecieCzasu % 8 == 0 && w.przesuniecieWartosci % 8 == 0 && w.przesuniecieBrakow % 8 == 0 &&
+                   w.przesuniecieCzasu + n * qint64(sizeof(qint32)) <= rozmiar &&
+                   w.przesuniecieWartosci + n * qint64(sizeof(float)) <= rozmiar &&
+                   w.przesuniecieBrakow + ((n + 63) / 64) * qint64(sizeof(quint64)) <= rozmiar &&
+                   (s == 0 || katalog[s - 1].stanowiskoId < w.stanowiskoId);
+    }
+
+    if (!poprawny) {
+        qWarning() << "Nieprawidłowy plik magazynu kolumnowego:" << sciezka;
+        m_plik.unmap(mapa);
+        m_plik.close();
+        return false;
+    }
+
+    m_mapa = mapa;
+    m_katalog = katalog;
+    m_liczbaStanowisk = static_cast<int>(naglowek->liczbaStanowisk);
+    return true;
+}
+
+/**
+ * @brief Usuwa mapowanie i zamyka plik.
+ */
+void MagazynKolumnowy::zamknij() {
+    if (m_mapa)
+        m_plik.unmap(const_cast<uchar*>(m_mapa));
+    m_plik.close();
+    m_mapa = nullptr;
+    m_katalog = nullptr;
+    m_liczbaStanowisk = 0;
+}
+
+/**
+ * @brief Sprawdza, czy magazyn jest otwarty.
+ * @return true jeśli plik jest zmapowany.
+ */
+bool MagazynKolumnowy::jestOtwarty() const {
+    return m_mapa != nullptr;
+}
+
+/**
+ * @brief Zwraca identyfikatory zapisanych stanowisk.
+ * @return Identyfikatory stanowisk.
+ */
+QVector<int> MagazynKolumnowy::stanowiska() const {
+    QVector<int> wynik;
+    wynik.reserve(m_liczbaStanowisk);
+    for (int s = 0; s < m_liczbaStanowisk; ++s)
+        wynik.append(m_katalog[s].stanowiskoId);
+    return wynik;
+}
+
+/**
+ * @brief Sprawdza, czy magazyn zawiera stanowisko.
+ * @param stanowiskoId Identyfikator stanowiska.
+ * @return true jeśli stanowisko jest w katalogu.
+ */
+bool MagazynKolumnowy::zawiera(int stanowiskoId) const {
+    return wpis(stanowiskoId) != nullptr;
+}
+
+/**
+ * @brief Zwraca kod parametru stanowiska.
+ * @param stanowiskoId Identyfikator stanowiska.
+ * @return Kod parametru.
+ */
+QString MagazynKolumnowy::parametr(int stanowiskoId) const {
+    const WpisKatalogu* w = wpis(stanowiskoId);
+    if (!w) return QString();
+    return QString::fromUtf8(w->parametr, int(qstrnlen(w->parametr, sizeof(w->parametr))));
+}
+
+/**
+ * @brief Zwraca widok na całą serię stanowiska.
+ * @param stanowiskoId Identyfikator stanowiska.
+ * @return Widok na zmapowane kolumny.
+ */
+WidokSerii MagazynKolumnowy::seria(int stanowiskoId) const {
+    const WpisKatalogu* w = wpis(stanowiskoId);
+    if (!w) return WidokSerii();
+
+    return WidokSerii(w->bazaMs,
+                      reinterpret_cast<const qint32*>(m_mapa + w->przesuniecieCzasu),
+                      reinterpret_cast<const float*>(m_mapa + w->przesuniecieWartosci),
+                      reinterpret_cast<const quint64*>(m_mapa + w->przesuniecieBrakow),
+                      0, w->liczba);
+}
+
+/**
+ * @brief Zwraca widok na próbki stanowiska z przedziału czasu.
+ * @param stanowiskoId Identyfikator stanowiska.
+ * @param odMs Początek przedziału.
+ * @param doMs Koniec przedziału.
+ * @return Widok na zmapowane kolumny.
+ */
+WidokSerii MagazynKolumnowy::zakres(int stanowiskoId, qint64 odMs, qint64 doMs) const {
+    return seria(stanowiskoId).zakres(odMs, doMs);
+}
+
+/**
+ * @brief Wyszukuje binarnie wpis katalogu stanowiska.
+ * @param stanowiskoId Identyfikator stanowiska.
+ * @return Wskaźnik na wpis lub nullptr.
+ */
+const MagazynKolumnowy::WpisKatalogu* MagazynKolumnowy::wpis(int stanowiskoId) const {
+    const WpisKatalogu* koniec = m_katalog + m_liczbaStanowisk;
+    const WpisKatalogu* it = std::lower_bound(m_katalog, koniec, stanowiskoId,
+                                              [](const WpisKatalogu& w, int id) { return w.stanowiskoId < id; });
+    return (it != koniec && it->stanowiskoId == stanowiskoId) ? it : nullptr;
+}
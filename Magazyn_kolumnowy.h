@@ -0,0 +1,197 @@
+/**
+ * @file Magazyn_kolumnowy.h
+ * @brief Plik nagłówkowy klasy MagazynKolumnowy
+ *
+ * Klasa MagazynKolumnowy zapisuje historię wielu stanowisk w pliku o układzie kolumnowym
+ * i udostępnia ją przez mapowanie pliku do pamięci, bez wczytywania danych na stertę.
+*/
+
+#ifndef MAGAZYN_KOLUMNOWY_H
+#define MAGAZYN_KOLUMNOWY_H
+
+#include <QFile>
+#include <QPair>
+#include <QSaveFile>
+#include <QString>
+#include <QVector>
+
+#include "Seria_pomiarowa.h"
+#include "Widok_serii.h"
+
+/**
+ * @class MagazynKolumnowy
+ * @brief Zmapowany do pamięci magazyn szeregów czasowych (plik "*.kol").
+ *
+ * Plik składa się z nagłówka, posortowanego katalogu stanowisk i bloków kolumn każdego stanowiska:
+ * przesunięć czasu (int32, sekundy względem czasu pierwszej próbki), wartości (float)
+ * oraz mapy bitowej braków (uint64). Bloki są wyrównane do 8 bajtów, więc widoki (WidokSerii)
+ * wskazują bezpośrednio na zmapowane strony pliku. Dane zapisywane są w natywnym porządku bajtów;
+ * plik z innym porządkiem jest odrzucany przy otwarciu.
+ *
+ * Widoki pozostają ważne do wywołania zamknij() lub zniszczenia obiektu.
+ */
+class MagazynKolumnowy
+{
+public:
+    class Zapis;   // Strumieniowy zapis pliku magazynu
+
+    /**
+     * @brief Konstruktor domyślny; tworzy zamknięty magazyn.
+     */
+    MagazynKolumnowy();
+
+    /**
+     * @brief Destruktor; usuwa mapowanie pliku.
+     */
+    ~MagazynKolumnowy();
+
+    MagazynKolumnowy(const MagazynKolumnowy&) = delete;
+    MagazynKolumnowy& operator=(const MagazynKolumnowy&) = delete;
+
+    /**
+     * @brief Zapisuje serie stanowisk do nowego pliku magazynu.
+     * @param sciezka Ścieżka pliku docelowego.
+     * @param serie Pary (identyfikator stanowiska, posortowana seria).
+     * @return true jeśli zapis się powiódł.
+     *
+     * Plik jest zapisywany atomowo (QSaveFile). Czas próbek jest zaokrąglany do pełnych sekund.
+     * Do zapisu historii bez trzymania wszystkich serii w pamięci służy klasa Zapis.
+     */
+    static bool zapisz(const QString& sciezka, const QVector<QPair<int, SeriaPomiarowa>>& serie);
+
+    /**
+     * @brief Otwiera i mapuje plik magazynu.
+     * @param sciezka Ścieżka pliku.
+     * @return true jeśli plik ma poprawny format.
+     */
+    bool otworz(const QString& sciezka);
+
+    /**
+     * @brief Usuwa mapowanie i zamyka plik.
+     */
+    void zamknij();
+
+    /**
+     * @brief Sprawdza, czy magazyn jest otwarty.
+     * @return true jeśli plik jest zmapowany.
+     */
+    bool jestOtwarty() const;
+
+    /**
+     * @brief Zwraca identyfikatory stanowisk zapisanych w magazynie.
+     * @return Identyfikatory w kolejności rosnącej.
+     */
+    QVector<int> stanowiska() const;
+
+    /**
+     * @brief Sprawdza, czy magazyn zawiera stanowisko.
+     * @param stanowiskoId Identyfikator stanowiska.
+     * @return true jeśli stanowisko ma zapisaną serię.
+     */
+    bool zawiera(int stanowiskoId) const;
+
+    /**
+     * @brief Zwraca kod parametru stanowiska.
+     * @param stanowiskoId Identyfikator stanowiska.
+     * @return Kod parametru lub pusty napis.
+     */
+    QString parametr(int stanowiskoId) const;
+
+    /**
+     * @brief Zwraca widok na całą serię stanowiska.
+     * @param stanowiskoId Identyfikator stanowiska.
+     * @return Widok na zmapowane kolumny (pusty, jeśli stanowiska nie ma).
+     */
+    WidokSerii seria(int stanowiskoId) const;
+
+    /**
+     * @brief Zwraca widok na próbki stanowiska z przedziału czasu.
+     * @param stanowiskoId Identyfikator stanowiska.
+     * @param odMs Początek przedziału (ms od epoki, włącznie).
+     * @param doMs Koniec przedziału (ms od epoki, włącznie).
+     * @return Widok na zmapowane kolumny.
+     */
+    WidokSerii zakres(int stanowiskoId, qint64 odMs, qint64 doMs) const;
+
+private:
+    /**
+     * @struct WpisKatalogu
+     * @brief Opis bloku kolumn jednego stanowiska (układ zgodny z plikiem).
+     */
+    struct WpisKatalogu {
+        qint32 stanowiskoId;         /**< Identyfikator stanowiska */
+        qint32 liczba;               /**< Liczba próbek */
+        qint64 bazaMs;               /**< Czas pierwszej próbki [ms od epoki] */
+        qint64 przesuniecieCzasu;    /**< Położenie kolumny przesunięć czasu */
+        qint64 przesuniecieWartosci; /**< Położenie kolumny wartości */
+        qint64 przesuniecieBrakow;   /**< Położenie mapy bitowej braków */
+        char parametr[24];           /**< Kod parametru (UTF-8, uzupełniony zerami) */
+    };
+
+    /**
+     * @brief Wyszukuje wpis katalogu stanowiska.
+     * @param stanowiskoId Identyfikator stanowiska.
+     * @return Wskaźnik na wpis lub nullptr.
+     */
+    const WpisKatalogu* wpis(int stanowiskoId) const;
+
+    QFile m_plik;                             /**< Plik magazynu */
+    const uchar* m_mapa = nullptr;            /**< Początek zmapowanego pliku */
+    const WpisKatalogu* m_katalog = nullptr;  /**< Katalog stanowisk (w zmapowanym pliku) */
+    int m_liczbaStanowisk = 0;                /**< Liczba wpisów katalogu */
+};
+
+/**
+ * @class MagazynKolumnowy::Zapis
+ * @brief Strumieniowy zapis magazynu, stanowisko po stanowisku.
+ *
+ * Próbki stanowiska są dopisywane blokami (np. prosto z DziennikPomiarow::przegladaj()),
+ * a po zakończeniu stanowiska jego kolumny trafiają do pliku. W pamięci przechowywane są
+ * tylko kolumny bieżącego stanowiska i katalog.
+ */
+class MagazynKolumnowy::Zapis
+{
+public:
+    /**
+     * @brief Konstruktor; otwiera plik i rezerwuje miejsce na nagłówek i katalog.
+     * @param sciezka Ścieżka pliku docelowego.
+     * @param maksLiczbaStanowisk Największa liczba stanowisk, które zostaną zapisane.
+     */
+    Zapis(const QString& sciezka, int maksLiczbaStanowisk);
+
+    Zapis(const Zapis&) = delete;
+    Zapis& operator=(const Zapis&) = delete;
+
+    /**
+     * @brief Dopisuje blok próbek bieżącego stanowiska.
+     * @param blok Próbki późniejsze od wszystkich dopisanych wcześniej, posortowane po czasie.
+     */
+    void dopisz(const WidokSerii& blok);
+
+    /**
+     * @brief Zapisuje kolumny bieżącego stanowiska i rozpoczyna następne.
+     * @param stanowiskoId Identyfikator stanowiska (większy od poprzednich).
+     * @param parametr Kod parametru stanowiska.
+     * @return false jeśli zapis się nie powiódł; stanowisko bez próbek jest pomijane.
+     */
+    bool zakonczStanowisko(int stanowiskoId, const QString& parametr);
+
+    /**
+     * @brief Zapisuje nagłówek i katalog, a następnie atomowo zastępuje plik docelowy.
+     * @return true jeśli cały zapis się powiódł.
+     */
+    bool zatwierdz();
+
+private:
+    QSaveFile m_plik;                   /**< Plik docelowy */
+    QVector<WpisKatalogu> m_katalog;    /**< Katalog zapisanych stanowisk */
+    int m_maksLiczbaStanowisk;          /**< Liczba wpisów zarezerwowanych na katalog */
+    qint64 m_polozenie;                 /**< Położenie końca zapisanych danych */
+    qint64 m_bazaMs = 0;                /**< Czas pierwszej próbki bieżącego stanowiska */
+    QVector<qint32> m_przesuniecia;     /**< Kolumna przesunięć czasu bieżącego stanowiska */
+    QVector<float> m_wartosci;          /**< Kolumna wartości bieżącego stanowiska */
+    QVector<quint64> m_braki;           /**< Mapa braków bieżącego stanowiska */
+    bool m_blad = false;                /**< Czy zapis się nie powiódł */
+};
+
+#endif // MAGAZYN_KOLUMNOWY_H
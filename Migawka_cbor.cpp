@@ -0,0 +1,118 @@
+/**
+ * @file Migawka_cbor.cpp
+ * @brief Plik źródłowy klasy MigawkaCbor
+ */
+
+#include "Migawka_cbor.h"
+
+#include <QCborArray>
+#include <QCborMap>
+#include <QCborStreamReader>
+#include <QCborStreamWriter>
+#include <QCborValue>
+#include <QJsonArray>
+#include <QJsonObject>
+
+namespace {
+const QLatin1String FORMAT("gios-cache");
+const quint64 WERSJA = 1;
+
+/**
+ * @brief Odczytuje napis ze strumienia; element innego typu jest pomijany.
+ */
+QString czytajNapis(QCborStreamReader& czytnik) {
+    if (!czytnik.isString()) {
+        czytnik.next();
+        return QString();
+    }
+    return QCborValue::fromCbor(czytnik).toString();
+}
+}
+
+/**
+ * @brief Zapisuje wpisy do urządzenia.
+ *
+ * Każda odpowiedź jest kodowana bezpośrednio do strumienia, bez budowania dokumentu całej migawki.
+ *
+ * @param urzadzenie Urządzenie docelowe.
+ * @param wpisy Wpisy pamięci podręcznej.
+ * @return true jeśli zapis się powiódł.
+ */
+bool MigawkaCbor::zapisz(QIODevice* urzadzenie, const Wpisy& wpisy) {
+    QCborStreamWriter pisarz(urzadzenie);
+
+    pisarz.append(QCborKnownTags::Signature);
+    pisarz.startMap(3);
+    pisarz.append(QLatin1String("format"));
+    pisarz.append(FORMAT);
+    pisarz.append(QLatin1String("wersja"));
+    pisarz.append(WERSJA);
+
+    pisarz.append(QLatin1String("cache"));
+    pisarz.startMap(wpisy.size());
+    for (const auto& wpis : wpisy) {
+        pisarz.append(wpis.first);
+        if (wpis.second->isArray())
+            QCborArray::fromJsonArray(wpis.second->array()).toCborValue().toCbor(pisarz);
+        else
+            QCborMap::fromJsonObject(wpis.second->object()).toCborValue().toCbor(pisarz);
+    }
+    pisarz.endMap();
+
+    pisarz.endMap();
+    return urzadzenie->isWritable();
+}
+
+/**
+ * @brief Wczytuje wpisy z urządzenia.
+ *
+ * Plik jest czytany strumieniowo: w pamięci znajduje się naraz tylko jedna odpowiedź.
+ * Rozmiar odpowiedzi to liczba bajtów jej kodowania CBOR, więc nie wymaga ponownej serializacji.
+ *
+ * @param urzadzenie Urządzenie źródłowe.
+ * @param dlaWpisu Funkcja wywoływana dla każdego wpisu.
+ * @return true jeśli odczyt się powiódł.
+ */
+bool MigawkaCbor::wczytaj(QIODevice* urzadzenie,
+                         const std::function<void(const QString&, const QJsonDocument&, qint64)>& dlaWpisu) {
+    QCborStreamReader czytnik(urzadzenie);
+
+    if (czytnik.isTag() && czytnik.toTag() == QCborKnownTags::Signature)
+        czytnik.next();
+    if (!czytnik.isMap() || !czytnik.enterContainer())
+        return false;
+
+    // Format musi być pierwszym kluczem, zanim cokolwiek trafi do pamięci podręcznej.
+    if (czytajNapis(czytnik) != QLatin1String("format") || czytajNapis(czytnik) != FORMAT)
+        return false;
+
+    while (czytnik.lastError() == QCborError::NoError && czytnik.hasNext()) {
+        const QString klucz = czytajNapis(czytnik);
+
+        if (klucz == QLatin1String("wersja")) {
+            if (!czytnik.isUnsignedInteger() || czytnik.toUnsignedInteger() > WERSJA)
+                return false;
+            czytnik.next();
+        } else if (klucz == QLatin1String("cache") && czytnik.isMap()) {
+            czytnik.enterContainer();
+            while (czytnik.lastError() == QCborError::NoError && czytnik.hasNext()) {
+                const QString url = czytajNapis(czytnik);
+                const qint64 poczatek = czytnik.currentOffset();
+                const QCborValue wartosc = QCborValue::fromCbor(czytnik);
+                const qint64 rozmiar = czytnik.currentOffset() - poczatek;
+
+                if (wartosc.isMap())
+                    dlaWpisu(url, QJsonDocument(wartosc.toMap().toJsonObject()), rozmiar);
+                else if (wartosc.isArray())
+                    dlaWpisu(url, QJsonDocument(wartosc.toArray().toJsonArray()), rozmiar);
+            }
+            czytnik.leaveContainer();
+        } else {
+            czytnik.next();
+        }
+    }
+
+    if (czytnik.lastError() == QCborError::NoError)
+        czytnik.leaveContainer();
+    return czytnik.lastError() == QCborError::NoError;
+}
@@ -0,0 +1,56 @@
+/**
+ * @file Migawka_cbor.h
+ * @brief Plik nagłówkowy klasy MigawkaCbor
+ *
+ * Klasa MigawkaCbor zapisuje i wczytuje migawkę pamięci podręcznej odpowiedzi API
+ * w binarnym formacie CBOR (RFC 8949), bez budowania całego dokumentu w pamięci.
+*/
+
+#ifndef MIGAWKA_CBOR_H
+#define MIGAWKA_CBOR_H
+
+#include <QIODevice>
+#include <QJsonDocument>
+#include <QPair>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+#include <functional>
+
+/**
+ * @class MigawkaCbor
+ * @brief Strumieniowy zapis i odczyt migawki pamięci podręcznej (plik "*.cbor").
+ *
+ * Plik zaczyna się od znacznika samoopisu CBOR (55799), po którym następuje mapa
+ * {"format": "gios-cache", "wersja": 1, "cache": {adres URL: odpowiedź}}.
+ * Odpowiedzi są zapisywane jako natywne mapy i tablice CBOR, więc przy odczycie nie ma
+ * parsowania tekstu, a liczby nie są zamieniane na napisy i z powrotem.
+ */
+class MigawkaCbor
+{
+public:
+    typedef QVector<QPair<QString, QSharedPointer<const QJsonDocument>>> Wpisy;   /**< Wpisy pamięci podręcznej */
+
+    /**
+     * @brief Zapisuje wpisy do urządzenia.
+     * @param urzadzenie Otwarte do zapisu urządzenie (np. QSaveFile).
+     * @param wpisy Pary (adres URL, odpowiedź).
+     * @return true jeśli zapis się powiódł.
+     */
+    static bool zapisz(QIODevice* urzadzenie, const Wpisy& wpisy);
+
+    /**
+     * @brief Wczytuje wpisy z urządzenia, przekazując je kolejno do funkcji.
+     * @param urzadzenie Otwarte do odczytu urządzenie.
+     * @param dlaWpisu Funkcja wywoływana dla każdego odczytanego wpisu z adresem, odpowiedzią
+     *                 i rozmiarem odpowiedzi w pliku [B] (np. jako koszt w pamięci podręcznej).
+     * @return true jeśli plik ma poprawny format i został odczytany w całości.
+     *
+     * Wpisy odczytane przed wykryciem błędu zostały już przekazane do funkcji.
+     */
+    static bool wczytaj(QIODevice* urzadzenie,
+                        const std::function<void(const QString&, const QJsonDocument&, qint64)>& dlaWpisu);
+};
+
+#endif // MIGAWKA_CBOR_H
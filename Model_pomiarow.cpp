@@ -0,0 +1,123 @@
+/**
+ * @file Model_pomiarow.cpp
+ * @brief Plik źródłowy klasy ModelPomiarow
+ */
+
+#include "Model_pomiarow.h"
+
+#include <QDateTime>
+#include <algorithm>
+
+/**
+ * @brief Konstruktor klasy ModelPomiarow.
+ * @param parent Wskaźnik na rodzica.
+ */
+ModelPomiarow::ModelPomiarow(QObject *parent) :
+    QAbstractListModel(parent),
+    m_aktywny(false)
+{}
+
+/**
+ * @brief Zwraca liczbę wierszy modelu.
+ * @param parent Indeks rodzica.
+ * @return Liczba wierszy.
+ */
+int ModelPomiarow::rowCount(const QModelIndex& parent) const {
+    if (parent.isValid() || !m_aktywny) return 0;
+    return 1 + qMax(1, m_seria.rozmiar());
+}
+
+/**
+ * @brief Zwraca tekst wiersza.
+ *
+ * Tekst próbki jest formatowany przy każdym zapytaniu widoku, więc koszt dotyczy tylko widocznych wierszy.
+ *
+ * @param index Indeks wiersza.
+ * @param role Rola danych.
+ * @return Tekst wiersza lub pusty QVariant.
+ */
+QVariant ModelPomiarow::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || role != Qt::DisplayRole || index.row() >= rowCount())
+        return QVariant();
+
+    if (index.row() == 0)
+        return "Parametr: " + m_seria.parametr();
+
+    if (m_seria.jestPusta())
+        return QString("Brak danych pomiarowych");
+
+    const int i = m_seria.rozmiar() - index.row();
+    const QString data = QDateTime::fromMSecsSinceEpoch(m_seria.czas(i)).toString("yyyy-MM-dd HH:mm:ss");
+    const QString wartosc = m_seria.jestBrak(i) ? "Brak danych" : QString::number(m_seria.wartosc(i));
+    return data + ": " + wartosc;
+}
+
+/**
+ * @brief Ustawia wyświetlaną serię.
+ *
+ * Jeśli nowa seria dotyczy tego samego parametru i zaczyna się od tych samych znaczników czasu co poprzednia,
+ * zgłaszane jest tylko wstawienie nowych (najnowszych) wierszy; w przeciwnym razie model jest resetowany.
+ *
+ * @param seria Seria pomiarowa.
+ */
+void ModelPomiarow::ustawSerie(const SeriaPomiarowa& seria) {
+    const int stare = m_seria.rozmiar();
+    const int nowe = seria.rozmiar();
+
+    const bool przedluzenie = m_aktywny && stare > 0 && nowe > stare &&
+                              seria.parametr() == m_seria.parametr() &&
+                              std::equal(m_seria.daneCzasu(), m_seria.daneCzasu() + stare, seria.daneCzasu());
+
+    if (przedluzenie) {
+        beginInsertRows(QModelIndex(), 1, nowe - stare);
+        m_seria = seria;
+        endInsertRows();
+        emit dataChanged(index(nowe - stare + 1), index(nowe));
+        return;
+    }
+
+    beginResetModel();
+    m_seria = seria;
+    m_aktywny = true;
+    endResetModel();
+}
+
+/**
+ * @brief Dopisuje do modelu nowe próbki serii.
+ *
+ * Najnowsze próbki są wyświetlane na górze, więc nowe wiersze trafiają zaraz pod nagłówek.
+ *
+ * @param nowe Próbki późniejsze od ostatniej wyświetlanej.
+ */
+void ModelPomiarow::dolacz(const SeriaPomiarowa& nowe) {
+    if (!m_aktywny || m_seria.jestPusta()) {
+        ustawSerie(nowe);
+        return;
+    }
+
+    if (nowe.jestPusta())
+        return;
+
+    beginInsertRows(QModelIndex(), 1, nowe.rozmiar());
+    m_seria.dolacz(nowe);
+    endInsertRows();
+}
+
+/**
+ * @brief Zwraca wyświetlaną serię.
+ * @return Seria modelu.
+ */
+const SeriaPomiarowa& ModelPomiarow::seria() const {
+    return m_seria;
+}
+
+/**
+ * @brief Usuwa wszystkie wiersze z modelu.
+ */
+void ModelPomiarow::wyczysc() {
+    if (!m_aktywny) return;
+    beginResetModel();
+    m_seria = SeriaPomiarowa();
+    m_aktywny = false;
+    endResetModel();
+}
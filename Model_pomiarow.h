@@ -0,0 +1,80 @@
+/**
+ * @file Model_pomiarow.h
+ * @brief Plik nagłówkowy klasy ModelPomiarow
+ *
+ * Klasa ModelPomiarow udostępnia widokom Qt (QListView) szereg czasowy pomiarów,
+ * formatując tekst poszczególnych próbek dopiero przy ich wyświetlaniu.
+*/
+
+#ifndef MODEL_POMIAROW_H
+#define MODEL_POMIAROW_H
+
+#include <QAbstractListModel>
+
+#include "Seria_pomiarowa.h"
+
+/**
+ * @class ModelPomiarow
+ * @brief Model listy pomiarów oparty na serii pomiarowej.
+ *
+ * Pierwszy wiersz zawiera kod parametru, kolejne - próbki od najnowszej do najstarszej
+ * w formacie "yyyy-MM-dd HH:mm:ss: wartość". Dla pustej serii wyświetlany jest komunikat o braku danych.
+ * Jeśli nowa seria jest przedłużeniem poprzedniej, model zgłasza tylko wstawienie nowych wierszy.
+ */
+class ModelPomiarow : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Konstruktor klasy ModelPomiarow.
+     * @param parent Wskaźnik na obiekt rodzica (domyślnie nullptr).
+     */
+    explicit ModelPomiarow(QObject *parent = nullptr);
+
+    /**
+     * @brief Zwraca liczbę wierszy modelu.
+     * @param parent Indeks rodzica (model jest płaski).
+     * @return Liczba wierszy (nagłówek + próbki).
+     */
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+
+    /**
+     * @brief Zwraca dane dla wiersza i roli.
+     * @param index Indeks wiersza.
+     * @param role Rola danych (Qt::DisplayRole).
+     * @return Tekst wiersza.
+     */
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    /**
+     * @brief Ustawia wyświetlaną serię.
+     * @param seria Seria pomiarowa.
+     */
+    void ustawSerie(const SeriaPomiarowa& seria);
+
+    /**
+     * @brief Dopisuje do wyświetlanej serii nowe próbki.
+     * @param nowe Próbki późniejsze od ostatniej próbki wyświetlanej serii.
+     *
+     * Próbki są dopisywane do serii modelu w miejscu, a model zgłasza tylko wstawienie wierszy.
+     */
+    void dolacz(const SeriaPomiarowa& nowe);
+
+    /**
+     * @brief Zwraca wyświetlaną serię.
+     * @return Seria (pusta, jeśli model nic nie wyświetla).
+     */
+    const SeriaPomiarowa& seria() const;
+
+    /**
+     * @brief Usuwa wszystkie wiersze z modelu.
+     */
+    void wyczysc();
+
+private:
+    SeriaPomiarowa m_seria;   /**< Wyświetlana seria (jedyna kopia w oknie, powiększana w miejscu) */
+    bool m_aktywny;           /**< Czy model wyświetla jakąkolwiek serię */
+};
+
+#endif // MODEL_POMIAROW_H
@@ -0,0 +1,94 @@
+/**
+ * @file Model_stacji.cpp
+ * @brief Plik źródłowy klasy ModelStacji
+ */
+
+#include "Model_stacji.h"
+
+/**
+ * @brief Konstruktor klasy ModelStacji.
+ * @param rejestr Rejestr stacji.
+ * @param parent Wskaźnik na rodzica.
+ */
+ModelStacji::ModelStacji(const RejestrStacji* rejestr, QObject *parent) :
+    QAbstractListModel(parent),
+    m_rejestr(rejestr)
+{}
+
+/**
+ * @brief Zwraca liczbę wierszy modelu.
+ * @param parent Indeks rodzica.
+ * @return Liczba stacji (0 dla elementów potomnych).
+ */
+int ModelStacji::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : m_wiersze.size();
+}
+
+/**
+ * @brief Zwraca dane wiersza.
+ *
+ * Tekst "nazwa (miasto)" jest tworzony na żądanie, tylko dla wierszy widocznych w widoku.
+ *
+ * @param index Indeks wiersza.
+ * @param role Rola danych.
+ * @return Dane wiersza lub pusty QVariant.
+ */
+QVariant ModelStacji::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= m_wiersze.size())
+        return QVariant();
+
+    const int wiersz = m_wiersze[index.row()];
+    switch (role) {
+    case Qt::DisplayRole:
+        return m_rejestr->nazwa(wiersz) + " (" + m_rejestr->miasto(wiersz) + ")";
+    case Qt::ToolTipRole:
+        return m_rejestr->ulica(wiersz).isEmpty()
+                   ? m_rejestr->miasto(wiersz)
+                   : m_rejestr->miasto(wiersz) + ", " + m_rejestr->ulica(wiersz);
+    case Qt::UserRole:
+        return m_rejestr->id(wiersz);
+    default:
+        return QVariant();
+    }
+}
+
+/**
+ * @brief Ustawia wyświetlane stacje.
+ * @param wiersze Numery wierszy rejestru.
+ */
+void ModelStacji::ustawWiersze(const QVector<int>& wiersze) {
+    beginResetModel();
+    m_wiersze = wiersze;
+    endResetModel();
+}
+
+/**
+ * @brief Usuwa wszystkie stacje z modelu.
+ */
+void ModelStacji::wyczysc() {
+    if (m_wiersze.isEmpty()) return;
+    beginResetModel();
+    m_wiersze.clear();
+    endResetModel();
+}
+
+/**
+ * @brief Zwraca wyświetlane numery wierszy rejestru.
+ * @return Numery wierszy.
+ */
+const QVector<int>& ModelStacji::wiersze() const {
+    return m_wiersze;
+}
+
+/**
+ * @brief Wyszukuje indeks modelu dla identyfikatora stacji.
+ * @param id Identyfikator stacji.
+ * @return Indeks modelu lub nieprawidłowy indeks.
+ */
+QModelIndex ModelStacji::indeksDlaId(int id) const {
+    const int wiersz = m_rejestr->wierszDlaId(id);
+    if (wiersz < 0) return QModelIndex();
+
+    const int pozycja = m_wiersze.indexOf(wiersz);
+    return pozycja < 0 ? QModelIndex() : index(pozycja);
+}
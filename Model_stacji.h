@@ -0,0 +1,81 @@
+/**
+ * @file Model_stacji.h
+ * @brief Plik nagłówkowy klasy ModelStacji
+ *
+ * Klasa ModelStacji udostępnia widokom Qt (QListView) listę stacji z rejestru stacji
+ * bez tworzenia osobnego obiektu dla każdego wiersza.
+*/
+
+#ifndef MODEL_STACJI_H
+#define MODEL_STACJI_H
+
+#include <QAbstractListModel>
+#include <QVector>
+
+#include "Rejestr_stacji.h"
+
+/**
+ * @class ModelStacji
+ * @brief Model listy stacji oparty na rejestrze stacji.
+ *
+ * Model przechowuje jedynie numery wierszy rejestru, a tekst wyświetlany (nazwa i miasto)
+ * jest składany dopiero wtedy, gdy widok poprosi o dany wiersz.
+ * Rola Qt::UserRole zwraca identyfikator stacji.
+ */
+class ModelStacji : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Konstruktor klasy ModelStacji.
+     * @param rejestr Rejestr stacji, z którego odczytywane są dane (musi żyć dłużej niż model).
+     * @param parent Wskaźnik na obiekt rodzica (domyślnie nullptr).
+     */
+    explicit ModelStacji(const RejestrStacji* rejestr, QObject *parent = nullptr);
+
+    /**
+     * @brief Zwraca liczbę wierszy modelu.
+     * @param parent Indeks rodzica (model jest płaski).
+     * @return Liczba wyświetlanych stacji.
+     */
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+
+    /**
+     * @brief Zwraca dane dla wiersza i roli.
+     * @param index Indeks wiersza.
+     * @param role Rola danych (Qt::DisplayRole, Qt::ToolTipRole, Qt::UserRole).
+     * @return Dane wiersza.
+     */
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    /**
+     * @brief Ustawia wyświetlane stacje.
+     * @param wiersze Numery wierszy rejestru stacji.
+     */
+    void ustawWiersze(const QVector<int>& wiersze);
+
+    /**
+     * @brief Usuwa wszystkie stacje z modelu.
+     */
+    void wyczysc();
+
+    /**
+     * @brief Zwraca wyświetlane numery wierszy rejestru.
+     * @return Numery wierszy rejestru stacji.
+     */
+    const QVector<int>& wiersze() const;
+
+    /**
+     * @brief Wyszukuje indeks modelu dla identyfikatora stacji.
+     * @param id Identyfikator stacji.
+     * @return Indeks modelu lub nieprawidłowy indeks, jeśli stacja nie jest wyświetlana.
+     */
+    QModelIndex indeksDlaId(int id) const;
+
+private:
+    const RejestrStacji* m_rejestr;   /**< Rejestr stacji */
+    QVector<int> m_wiersze;           /**< Wyświetlane wiersze rejestru */
+};
+
+#endif // MODEL_STACJI_H
@@ -0,0 +1,289 @@
+/**
+ * @file Odleglosci.cpp
+ * @brief Plik źródłowy klasy Odleglosci
+ */
+
+#include "Odleglosci.h"
+
+#include <QtMath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define ODLEGLOSCI_SSE2
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ODLEGLOSCI_AVX2
+#define ODLEGLOSCI_CEL_AVX2 __attribute__((target("avx2,fma")))
+#endif
+#endif
+
+namespace {
+
+const double PROMIEN_ZIEMI_KM = 6371.0; /**< Średni promień Ziemi */
+
+/*
+ * Przybliżenie arcus sinus na [0, 1] (Abramowitz, Stegun 4.4.46):
+ * asin(h) = pi/2 - sqrt(1 - h) * (A0 + A1 h + ... + A7 h^7), |błąd| <= 2e-8 rad (ok. 0,26 m po pomnożeniu przez 2R).
+ */
+const double A0 = 1.5707963050;
+const double A1 = -0.2145988016;
+const double A2 = 0.0889789874;
+const double A3 = -0.0501743046;
+const double A4 = 0.0308918810;
+const double A5 = -0.0170881256;
+const double A6 = 0.0066700901;
+const double A7 = -0.0012624911;
+
+/**
+ * @brief Zamienia kwadrat cięciwy (na kuli jednostkowej) na odległość w km.
+ */
+inline double cieciwaNaKm(double cieciwa2) {
+    return 2.0 * PROMIEN_ZIEMI_KM * qAsin(qMin(1.0, qSqrt(cieciwa2) * 0.5));
+}
+
+/**
+ * @brief Jak cieciwaNaKm(), z wielomianowym przybliżeniem arcus sinus.
+ */
+inline double cieciwaNaKmPrzyblizona(double cieciwa2) {
+    const double h = qMin(1.0, qSqrt(cieciwa2) * 0.5);
+    const double p = ((((((A7 * h + A6) * h + A5) * h + A4) * h + A3) * h + A2) * h + A1) * h + A0;
+    return 2.0 * PROMIEN_ZIEMI_KM * (M_PI_2 - qSqrt(1.0 - h) * p);
+}
+
+#if defined(ODLEGLOSCI_SSE2)
+/**
+ * @brief Kwadraty cięciw parami (SSE2).
+ * @return Liczba obliczonych elementów (parzysta).
+ */
+int cieciwySse2(const double* x, const double* y, const double* z, int n,
+                double qx, double qy, double qz, double* wynik) {
+    const __m128d vx = _mm_set1_pd(qx);
+    const __m128d vy = _mm_set1_pd(qy);
+    const __m128d vz = _mm_set1_pd(qz);
+    int i = 0;
+    for (; i + 2 <= n; i += 2) {
+        const __m128d dx = _mm_sub_pd(_mm_loadu_pd(x + i), vx);
+        const __m128d dy = _mm_sub_pd(_mm_loadu_pd(y + i), vy);
+        const __m128d dz = _mm_sub_pd(_mm_loadu_pd(z + i), vz);
+        const __m128d c2 = _mm_add_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy)), _mm_mul_pd(dz, dz));
+        _mm_storeu_pd(wynik + i, c2);
+    }
+    return i;
+}
+
+/**
+ * @brief Przybliżone odległości parami (SSE2).
+ * @return Liczba obliczonych elementów (parzysta).
+ */
+int naKmPrzyblizoneSse2(double* c2, int n) {
+    const __m128d jeden = _mm_set1_pd(1.0);
+    const __m128d pol = _mm_set1_pd(0.5);
+    const __m128d piPol = _mm_set1_pd(M_PI_2);
+    const __m128d skala = _mm_set1_pd(2.0 * PROMIEN_ZIEMI_KM);
+    int i = 0;
+    for (; i + 2 <= n; i += 2) {
+        const __m128d h = _mm_min_pd(jeden, _mm_mul_pd(_mm_sqrt_pd(_mm_loadu_pd(c2 + i)), pol));
+        __m128d p = _mm_set1_pd(A7);
+        p = _mm_add_pd(_mm_mul_pd(p, h), _mm_set1_pd(A6));
+        p = _mm_add_pd(_mm_mul_pd(p, h), _mm_set1_pd(A5));
+        p = _mm_add_pd(_mm_mul_pd(p, h), _mm_set1_pd(A4));
+        p = _mm_add_pd(_mm_mul_pd(p, h), _mm_set1_pd(A3));
+        p = _mm_add_pd(_mm_mul_pd(p, h), _mm_set1_pd(A2));
+        p = _mm_add_pd(_mm_mul_pd(p, h), _mm_set1_pd(A1));
+        p = _mm_add_pd(_mm_mul_pd(p, h), _mm_set1_pd(A0));
+        const __m128d kat = _mm_sub_pd(piPol, _mm_mul_pd(_mm_sqrt_pd(_mm_sub_pd(jeden, h)), p));
+        _mm_storeu_pd(c2 + i, _mm_mul_pd(skala, kat));
+    }
+    return i;
+}
+#endif
+
+#if defined(ODLEGLOSCI_AVX2)
+/**
+ * @brief Sprawdza (raz), czy procesor obsługuje AVX2 i FMA.
+ */
+bool procesorAvx2() {
+    static const bool obsluguje = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    return obsluguje;
+}
+
+/**
+ * @brief Kwadraty cięciw po cztery (AVX2, FMA).
+ * @return Liczba obliczonych elementów (wielokrotność 4).
+ */
+ODLEGLOSCI_CEL_AVX2
+int cieciwyAvx2(const double* x, const double* y, const double* z, int n,
+                double qx, double qy, double qz, double* wynik) {
+    const __m256d vx = _mm256_set1_pd(qx);
+    const __m256d vy = _mm256_set1_pd(qy);
+    const __m256d vz = _mm256_set1_pd(qz);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(x + i), vx);
+        const __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(y + i), vy);
+        const __m256d dz = _mm256_sub_pd(_mm256_loadu_pd(z + i), vz);
+        const __m256d c2 = _mm256_fmadd_pd(dz, dz, _mm256_fmadd_pd(dy, dy, _mm256_mul_pd(dx, dx)));
+        _mm256_storeu_pd(wynik + i, c2);
+    }
+    return i;
+}
+
+/**
+ * @brief Przybliżone odległości po cztery (AVX2, FMA; wielomian schematem Hornera na fmadd).
+ * @return Liczba obliczonych elementów (wielokrotność 4).
+ */
+ODLEGLOSCI_CEL_AVX2
+int naKmPrzyblizoneAvx2(double* c2, int n) {
+    const __m256d jeden = _mm256_set1_pd(1.0);
+    const __m256d pol = _mm256_set1_pd(0.5);
+    const __m256d piPol = _mm256_set1_pd(M_PI_2);
+    const __m256d skala = _mm256_set1_pd(2.0 * PROMIEN_ZIEMI_KM);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d h = _mm256_min_pd(jeden, _mm256_mul_pd(_mm256_sqrt_pd(_mm256_loadu_pd(c2 + i)), pol));
+        __m256d p = _mm256_set1_pd(A7);
+        p = _mm256_fmadd_pd(p, h, _mm256_set1_pd(A6));
+        p = _mm256_fmadd_pd(p, h, _mm256_set1_pd(A5));
+        p = _mm256_fmadd_pd(p, h, _mm256_set1_pd(A4));
+        p = _mm256_fmadd_pd(p, h, _mm256_set1_pd(A3));
+        p = _mm256_fmadd_pd(p, h, _mm256_set1_pd(A2));
+        p = _mm256_fmadd_pd(p, h, _mm256_set1_pd(A1));
+        p = _mm256_fmadd_pd(p, h, _mm256_set1_pd(A0));
+        const __m256d kat = _mm256_fnmadd_pd(_mm256_sqrt_pd(_mm256_sub_pd(jeden, h)), p, piPol);
+        _mm256_storeu_pd(c2 + i, _mm256_mul_pd(skala, kat));
+    }
+    return i;
+}
+#endif
+
+/**
+ * @brief Oblicza kwadraty cięciw od wektora q do wszystkich punktów.
+ */
+void cieciwy(const double* x, const double* y, const double* z, int n,
+             double qx, double qy, double qz, double* wynik) {
+    int i = 0;
+#if defined(ODLEGLOSCI_AVX2)
+    if (procesorAvx2())
+        i = cieciwyAvx2(x, y, z, n, qx, qy, qz, wynik);
+#endif
+#if defined(ODLEGLOSCI_SSE2)
+    i += cieciwySse2(x + i, y + i, z + i, n - i, qx, qy, qz, wynik + i);
+#endif
+    for (; i < n; ++i) {
+        const double dx = x[i] - qx;
+        const double dy = y[i] - qy;
+        const double dz = z[i] - qz;
+        wynik[i] = dx * dx + dy * dy + dz * dz;
+    }
+}
+
+/**
+ * @brief Zamienia w miejscu kwadraty cięciw na odległości w km (przybliżony arcus sinus).
+ */
+void naKmPrzyblizone(double* c2, int n) {
+    int i = 0;
+#if defined(ODLEGLOSCI_AVX2)
+    if (procesorAvx2())
+        i = naKmPrzyblizoneAvx2(c2, n);
+#endif
+#if defined(ODLEGLOSCI_SSE2)
+    i += naKmPrzyblizoneSse2(c2 + i, n - i);
+#endif
+    for (; i < n; ++i)
+        c2[i] = cieciwaNaKmPrzyblizona(c2[i]);
+}
+
+/**
+ * @brief Oblicza odległości od wektora jednostkowego q do wszystkich punktów.
+ */
+void odWektora(double qx, double qy, double qz, const Odleglosci::Punkty& punkty,
+               double* wynikKm, bool przyblizone) {
+    const int n = punkty.rozmiar();
+    cieciwy(punkty.x.constData(), punkty.y.constData(), punkty.z.constData(), n, qx, qy, qz, wynikKm);
+
+    if (przyblizone) {
+        naKmPrzyblizone(wynikKm, n);
+    } else {
+        for (int i = 0; i < n; ++i)
+            wynikKm[i] = cieciwaNaKm(wynikKm[i]);
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Przygotowuje punkty do obliczeń wsadowych.
+ *
+ * @param lat Szerokości geograficzne.
+ * @param lon Długości geograficzne.
+ * @return Wektory jednostkowe punktów.
+ */
+Odleglosci::Punkty Odleglosci::przygotuj(const QVector<double>& lat, const QVector<double>& lon) {
+    const int n = qMin(lat.size(), lon.size());
+
+    Punkty punkty;
+    punkty.x.resize(n);
+    punkty.y.resize(n);
+    punkty.z.resize(n);
+    for (int i = 0; i < n; ++i) {
+        const double phi = qDegreesToRadians(lat[i]);
+        const double lambda = qDegreesToRadians(lon[i]);
+        const double cosPhi = qCos(phi);
+        punkty.x[i] = cosPhi * qCos(lambda);
+        punkty.y[i] = cosPhi * qSin(lambda);
+        punkty.z[i] = qSin(phi);
+    }
+    return punkty;
+}
+
+/**
+ * @brief Oblicza odległość wzorem haversine.
+ *
+ * @param lat1 Szerokość geograficzna punktu 1.
+ * @param lon1 Długość geograficzna punktu 1.
+ * @param lat2 Szerokość geograficzna punktu 2.
+ * @param lon2 Długość geograficzna punktu 2.
+ * @return Odległość w kilometrach.
+ */
+double Odleglosci::haversine(double lat1, double lon1, double lat2, double lon2) {
+    const double dLat = qDegreesToRadians(lat2 - lat1);
+    const double dLon = qDegreesToRadians(lon2 - lon1);
+
+    const double a = qSin(dLat / 2) * qSin(dLat / 2) +
+                     qCos(qDegreesToRadians(lat1)) * qCos(qDegreesToRadians(lat2)) *
+                         qSin(dLon / 2) * qSin(dLon / 2);
+
+    return PROMIEN_ZIEMI_KM * 2 * qAtan2(qSqrt(a), qSqrt(1 - a));
+}
+
+/**
+ * @brief Oblicza odległości od punktu do wszystkich przygotowanych punktów.
+ *
+ * @param lat Szerokość geograficzna punktu.
+ * @param lon Długość geograficzna punktu.
+ * @param punkty Przygotowane punkty.
+ * @param wynikKm Tablica wynikowa.
+ * @param przyblizone Czy użyć przybliżenia.
+ */
+void Odleglosci::odPunktu(double lat, double lon, const Punkty& punkty, double* wynikKm, bool przyblizone) {
+    const double phi = qDegreesToRadians(lat);
+    const double lambda = qDegreesToRadians(lon);
+    const double cosPhi = qCos(phi);
+    odWektora(cosPhi * qCos(lambda), cosPhi * qSin(lambda), qSin(phi), punkty, wynikKm, przyblizone);
+}
+
+/**
+ * @brief Oblicza macierz odległości wszystkich par punktów.
+ *
+ * Każdy wiersz to jedno obliczenie wsadowe od punktu i do wszystkich punktów.
+ *
+ * @param punkty Przygotowane punkty.
+ * @param przyblizone Czy użyć przybliżenia.
+ * @return Macierz n x n.
+ */
+QVector<double> Odleglosci::macierz(const Punkty& punkty, bool przyblizone) {
+    const int n = punkty.rozmiar();
+    QVector<double> wynik(qsizetype(n) * n);
+    for (int i = 0; i < n; ++i)
+        odWektora(punkty.x[i], punkty.y[i], punkty.z[i], punkty, wynik.data() + qsizetype(i) * n, przyblizone);
+    return wynik;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file Odleglosci.h
+ * @brief Plik nagłówkowy klasy Odleglosci
+ *
+ * Klasa Odleglosci oblicza odległości po wielkim okręgu: pojedynczo (wzór haversine)
+ * oraz wsadowo, od jednego punktu do wielu punktów zapisanych kolumnowo.
+*/
+
+#ifndef ODLEGLOSCI_H
+#define ODLEGLOSCI_H
+
+#include <QVector>
+
+/**
+ * @class Odleglosci
+ * @brief Obliczenia odległości między punktami na kuli ziemskiej.
+ *
+ * Obliczenia wsadowe korzystają z punktów przygotowanych raz (przygotuj()) jako wektory jednostkowe
+ * w osobnych tablicach x, y, z: trygonometria punktów i punktu zapytania jest liczona tylko raz,
+ * a dla każdej pary zostaje kwadrat cięciwy (mnożenia i dodawania) oraz arcus sinus. Wynik jest
+ * matematycznie równy wzorowi haversine. Pętle wsadowe używają AVX2 z FMA, jeśli procesor je obsługuje
+ * (wybór w czasie działania, GCC i Clang na x86), a w przeciwnym razie SSE2 albo kodu skalarnego.
+ * Wariant przybliżony liczy także arcus sinus wektorowo (wielomian), z błędem nie większym niż 0,3 m.
+ */
+class Odleglosci
+{
+public:
+    /**
+     * @struct Punkty
+     * @brief Punkty przygotowane do obliczeń wsadowych (wektory jednostkowe, układ kolumnowy).
+     */
+    struct Punkty {
+        QVector<double> x;   /**< cos(szerokość) * cos(długość) */
+        QVector<double> y;   /**< cos(szerokość) * sin(długość) */
+        QVector<double> z;   /**< sin(szerokość) */
+
+        /**
+         * @brief Zwraca liczbę punktów.
+         * @return Liczba punktów.
+         */
+        int rozmiar() const { return x.size(); }
+    };
+
+    /**
+     * @brief Przygotowuje punkty do obliczeń wsadowych.
+     * @param lat Szerokości geograficzne w stopniach.
+     * @param lon Długości geograficzne w stopniach.
+     * @return Punkty (liczba = krótsza z tablic).
+     */
+    static Punkty przygotuj(const QVector<double>& lat, const QVector<double>& lon);
+
+    /**
+     * @brief Oblicza odległość między dwoma punktami wzorem haversine.
+     * @param lat1 Szerokość geograficzna punktu 1 (stopnie).
+     * @param lon1 Długość geograficzna punktu 1 (stopnie).
+     * @param lat2 Szerokość geograficzna punktu 2 (stopnie).
+     * @param lon2 Długość geograficzna punktu 2 (stopnie).
+     * @return Odległość w kilometrach.
+     */
+    static double haversine(double lat1, double lon1, double lat2, double lon2);
+
+    /**
+     * @brief Oblicza odległości od punktu do wszystkich przygotowanych punktów.
+     * @param lat Szerokość geograficzna punktu (stopnie).
+     * @param lon Długość geograficzna punktu (stopnie).
+     * @param punkty Przygotowane punkty.
+     * @param wynikKm Tablica na punkty.rozmiar() odległości w kilometrach.
+     * @param przyblizone Czy użyć wektorowego przybliżenia arcus sinus (błąd do 0,3 m).
+     */
+    static void odPunktu(double lat, double lon, const Punkty& punkty, double* wynikKm, bool przyblizone = false);
+
+    /**
+     * @brief Oblicza odległości między wszystkimi parami punktów.
+     * @param punkty Przygotowane punkty.
+     * @param przyblizone Czy użyć wektorowego przybliżenia arcus sinus.
+     * @return Macierz n x n w kolejności wierszy (element [i * n + j] to odległość i-j w km).
+     */
+    static QVector<double> macierz(const Punkty& punkty, bool przyblizone = false);
+};
+
+#endif // ODLEGLOSCI_H
@@ -16,7 +16,9 @@
 #include <QPen>
 #include <QGraphicsSimpleTextItem>
 #include <QScrollBar>
-#include <QtConcurrent>
+
+#include "Decymacja.h"
+#include "Statystyki_strumieniowe.h"
 
 /**
  * @brief Konstruktor klasy MainWindow.
@@ -71,15 +73,24 @@ MainWindow::~MainWindow() {
  */
 void MainWindow::setupUI() {
 
-    listaStacji = new QListWidget(this);
+    modelStacji = new ModelStacji(&apiService->rejestrStacji(), this);
+    modelPomiarow = new ModelPomiarow(this);
+
+    listaStacji = new QListView(this);
+    listaStacji->setUniformItemSizes(true);
+    listaStacji->setModel(modelStacji);
+
     listaStanowisk = new QListWidget(this);
-    listaPomiarow = new QListWidget(this);
+
+    listaPomiarow = new QListView(this);
+    listaPomiarow->setUniformItemSizes(true);
+    listaPomiarow->setModel(modelPomiarow);
 
     przyciskPobierzStacje = new QPushButton("Pobierz wszystkie stacje", this);
     przyciskPokazMape = new QPushButton("Pokaż mapę", this);
     przyciskFiltrujStacje = new QPushButton("Filtruj po mieście", this);
     poleMiasto = new QLineEdit(this);
-    poleMiasto->setPlaceholderText("Wpisz nazwę miasta...");
+    poleMiasto->setPlaceholderText("Wpisz nazwę miasta lub stacji...");
 
     poleLokalizacja = new QLineEdit(this);
     poleLokalizacja->setPlaceholderText("Wpisz lokalizację (np. Polanka 3, Poznań)");
@@ -95,6 +106,24 @@ void MainWindow::setupUI() {
     widokWykresu->setRenderHint(QPainter::Antialiasing);
     widokWykresu->setMinimumHeight(200);
 
+    wykres = new QChart();
+    seriaWykresu = new QLineSeries();
+    wykres->addSeries(seriaWykresu);
+
+    osCzasu = new QDateTimeAxis;
+    osCzasu->setFormat("yyyy-MM-dd HH:mm");
+    osCzasu->setTitleText("Czas");
+    wykres->addAxis(osCzasu, Qt::AlignBottom);
+    seriaWykresu->attachAxis(osCzasu);
+
+    osWartosci = new QValueAxis;
+    osWartosci->setTitleText("Wartość");
+    wykres->addAxis(osWartosci, Qt::AlignLeft);
+    seriaWykresu->attachAxis(osWartosci);
+
+    wykres->legend()->setVisible(false);
+    widokWykresu->setChart(wykres);
+
     widokMapy->setScene(scenaMapy);
     widokMapy->setRenderHint(QPainter::Antialiasing);
     widokMapy->setDragMode(QGraphicsView::ScrollHandDrag);
@@ -240,7 +269,9 @@ void MainWindow::setupConnections() {
             this, &MainWindow::on_pobierzStacje_clicked);
     connect(przyciskFiltrujStacje, &QPushButton::clicked,
             this, &MainWindow::on_filtrujStacje_clicked);
-    connect(listaStacji, &QListWidget::itemClicked,
+    connect(poleMiasto, &QLineEdit::textEdited,
+            this, &MainWindow::on_poleMiasto_edytowane);
+    connect(listaStacji, &QListView::clicked,
             this, &MainWindow::on_stacjaWybrana);
     connect(listaStanowisk, &QListWidget::itemClicked,
             this, &MainWindow::on_stanowiskoWybrana);
@@ -250,6 +281,8 @@ void MainWindow::setupConnections() {
             this, &MainWindow::wyswietlStanowiska);
     connect(apiService, &APIService::danePomiarowePobrane,
             this, &MainWindow::wyswietlPomiary);
+    connect(apiService, &APIService::pomiaryDolaczone,
+            this, &MainWindow::dolaczPomiary);
     connect(apiService, &APIService::indeksJakosciPobrany,
             this, &MainWindow::wyswietlIndeks);
     connect(apiService, &APIService::blad,
@@ -274,11 +307,8 @@ void MainWindow::on_pobierzStacje_clicked() {
     m_filtrMiasto.clear(); 
 
     if (listaStanowisk) listaStanowisk->clear();
-    if (listaPomiarow)  listaPomiarow->clear();
-    if (widokWykresu) {
-        QChart* pustyWykres = new QChart();
-        widokWykresu->setChart(pustyWykres);
-    }
+    modelPomiarow->wyczysc();
+    wyczyscWykres();
 
     apiService->pobierzWszystkieStacje();
 }
@@ -298,23 +328,41 @@ void MainWindow::on_filtrujStacje_clicked() {
     m_filtrMiasto = miasto; 
 
     if (listaStanowisk) listaStanowisk->clear();
-    if (listaPomiarow)  listaPomiarow->clear();
-    if (widokWykresu) {
-        QChart* pustyWykres = new QChart();
-        widokWykresu->setChart(pustyWykres);
-    }
+    modelPomiarow->wyczysc();
+    wyczyscWykres();
 
     apiService->pobierzWszystkieStacje();
 }
 
+/**
+ * @brief Obsługuje edycję pola miasta (wyszukiwanie w trakcie pisania).
+ * @param tekst Bieżący tekst pola.
+ *
+ * Działa dopiero po pobraniu listy stacji; każde naciśnięcie klawisza to zapytanie do indeksu nazw rejestru.
+ * Edycja, która nie zmienia filtra (np. wyczyszczenie pustego pola po wyszukiwaniu w promieniu),
+ * zostawia bieżącą listę stacji.
+ */
+void MainWindow::on_poleMiasto_edytowane(const QString& tekst) {
+    const RejestrStacji& rejestr = apiService->rejestrStacji();
+    if (rejestr.jestPusty())
+        return;
+
+    const QString filtr = tekst.trimmed();
+    if (filtr == m_filtrMiasto)
+        return;
+
+    m_filtrMiasto = filtr;
+    wyswietlStacje(rejestr.wszystkie());
+}
+
 /**
  * @brief Obsługuje kliknięcie elementu z listy stacji.
- * @param item Wybrany element z listy stacji.
+ * @param index Indeks wybranego wiersza modelu stacji.
  *
  * Pobiera stanowiska i indeks jakości powietrza dla wybranej stacji.
  */
-void MainWindow::on_stacjaWybrana(QListWidgetItem* item) {
-    int id = item->data(Qt::UserRole).toInt();
+void MainWindow::on_stacjaWybrana(const QModelIndex& index) {
+    int id = index.data(Qt::UserRole).toInt();
     aktualnaStacjaId = id;
     apiService->pobierzStanowiskaDlaStacji(id);
     apiService->pobierzIndeksJakosciPowietrza(id);
@@ -328,6 +376,7 @@ void MainWindow::on_stacjaWybrana(QListWidgetItem* item) {
  */
 void MainWindow::on_stanowiskoWybrana(QListWidgetItem* item) {
     int id = item->data(Qt::UserRole).toInt();
+    aktualneStanowiskoId = id;
     apiService->pobierzDanePomiarowe(id);
 }
 
@@ -343,7 +392,8 @@ void MainWindow::on_filtrujPomiary_clicked() {
         return;
     }
 
-    if (ostatniePomiary.isEmpty()) {
+    qint64 odMs, doMs;
+    if (!zakresPomiarow(modelPomiarow->seria(), archiwumStanowiska(), &odMs, &doMs)) {
         QListWidgetItem* selectedItem = listaStanowisk->currentItem();
         if (selectedItem) {
             int id = selectedItem->data(Qt::UserRole).toInt();
@@ -355,22 +405,8 @@ void MainWindow::on_filtrujPomiary_clicked() {
     QDateTime wybranaDataPoczatkowa = dataPoczatkowa->dateTime();
     QDateTime wybranaDataKoncowa = dataKoncowa->dateTime();
 
-    QDateTime minDate, maxDate;
-    bool first = true;
-    foreach (const QJsonValue& val, ostatniePomiary) {
-        QJsonObject pomiar = val.toObject();
-        QString data = pomiar["date"].toString();
-        QDateTime dateTime = QDateTime::fromString(data, Qt::ISODate);
-
-        if (first) {
-            minDate = dateTime;
-            maxDate = dateTime;
-            first = false;
-        } else {
-            if (dateTime < minDate) minDate = dateTime;
-            if (dateTime > maxDate) maxDate = dateTime;
-        }
-    }
+    QDateTime minDate = QDateTime::fromMSecsSinceEpoch(odMs);
+    QDateTime maxDate = QDateTime::fromMSecsSinceEpoch(doMs);
 
     if (wybranaDataPoczatkowa < minDate || wybranaDataKoncowa > maxDate) {
         QString komunikat = QString("Wybrany zakres dat jest poza dostępnymi danymi.\n"
@@ -389,44 +425,34 @@ void MainWindow::on_filtrujPomiary_clicked() {
         return;
     }
 
-    wyswietlWykres(ostatniePomiary, ostatniParametrKod);
+    wyswietlWykres(modelPomiarow->seria());
 }
 
 /**
  * @brief Wyświetla listę stacji w interfejsie oraz na mapie.
- * @param stacje Tablica JSON zawierająca dane stacji.
+ * @param wiersze Numery wierszy w rejestrze stacji.
  *
  * Obsługuje także filtrowanie po mieście lub promieniu, w zależności od aktywnego trybu.
+ * Aktywny filtr nazwy zawęża wiersze do trafień indeksu nazw rejestru, w kolejności trafności.
  */
-void MainWindow::wyswietlStacje(const QJsonArray& stacje) {
-    listaStacji->clear();
-    QJsonArray stacjeDoWyswietlenia;
+void MainWindow::wyswietlStacje(const QVector<int>& wiersze) {
+    const RejestrStacji& rejestr = apiService->rejestrStacji();
 
-    foreach (const QJsonValue& val, stacje) {
-        QJsonObject stacja = val.toObject();
-
-        // v1: "Nazwa stacji", stary: "stationName"
-        QString nazwa = stacja["Nazwa stacji"].toString();
-        if (nazwa.isEmpty()) nazwa = stacja["stationName"].toString();
-
-        // v1: "Nazwa miasta" bezpośrednio, stary: city.name
-        QString miasto = stacja["Nazwa miasta"].toString();
-        if (miasto.isEmpty()) miasto = stacja["city"].toObject()["name"].toString();
-
-        // v1: "Identyfikator stacji", stary: "id"
-        int id = stacja["Identyfikator stacji"].toInt();
-        if (id == 0) id = stacja["id"].toInt();
-
-        if (!m_filtrMiasto.isEmpty() &&
-            !miasto.contains(m_filtrMiasto, Qt::CaseInsensitive))
-            continue;
+    QVector<int> stacjeDoWyswietlenia;
+    if (m_filtrMiasto.isEmpty()) {
+        stacjeDoWyswietlenia = wiersze;
+    } else {
+        QVector<bool> przekazane(rejestr.rozmiar(), false);
+        for (int wiersz : wiersze)
+            przekazane[wiersz] = true;
 
-        stacjeDoWyswietlenia.append(stacja);
-        QListWidgetItem *item = new QListWidgetItem(nazwa + " (" + miasto + ")");
-        item->setData(Qt::UserRole, id);
-        listaStacji->addItem(item);
+        for (int wiersz : rejestr.szukaj(m_filtrMiasto)) {
+            if (przekazane[wiersz])
+                stacjeDoWyswietlenia.append(wiersz);
+        }
     }
 
+    modelStacji->ustawWiersze(stacjeDoWyswietlenia);
     rysujMapePolski(stacjeDoWyswietlenia);
 }
 
@@ -444,42 +470,22 @@ void MainWindow::wyswietlStanowiska(const QJsonArray& stanowiska) {
 }
 
 /**
- * @brief Wyświetla listę stanowisk dla wybranej stacji.
- * @param stanowiska Tablica JSON zawierająca dane stanowisk.
+ * @brief Wyświetla listę pomiarów wybranego stanowiska oraz wykres.
+ * @param seria Szereg czasowy pomiarów.
  */
-void MainWindow::wyswietlPomiary(const QJsonArray& pomiary, const QString& parametrKod) {
-    ostatniePomiary = pomiary;
-    ostatniParametrKod = parametrKod;
-
-    listaPomiarow->clear();
-    listaPomiarow->addItem("Parametr: " + parametrKod);
+void MainWindow::wyswietlPomiary(const SeriaPomiarowa& seria) {
+    stanowiskoPomiarow = aktualneStanowiskoId;
+    modelPomiarow->ustawSerie(seria);
 
-    if (pomiary.isEmpty()) {
-        listaPomiarow->addItem("Brak danych pomiarowych");
+    qint64 odMs, doMs;
+    if (!zakresPomiarow(seria, archiwumStanowiska(), &odMs, &doMs)) {
         dataPoczatkowa->setDateTime(QDateTime());
         dataKoncowa->setDateTime(QDateTime());
         return;
     }
 
-    QDateTime minDate, maxDate;
-    bool first = true;
-
-    foreach (const QJsonValue& val, pomiary) {
-        QJsonObject pomiar = val.toObject();
-        QString data = pomiar["date"].toString();
-        QDateTime dateTime = QDateTime::fromString(data, Qt::ISODate);
-        if (!dateTime.isValid())
-            dateTime = QDateTime::fromString(data, "yyyy-MM-dd HH:mm:ss");
-
-        if (first) {
-            minDate = dateTime;
-            maxDate = dateTime;
-            first = false;
-        } else {
-            if (dateTime < minDate) minDate = dateTime;
-            if (dateTime > maxDate) maxDate = dateTime;
-        }
-    }
+    QDateTime minDate = QDateTime::fromMSecsSinceEpoch(odMs);
+    QDateTime maxDate = QDateTime::fromMSecsSinceEpoch(doMs);
 
     if (dataPoczatkowa->dateTime().isNull() || dataKoncowa->dateTime().isNull() ||
         dataPoczatkowa->dateTime() < minDate || dataKoncowa->dateTime() > maxDate) {
@@ -487,14 +493,37 @@ void MainWindow::wyswietlPomiary(const QJsonArray& pomiary, const QString& param
         dataKoncowa->setDateTime(maxDate);
     }
 
-    foreach (const QJsonValue& val, pomiary) {
-        QJsonObject pomiar = val.toObject();
-        QString data = pomiar["date"].toString();
-        QString wartosc = pomiar["value"].isNull() ? "Brak danych" : QString::number(pomiar["value"].toDouble());
-        listaPomiarow->addItem(data + ": " + wartosc);
+    wyswietlWykres(seria);
+}
+
+/**
+ * @brief Dopisuje do widoku nowe próbki wyświetlanego stanowiska.
+ *
+ * Nowe próbki są dopisywane do serii modelu, a lista pomiarów otrzymuje tylko nowe wiersze.
+ * Jeśli zakres dat kończył się na ostatniej próbce, jest przesuwany na nową ostatnią próbkę.
+ * Gdy wyświetlana jest seria innego stanowiska (lub żadna), pokazywana jest cała historia z usługi.
+ *
+ * @param stanowiskoId Identyfikator stanowiska.
+ * @param nowe Próbki dopisane na końcu historii.
+ */
+void MainWindow::dolaczPomiary(int stanowiskoId, const SeriaPomiarowa& nowe) {
+    const SeriaPomiarowa& seria = modelPomiarow->seria();
+    if (stanowiskoId != stanowiskoPomiarow || seria.jestPusta() ||
+        (!nowe.jestPusta() && nowe.czas(0) <= seria.czas(seria.rozmiar() - 1))) {
+        wyswietlPomiary(apiService->historiaStanowiska(stanowiskoId));
+        return;
     }
 
-    wyswietlWykres(pomiary, parametrKod);
+    if (nowe.jestPusta())
+        return;
+
+    const qint64 poprzedniKoniec = seria.czas(seria.rozmiar() - 1);
+    modelPomiarow->dolacz(nowe);
+
+    if (dataKoncowa->dateTime().toMSecsSinceEpoch() >= poprzedniKoniec)
+        dataKoncowa->setDateTime(QDateTime::fromMSecsSinceEpoch(nowe.czas(nowe.rozmiar() - 1)));
+
+    wyswietlWykres(seria);
 }
 
 /**
@@ -522,67 +551,128 @@ void MainWindow::wyswietlBlad(const QString& blad) {
 }
 
 /**
- * @brief Tworzy i wyświetla wykres z danych pomiarowych dla danego parametru.
+ * @brief Wyświetla wykres z danych pomiarowych dla danego parametru.
+ *
+ * Wybrany zakres dat jest decymowany (LTTB) do około szerokości obszaru wykresu w pikselach,
+ * a punkty trafiają do istniejącej serii wykresu (QLineSeries::replace) bez tworzenia nowych obiektów.
+ * Metoda jest wywoływana ponownie przy każdej zmianie zakresu, więc decymacja zawsze dotyczy widocznych danych.
  *
- * @param dane Tablica JSON z pomiarami.
- * @param parametrKod Kod parametru (np. PM10, NO2).
+ * Okres sprzed początku serii jest czytany bezpośrednio ze zmapowanego archiwum historii, jeśli zawiera ono stanowisko.
+ *
+ * @param seria Szereg czasowy pomiarów (kod parametru, np. PM10, NO2, jest częścią serii).
  */
-void MainWindow::wyswietlWykres(const QJsonArray& dane, const QString& parametrKod) {
-    if (dane.isEmpty()) {
+void MainWindow::wyswietlWykres(const SeriaPomiarowa& seria) {
+    const QSharedPointer<const MagazynKolumnowy> archiwum = archiwumStanowiska();
+    const QString parametrKod = (seria.parametr().isEmpty() && archiwum)
+                                    ? archiwum->parametr(aktualneStanowiskoId)
+                                    : seria.parametr();
+    qint64 odMs, doMs;
+    if (!zakresPomiarow(seria, archiwum, &odMs, &doMs)) {
         widokWykresu->setVisible(false);
         return;
     }
 
     widokWykresu->setVisible(true);
 
-    QLineSeries *series = new QLineSeries();
-    series->setName(parametrKod);
-
     QDateTime startDate = dataPoczatkowa->dateTime();
     QDateTime endDate = dataKoncowa->dateTime();
 
-    QVector<QPointF> points;
-    foreach (const QJsonValue& val, dane) {
-        QJsonObject pomiar = val.toObject();
-        if (!pomiar["value"].isNull()) {
-            QString data = pomiar["date"].toString();
-            QDateTime dateTime = QDateTime::fromString(data, Qt::ISODate);
-            if (!dateTime.isValid())
-                dateTime = QDateTime::fromString(data, "yyyy-MM-dd HH:mm:ss");
-            if (dateTime >= startDate && dateTime <= endDate) {
-                double value = pomiar["value"].toDouble();
-                points.append(QPointF(dateTime.toMSecsSinceEpoch(), value));
-            }
+    const WidokSklejony widok = widokPomiarow(seria, archiwum,
+                                              startDate.toMSecsSinceEpoch(), endDate.toMSecsSinceEpoch());
+
+    int szerokosc = int(wykres->plotArea().width());
+    if (szerokosc <= 0) szerokosc = widokWykresu->width();
+    const QVector<QPointF> points = Decymacja::lttb(widok, qMax(szerokosc, 100));
+
+    double minY = 0.0, maxY = 1.0;
+    if (!points.isEmpty()) {
+        minY = maxY = points.first().y();
+        for (const QPointF& p : points) {
+            minY = qMin(minY, p.y());
+            maxY = qMax(maxY, p.y());
         }
+        const double margines = qFuzzyCompare(minY, maxY) ? 1.0 : (maxY - minY) * 0.05;
+        minY -= margines;
+        maxY += margines;
     }
 
-    std::sort(points.begin(), points.end(), [](const QPointF &a, const QPointF &b) {
-        return a.x() < b.x();
-    });
+    seriaWykresu->setName(parametrKod);
+    seriaWykresu->replace(points);
+    osCzasu->setRange(startDate, endDate);
+    osWartosci->setRange(minY, maxY);
 
-    series->append(points);
+    wykres->setTitle("Wykres danych pomiarowych: " + parametrKod +
+                     "\nZakres: " + startDate.toString("yyyy-MM-dd HH:mm") +
+                     " - " + endDate.toString("yyyy-MM-dd HH:mm"));
+    wykres->legend()->setVisible(true);
+}
 
-    QChart *chart = new QChart();
-    chart->addSeries(series);
+/**
+ * @brief Zwraca archiwum historii, jeśli zawiera bieżące stanowisko.
+ *
+ * @return Magazyn kolumnowy lub pusty wskaźnik.
+ */
+QSharedPointer<const MagazynKolumnowy> MainWindow::archiwumStanowiska() const {
+    QSharedPointer<const MagazynKolumnowy> archiwum = apiService->magazynHistorii();
+    if (archiwum && archiwum->zawiera(aktualneStanowiskoId))
+        return archiwum;
+    return QSharedPointer<const MagazynKolumnowy>();
+}
 
-    QDateTimeAxis *axisX = new QDateTimeAxis;
-    axisX->setFormat("yyyy-MM-dd HH:mm");
-    axisX->setTitleText("Czas");
-    axisX->setRange(startDate, endDate);
-    chart->addAxis(axisX, Qt::AlignBottom);
-    series->attachAxis(axisX);
+/**
+ * @brief Wyznacza łączny zakres czasu serii w pamięci i archiwum.
+ *
+ * @param seria Seria bieżącego stanowiska.
+ * @param archiwum Archiwum historii (może być puste).
+ * @param odMs Początek zakresu (wynik).
+ * @param doMs Koniec zakresu (wynik).
+ * @return false jeśli nie ma pomiarów.
+ */
+bool MainWindow::zakresPomiarow(const SeriaPomiarowa& seria, const QSharedPointer<const MagazynKolumnowy>& archiwum,
+                                qint64* odMs, qint64* doMs) const {
+    bool sa = false;
+    if (!seria.jestPusta()) {
+        const WidokSerii calosc = seria.calosc();
+        *odMs = calosc.pierwszyCzas();
+        *doMs = calosc.ostatniCzas();
+        sa = true;
+    }
 
-    QValueAxis *axisY = new QValueAxis;
-    axisY->setTitleText("Wartość");
-    chart->addAxis(axisY, Qt::AlignLeft);
-    series->attachAxis(axisY);
+    const WidokSerii historia = archiwum ? archiwum->seria(aktualneStanowiskoId) : WidokSerii();
+    if (!historia.jestPusty()) {
+        *odMs = sa ? qMin(*odMs, historia.pierwszyCzas()) : historia.pierwszyCzas();
+        *doMs = sa ? qMax(*doMs, historia.ostatniCzas()) : historia.ostatniCzas();
+        sa = true;
+    }
+    return sa;
+}
 
-    chart->setTitle("Wykres danych pomiarowych: " + parametrKod +
-                    "\nZakres: " + startDate.toString("yyyy-MM-dd HH:mm") +
-                    " - " + endDate.toString("yyyy-MM-dd HH:mm"));
-    chart->legend()->setVisible(true);
+/**
+ * @brief Zwraca widok na pomiary z przedziału czasu.
+ *
+ * Okres sprzed pierwszej próbki serii w pamięci jest czytany z archiwum (bez kopiowania),
+ * a pozostała część przedziału z serii, więc przedział obejmujący oba źródła zawiera
+ * także najnowsze próbki.
+ *
+ * @param seria Seria bieżącego stanowiska.
+ * @param archiwum Archiwum historii (może być puste).
+ * @param odMs Początek przedziału.
+ * @param doMs Koniec przedziału.
+ * @return Widok na pomiary.
+ */
+WidokSklejony MainWindow::widokPomiarow(const SeriaPomiarowa& seria, const QSharedPointer<const MagazynKolumnowy>& archiwum,
+                                        qint64 odMs, qint64 doMs) const {
+    const WidokSerii historia = archiwum ? archiwum->seria(aktualneStanowiskoId) : WidokSerii();
+    return WidokSklejony::zakres(historia, seria.calosc(), odMs, doMs);
+}
 
-    widokWykresu->setChart(chart);
+/**
+ * @brief Czyści wykres, zachowując istniejące obiekty wykresu, serii i osi.
+ */
+void MainWindow::wyczyscWykres() {
+    seriaWykresu->clear();
+    wykres->setTitle(QString());
+    wykres->legend()->setVisible(false);
 }
 
 /**
@@ -606,23 +696,21 @@ void MainWindow::on_szukajWPromieniu_clicked() {
 
 
     if (listaStanowisk) listaStanowisk->clear();
-    if (listaPomiarow) listaPomiarow->clear();
-    if (widokWykresu) {
-        QChart* pustyWykres = new QChart();
-        widokWykresu->setChart(pustyWykres);
-    }
+    modelPomiarow->wyczysc();
+    wyczyscWykres();
 
     poleLokalizacja->setFocus();
     poleMiasto->clear();
+    m_filtrMiasto.clear();
     apiService->znajdzStacjeWPromieniu(lokalizacja, promien);
 }
 
 /**
  * @brief Rysuje mapę Polski z naniesionymi stacjami pomiarowymi.
  *
- * @param stacje Tablica JSON zawierająca dane stacji.
+ * @param wiersze Numery wierszy w rejestrze stacji.
  */
-void MainWindow::rysujMapePolski(const QJsonArray& stacje) {
+void MainWindow::rysujMapePolski(const QVector<int>& wiersze) {
     scenaMapy->clear();
 
     QString sciezkaMapy = QCoreApplication::applicationDirPath() + "/kontur/poland.png";
@@ -639,27 +727,11 @@ void MainWindow::rysujMapePolski(const QJsonArray& stacje) {
 
     const double minLat = 49.0, maxLat = 54.9;
     const double minLon = 14.1, maxLon = 24.2;
-    const QString klatN = QString::fromUtf8("WGS84 \xCF\x86 N");
-    const QString klonE = QString::fromUtf8("WGS84 \xCE\xBB E");
-
-    for (const QJsonValue& val : stacje) {
-        QJsonObject stacja = val.toObject();
-
-        double lat = stacja[klatN].toString().toDouble();
-        if (qFuzzyIsNull(lat)) lat = stacja["gegrLat"].toString().toDouble();
-
-        double lon = stacja[klonE].toString().toDouble();
-        if (qFuzzyIsNull(lon)) lon = stacja["gegrLon"].toString().toDouble();
-
-        int id = stacja["Identyfikator stacji"].toInt();
-        if (id == 0) id = stacja["id"].toInt();
+    const RejestrStacji& rejestr = apiService->rejestrStacji();
 
-        QString nazwaStacji = stacja["Nazwa stacji"].toString();
-        if (nazwaStacji.isEmpty()) nazwaStacji = stacja["stationName"].toString();
-
-        QString nazwaKontekstowa = stacja["Nazwa miasta"].toString();
-        if (nazwaKontekstowa.isEmpty())
-            nazwaKontekstowa = stacja["city"].toObject()["name"].toString();
+    for (int wiersz : wiersze) {
+        const double lat = rejestr.latitude(wiersz);
+        const double lon = rejestr.longitude(wiersz);
 
         if (qFuzzyIsNull(lat) || qFuzzyIsNull(lon)) continue;
 
@@ -668,8 +740,8 @@ void MainWindow::rysujMapePolski(const QJsonArray& stacje) {
 
         QGraphicsEllipseItem* kolo = scenaMapy->addEllipse(
             x - 4, y - 4, 8, 8, QPen(Qt::blue), QBrush(Qt::blue));
-        kolo->setToolTip(nazwaStacji + "\n" + nazwaKontekstowa);
-        kolo->setData(Qt::UserRole, id);
+        kolo->setToolTip(rejestr.nazwa(wiersz) + "\n" + rejestr.miasto(wiersz));
+        kolo->setData(Qt::UserRole, rejestr.id(wiersz));
         kolo->setAcceptHoverEvents(true);
         kolo->setFlag(QGraphicsItem::ItemIsSelectable, true);
         kolo->setCursor(Qt::PointingHandCursor);
@@ -711,15 +783,13 @@ bool MainWindow::eventFilter(QObject *obj, QEvent *event) {
             int stacjaId = item->data(Qt::UserRole).toInt();
             qDebug() << "Kliknięto stację o ID:" << stacjaId;
 
-            for (int i = 0; i < listaStacji->count(); ++i) {
-                QListWidgetItem* listItem = listaStacji->item(i);
-                if (listItem->data(Qt::UserRole).toInt() == stacjaId) {
-                    listaStacji->setCurrentItem(listItem);
-                    listaStacji->scrollToItem(listItem);
+            QModelIndex indeks = modelStacji->indeksDlaId(stacjaId);
+            if (indeks.isValid()) {
+                listaStacji->setCurrentIndex(indeks);
+                listaStacji->scrollTo(indeks);
 
-                    on_stacjaWybrana(listItem);
-                    return true;
-                }
+                on_stacjaWybrana(indeks);
+                return true;
             }
         }
     }
@@ -755,103 +825,70 @@ void MainWindow::wheelEvent(QWheelEvent *event) {
 }
 
 /**
- * @brief Oblicza statystyki z ostatnich pomiarów i prezentuje je w widoku.
+ * @brief Prezentuje statystyki wybranego stanowiska w widoku.
  *
- * Statystyki obejmują wartości minimalne, maksymalne, średnie oraz trend czasowy.
+ * Statystyki obejmują wartości minimalne, maksymalne, średnie, odchylenie standardowe, kwantyle,
+ * średnie kroczące oraz trend czasowy. Są odczytywane z silnika APIService (statystykiStanowiska()),
+ * który obejmuje archiwum, dziennik i wszystkie pobrane próbki stanowiska, więc nic nie jest tu przeliczane.
  */
 void MainWindow::obliczStatystyki() {
-    if (ostatniePomiary.isEmpty()) {
-        QMessageBox::warning(this, "Błąd", "Brak danych do obliczenia statystyk");
+    const QSharedPointer<const MagazynKolumnowy> archiwum = archiwumStanowiska();
+    const QString parametr = modelPomiarow->seria().parametr().isEmpty() && archiwum
+                                 ? archiwum->parametr(aktualneStanowiskoId)
+                                 : modelPomiarow->seria().parametr();
+
+    const StatystykiStrumieniowe obliczone = apiService->statystykiStanowiska(aktualneStanowiskoId);
+    if (obliczone.jestPusta()) {
+        statystykiLabel->setText(QString("<h3>Statystyki dla parametru: %1</h3>brak danych").arg(parametr));
         return;
     }
 
-    QJsonArray kopiaPomiary = ostatniePomiary;
-    QString parametr = ostatniParametrKod;
-
-    QtConcurrent::run([=]() {
-        double minWartosc = std::numeric_limits<double>::max();
-        double maxWartosc = std::numeric_limits<double>::lowest();
-        QDateTime minData, maxData;
-        double suma = 0;
-        int liczbaPomiarow = 0;
-        QList<QPair<QDateTime, double>> danePomiarowe;
-
-        for (const QJsonValue& val : kopiaPomiary) {
-            QJsonObject pomiar = val.toObject();
-            if (pomiar["value"].isNull()) continue;
-
-            double wartosc = pomiar["value"].toDouble();
-            QDateTime data = QDateTime::fromString(pomiar["date"].toString(), Qt::ISODate);
-
-            if (wartosc < minWartosc) {
-                minWartosc = wartosc;
-                minData = data;
-            }
-            if (wartosc > maxWartosc) {
-                maxWartosc = wartosc;
-                maxData = data;
-            }
-
-            suma += wartosc;
-            liczbaPomiarow++;
-            danePomiarowe.append(qMakePair(data, wartosc));
-        }
-
-        double srednia = liczbaPomiarow > 0 ? suma / liczbaPomiarow : 0;
-
-        double trend = 0;
-        QString opisTrendu = "stabilny";
-        double sumX = 0, sumY = 0, sumXY = 0, sumX2 = 0;
-        int n = 0;
-
-        if (!danePomiarowe.isEmpty()) {
-            QDateTime startTime = danePomiarowe.first().first;
-            qint64 startEpoch = startTime.toMSecsSinceEpoch();
-
-            for (const auto& pair : danePomiarowe) {
-                double x = (pair.first.toMSecsSinceEpoch() - startEpoch) / 3600000.0;
-                double y = pair.second;
-                sumX += x;
-                sumY += y;
-                sumXY += x * y;
-                sumX2 += x * x;
-                n++;
-            }
-        }
-
-        if (n > 0) {
-            double numerator = n * sumXY - sumX * sumY;
-            double denominator = n * sumX2 - sumX * sumX;
-            if (denominator != 0) {
-                trend = numerator / denominator;
-                if (trend > 0.0001) opisTrendu = "wzrostowy";
-                else if (trend < -0.0001) opisTrendu = "spadkowy";
-            }
-        }
-
-        QString wynik = QString(
-                            "<h3>Statystyki dla parametru: %1</h3>"
-                            "<b>Minimalna wartość:</b> %2 (%3)<br>"
-                            "<b>Maksymalna wartość:</b> %4 (%5)<br>"
-                            "<b>Średnia wartość:</b> %6<br>"
-                            "<b>Trend:</b> %7 (współczynnik: %8)<br>"
-                            "<b>Liczba pomiarów:</b> %9"
-                            ).arg(
-                                parametr,
-                                QString::number(minWartosc, 'f', 2),
-                                minData.toString("yyyy-MM-dd HH:mm"),
-                                QString::number(maxWartosc, 'f', 2),
-                                maxData.toString("yyyy-MM-dd HH:mm"),
-                                QString::number(srednia, 'f', 2),
-                                opisTrendu,
-                                QString::number(trend, 'e', 2),
-                                QString::number(liczbaPomiarow)
-                                );
-
-        QMetaObject::invokeMethod(qApp, [=]() {
-            statystykiLabel->setText(wynik);
-        }, Qt::QueuedConnection);
-    });
+    const double trend = obliczone.trend();
+    QString opisTrendu = "stabilny";
+    if (trend > 0.0001) opisTrendu = "wzrostowy";
+    else if (trend < -0.0001) opisTrendu = "spadkowy";
+
+    auto liczba = [](double wartosc) { return QString::number(wartosc, 'f', 2); };
+    auto kroczaca = [&](StatystykiStrumieniowe::Okno okno) {
+        return QString("%1 (%2 pom.)").arg(liczba(obliczone.sredniaKroczaca(okno)),
+                                            QString::number(obliczone.liczbaWOknie(okno)));
+    };
+
+    QString wynik = QString(
+                        "<h3>Statystyki dla parametru: %1</h3>"
+                        "<b>Minimalna wartość:</b> %2 (%3)<br>"
+                        "<b>Maksymalna wartość:</b> %4 (%5)<br>"
+                        "<b>Średnia wartość:</b> %6<br>"
+                        "<b>Odchylenie standardowe:</b> %7<br>"
+                        "<b>Trend:</b> %8 (współczynnik: %9)<br>"
+                        ).arg(
+                            parametr,
+                            liczba(obliczone.min()),
+                            QDateTime::fromMSecsSinceEpoch(obliczone.czasMin()).toString("yyyy-MM-dd HH:mm"),
+                            liczba(obliczone.max()),
+                            QDateTime::fromMSecsSinceEpoch(obliczone.czasMax()).toString("yyyy-MM-dd HH:mm"),
+                            liczba(obliczone.srednia()),
+                            liczba(obliczone.odchylenie()),
+                            opisTrendu,
+                            QString::number(trend, 'e', 2)
+                            );
+    wynik += QString(
+                 "<b>Mediana / P90 / P98:</b> %1 / %2 / %3<br>"
+                 "<b>Średnia 1 h:</b> %4<br>"
+                 "<b>Średnia 8 h:</b> %5<br>"
+                 "<b>Średnia 24 h:</b> %6<br>"
+                 "<b>Liczba pomiarów:</b> %7"
+                 ).arg(
+                     liczba(obliczone.kwantyl(StatystykiStrumieniowe::Mediana)),
+                     liczba(obliczone.kwantyl(StatystykiStrumieniowe::P90)),
+                     liczba(obliczone.kwantyl(StatystykiStrumieniowe::P98)),
+                     kroczaca(StatystykiStrumieniowe::Okno1h),
+                     kroczaca(StatystykiStrumieniowe::Okno8h),
+                     kroczaca(StatystykiStrumieniowe::Okno24h),
+                     QString::number(obliczone.liczba())
+                     );
+
+    statystykiLabel->setText(wynik);
 }
 
 
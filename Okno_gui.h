@@ -11,6 +11,7 @@
 
 #include <QMainWindow>
 #include <QListWidget>
+#include <QListView>
 #include <QPushButton>
 #include <QComboBox>
 #include <QLineEdit>
@@ -21,6 +22,9 @@
 #include <QGraphicsEllipseItem>
 
 #include "API_pobieranie.h"
+#include "Model_stacji.h"
+#include "Model_pomiarow.h"
+#include "Widok_sklejony.h"
 
 /**
  * @class MainWindow
@@ -56,6 +60,12 @@ private slots:
      */
     void on_filtrujStacje_clicked();
 
+    /**
+     * @brief Zawęża listę stacji przy każdej zmianie tekstu w polu miasta.
+     * @param tekst Bieżący tekst pola.
+     */
+    void on_poleMiasto_edytowane(const QString& tekst);
+
     /**
      * @brief Obsługuje kliknięcie przycisku "Szukaj w promieniu".
      */
@@ -63,9 +73,9 @@ private slots:
 
     /**
      * @brief Obsługuje wybór stacji z listy.
-     * @param item Wybrany element listy.
+     * @param index Indeks wybranego wiersza modelu stacji.
      */
-    void on_stacjaWybrana(QListWidgetItem* item);
+    void on_stacjaWybrana(const QModelIndex& index);
 
     /**
      * @brief Obsługuje wybór stanowiska z listy.
@@ -84,10 +94,10 @@ private slots:
     void on_filtrujPomiary_clicked();
 
     /**
-     * @brief Wyświetla listę stacji na podstawie danych JSON.
-     * @param stacje Dane stacji w formacie JSON.
+     * @brief Wyświetla listę stacji z rejestru stacji.
+     * @param wiersze Numery wierszy w rejestrze stacji.
      */
-    void wyswietlStacje(const QJsonArray& stacje);
+    void wyswietlStacje(const QVector<int>& wiersze);
 
     /**
      * @brief Wyświetla listę stanowisk.
@@ -97,10 +107,17 @@ private slots:
 
     /**
      * @brief Wyświetla pomiary dla wybranego parametru.
-     * @param pomiary Dane pomiarowe w formacie JSON.
-     * @param parametrKod Kod parametru pomiarowego.
+     * @param seria Szereg czasowy pomiarów wraz z kodem parametru.
+     */
+    void wyswietlPomiary(const SeriaPomiarowa& seria);
+
+    /**
+     * @brief Dopisuje do widoku nowe próbki wyświetlanego stanowiska.
+     * @param stanowiskoId Identyfikator stanowiska.
+     * @param seria Pełna historia stanowiska po scaleniu.
+     * @param dopisane Liczba próbek dopisanych na końcu serii.
      */
-    void wyswietlPomiary(const QJsonArray& pomiary, const QString& parametrKod);
+    void dolaczPomiary(int stanowiskoId, const SeriaPomiarowa& nowe);
 
     /**
      * @brief Wyświetla indeks jakości powietrza.
@@ -129,16 +146,48 @@ private:
 
     /**
      * @brief Wyświetla wykres na podstawie danych pomiarowych.
-     * @param dane Dane pomiarowe.
-     * @param parametrKod Kod parametru.
+     * @param seria Szereg czasowy pomiarów wraz z kodem parametru.
+     */
+    void wyswietlWykres(const SeriaPomiarowa& seria);
+
+    /**
+     * @brief Zwraca archiwum historii, jeśli zawiera bieżące stanowisko.
+     * @return Magazyn kolumnowy lub pusty wskaźnik.
+     */
+    QSharedPointer<const MagazynKolumnowy> archiwumStanowiska() const;
+
+    /**
+     * @brief Wyznacza zakres czasu dostępnych pomiarów (seria w pamięci i archiwum).
+     * @param seria Seria pobrana dla bieżącego stanowiska.
+     * @param archiwum Archiwum historii bieżącego stanowiska (może być puste).
+     * @param odMs Wskaźnik na początek zakresu (wynik).
+     * @param doMs Wskaźnik na koniec zakresu (wynik).
+     * @return false jeśli nie ma żadnych pomiarów.
+     */
+    bool zakresPomiarow(const SeriaPomiarowa& seria, const QSharedPointer<const MagazynKolumnowy>& archiwum,
+                        qint64* odMs, qint64* doMs) const;
+
+    /**
+     * @brief Zwraca widok na pomiary z przedziału czasu.
+     * @param seria Seria pobrana dla bieżącego stanowiska.
+     * @param archiwum Archiwum historii bieżącego stanowiska (może być puste).
+     * @param odMs Początek przedziału.
+     * @param doMs Koniec przedziału.
+     * @return Widok na zmapowane archiwum (okres sprzed początku serii) sklejone z serią w pamięci.
+     */
+    WidokSklejony widokPomiarow(const SeriaPomiarowa& seria, const QSharedPointer<const MagazynKolumnowy>& archiwum,
+                             qint64 odMs, qint64 doMs) const;
+
+    /**
+     * @brief Czyści wykres bez tworzenia nowych obiektów.
      */
-    void wyswietlWykres(const QJsonArray& dane, const QString& parametrKod);
+    void wyczyscWykres();
 
     /**
      * @brief Rysuje mapę Polski z naniesionymi stacjami.
-     * @param stacje Dane stacji w formacie JSON.
+     * @param wiersze Numery wierszy w rejestrze stacji.
      */
-    void rysujMapePolski(const QJsonArray& stacje);
+    void rysujMapePolski(const QVector<int>& wiersze);
 
     /**
      * @brief Obsługuje zdarzenia filtrowania.
@@ -151,19 +200,25 @@ private:
     void wheelEvent(QWheelEvent *event) override;
 
     /**
-     * @brief Oblicza statystyki na podstawie pomiarów.
+     * @brief Wyświetla statystyki wybranego stanowiska (APIService::statystykiStanowiska).
      */
     void obliczStatystyki();
 
-    QListWidget *listaStacji;           /**< Lista dostępnych stacji pomiarowych */
+    QListView *listaStacji;             /**< Lista dostępnych stacji pomiarowych */
     QListWidget *listaStanowisk;        /**< Lista stanowisk pomiarowych */
-    QListWidget *listaPomiarow;         /**< Lista wyników pomiarów */
+    QListView *listaPomiarow;           /**< Lista wyników pomiarów */
+    ModelStacji *modelStacji;           /**< Model listy stacji (wiersze rejestru stacji) */
+    ModelPomiarow *modelPomiarow;       /**< Model listy pomiarów (ostatnia seria) */
     QPushButton *przyciskPobierzStacje; /**< Przycisk do pobrania stacji */
     QPushButton *przyciskFiltrujStacje; /**< Przycisk do filtrowania stacji */
     QPushButton *przyciskZapisz;        /**< Przycisk do zapisu danych */
     QPushButton *przyciskWczytaj;       /**< Przycisk do wczytania danych */
     QLineEdit *poleMiasto;              /**< Pole do wpisania nazwy miasta */
     QChartView *widokWykresu;           /**< Widok wykresu danych pomiarowych */
+    QChart *wykres;                     /**< Wykres współdzielony przez kolejne odświeżenia */
+    QLineSeries *seriaWykresu;          /**< Seria wykresu (punkty po decymacji) */
+    QDateTimeAxis *osCzasu;             /**< Oś czasu wykresu */
+    QValueAxis *osWartosci;             /**< Oś wartości wykresu */
     QSplitter *splitter;                /**< Główny rozdzielacz interfejsu */
     QSplitter *verticalSplitter;        /**< Dodatkowy pionowy rozdzielacz */
 
@@ -179,6 +234,7 @@ private:
 
     APIService *apiService;             /**< Wskaźnik do klasy obsługującej API */
     int aktualnaStacjaId;               /**< ID aktualnie wybranej stacji */
+    int aktualneStanowiskoId = -1;      /**< ID aktualnie wybranego stanowiska */
 
     bool mapaWidoczna;                  /**< Flaga widoczności mapy */
 
@@ -193,8 +249,7 @@ private:
     QDateTimeEdit *dataKoncowa;         /**< Pole wyboru daty końcowej */
     QPushButton *przyciskFiltrujPomiary;/**< Przycisk do filtrowania pomiarów według daty */
 
-    QJsonArray ostatniePomiary;         /**< Ostatnio pobrane dane pomiarowe */
-    QString ostatniParametrKod;         /**< Ostatnio używany kod parametru */
+    int stanowiskoPomiarow = -1;        /**< Stanowisko, którego serię wyświetla modelPomiarow */
 
     QWidget *statystykiWidget;          /**< Widżet do wyświetlania statystyk */
     QLabel *statystykiLabel;            /**< Etykieta ze statystykami */
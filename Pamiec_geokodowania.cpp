@@ -0,0 +1,138 @@
+/**
+ * @file Pamiec_geokodowania.cpp
+ * @brief Plik źródłowy klasy PamiecGeokodowania
+ */
+
+#include "Pamiec_geokodowania.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QStringList>
+
+namespace {
+/// Wpisy starsze niż 180 dni są geokodowane ponownie (adresy zmieniają się rzadko, ale się zmieniają).
+const qint64 CZAS_ZYCIA_MS = 180LL * 24 * 60 * 60 * 1000;
+/// Limit pamięci LRU w bajtach (kilka tysięcy adresów).
+const qint64 LIMIT_LRU = 512 * 1024;
+
+/**
+ * @brief Przybliżony koszt wpisu LRU w bajtach.
+ */
+qint64 koszt(const QString& klucz) {
+    return klucz.size() * qint64(sizeof(QChar)) + qint64(sizeof(QGeoCoordinate));
+}
+}
+
+/**
+ * @brief Konstruktor klasy PamiecGeokodowania.
+ * @param katalog Katalog na pliki wpisów.
+ */
+PamiecGeokodowania::PamiecGeokodowania(const QString& katalog) :
+    m_katalog(katalog),
+    m_lru(LIMIT_LRU)
+{
+    QDir().mkpath(m_katalog);
+}
+
+/**
+ * @brief Normalizuje adres.
+ *
+ * @param adres Adres.
+ * @return Adres z ujednoliconą wielkością liter i odstępami (części rozdzielone ", ").
+ */
+QString PamiecGeokodowania::normalizuj(const QString& adres) {
+    QStringList czesci = adres.toCaseFolded().split(',', Qt::SkipEmptyParts);
+    for (QString& czesc : czesci)
+        czesc = czesc.simplified();
+    czesci.removeAll(QString());
+    return czesci.join(", ");
+}
+
+/**
+ * @brief Wyszukuje współrzędne adresu w pamięci LRU, a następnie na dysku.
+ *
+ * @param adres Adres.
+ * @return Współrzędne lub niepoprawne współrzędne.
+ */
+QGeoCoordinate PamiecGeokodowania::znajdz(const QString& adres) {
+    const QString klucz = normalizuj(adres);
+    if (klucz.isEmpty())
+        return QGeoCoordinate();
+
+    if (QSharedPointer<const QGeoCoordinate> wpis = m_lru.znajdz(klucz))
+        return *wpis;
+
+    QFile plik(sciezkaWpisu(klucz));
+    if (!plik.open(QIODevice::ReadOnly))
+        return QGeoCoordinate();
+
+    const QJsonObject obj = QJsonDocument::fromJson(plik.readAll()).object();
+
+    // Kolizja skrótu, uszkodzony lub przestarzały plik - traktujemy jak brak wpisu.
+    if (obj["adres"].toString() != klucz)
+        return QGeoCoordinate();
+    if (QDateTime::currentMSecsSinceEpoch() - static_cast<qint64>(obj["zapisano"].toDouble()) > CZAS_ZYCIA_MS)
+        return QGeoCoordinate();
+
+    const QGeoCoordinate wspolrzedne(obj["lat"].toDouble(), obj["lon"].toDouble());
+    if (!wspolrzedne.isValid())
+        return QGeoCoordinate();
+
+    m_lru.wstaw(klucz, QSharedPointer<const QGeoCoordinate>::create(wspolrzedne), koszt(klucz));
+    return wspolrzedne;
+}
+
+/**
+ * @brief Zapamiętuje współrzędne adresu.
+ *
+ * @param adres Adres.
+ * @param wspolrzedne Współrzędne.
+ * @return true jeśli plik wpisu został zapisany.
+ */
+bool PamiecGeokodowania::zapisz(const QString& adres, const QGeoCoordinate& wspolrzedne) {
+    const QString klucz = normalizuj(adres);
+    if (klucz.isEmpty() || !wspolrzedne.isValid())
+        return false;
+
+    m_lru.wstaw(klucz, QSharedPointer<const QGeoCoordinate>::create(wspolrzedne), koszt(klucz));
+
+    QJsonObject obj;
+    obj["adres"] = klucz;
+    obj["lat"] = wspolrzedne.latitude();
+    obj["lon"] = wspolrzedne.longitude();
+    obj["zapisano"] = static_cast<double>(QDateTime::currentMSecsSinceEpoch());
+
+    QSaveFile plik(sciezkaWpisu(klucz));
+    if (!plik.open(QIODevice::WriteOnly))
+        return false;
+
+    plik.write(QJsonDocument(obj).toJson(QJsonDocument::Compact));
+    return plik.commit();
+}
+
+/**
+ * @brief Usuwa wszystkie wpisy.
+ */
+void PamiecGeokodowania::wyczysc() {
+    m_lru.wyczysc();
+
+    QDir katalog(m_katalog);
+    for (const QString& nazwa : katalog.entryList({"*.geo"}, QDir::Files))
+        katalog.remove(nazwa);
+}
+
+/**
+ * @brief Zwraca ścieżkę pliku wpisu.
+ *
+ * @param klucz Znormalizowany adres.
+ * @return Ścieżka pliku.
+ */
+QString PamiecGeokodowania::sciezkaWpisu(const QString& klucz) const {
+    const QByteArray skrot = QCryptographicHash::hash(klucz.toUtf8(), QCryptographicHash::Sha1).toHex();
+    return m_katalog + "/" + QString::fromLatin1(skrot) + ".geo";
+}
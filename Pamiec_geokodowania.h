@@ -0,0 +1,74 @@
+/**
+ * @file Pamiec_geokodowania.h
+ * @brief Plik nagłówkowy klasy PamiecGeokodowania
+ *
+ * Klasa PamiecGeokodowania zapamiętuje współrzędne wyznaczone dla adresów, w pamięci (LRU)
+ * i na dysku, aby ponowne wyszukiwanie tego samego miejsca nie wymagało geokodowania.
+*/
+
+#ifndef PAMIEC_GEOKODOWANIA_H
+#define PAMIEC_GEOKODOWANIA_H
+
+#include <QGeoCoordinate>
+#include <QString>
+
+#include "Pamiec_wspolbiezna.h"
+
+/**
+ * @class PamiecGeokodowania
+ * @brief Pamięć podręczna wyników geokodowania (adres -> współrzędne).
+ *
+ * Adresy są normalizowane (wielkość liter, nadmiarowe spacje, spacje wokół przecinków),
+ * więc "Polanka 3,  Poznań" i "polanka 3, POZNAŃ" dają ten sam wpis.
+ * Każdy wpis dyskowy to jeden plik w katalogu pamięci, nazwany skrótem SHA-1 adresu;
+ * odczytany wpis trafia do pamięci LRU. Zapamiętywane są tylko udane geokodowania.
+ */
+class PamiecGeokodowania
+{
+public:
+    /**
+     * @brief Konstruktor klasy PamiecGeokodowania.
+     * @param katalog Katalog na pliki wpisów (tworzony w razie potrzeby).
+     */
+    explicit PamiecGeokodowania(const QString& katalog);
+
+    /**
+     * @brief Sprowadza adres do postaci używanej jako klucz.
+     * @param adres Adres wpisany przez użytkownika.
+     * @return Znormalizowany adres.
+     */
+    static QString normalizuj(const QString& adres);
+
+    /**
+     * @brief Wyszukuje współrzędne adresu.
+     * @param adres Adres (nie musi być znormalizowany).
+     * @return Współrzędne lub niepoprawne współrzędne, jeśli adresu nie ma lub wpis jest przestarzały.
+     */
+    QGeoCoordinate znajdz(const QString& adres);
+
+    /**
+     * @brief Zapamiętuje współrzędne adresu w pamięci i na dysku.
+     * @param adres Adres (nie musi być znormalizowany).
+     * @param wspolrzedne Poprawne współrzędne.
+     * @return true jeśli wpis został zapisany na dysku.
+     */
+    bool zapisz(const QString& adres, const QGeoCoordinate& wspolrzedne);
+
+    /**
+     * @brief Usuwa wszystkie wpisy z pamięci i z dysku.
+     */
+    void wyczysc();
+
+private:
+    /**
+     * @brief Zwraca ścieżkę pliku wpisu.
+     * @param klucz Znormalizowany adres.
+     * @return Ścieżka pliku w katalogu pamięci.
+     */
+    QString sciezkaWpisu(const QString& klucz) const;
+
+    QString m_katalog;                                     /**< Katalog z plikami wpisów */
+    PamiecWspolbiezna<QString, QGeoCoordinate, 1> m_lru;  /**< Ostatnio używane wpisy */
+};
+
+#endif // PAMIEC_GEOKODOWANIA_H
@@ -0,0 +1,153 @@
+/**
+ * @file Pamiec_odpowiedzi.cpp
+ * @brief Plik źródłowy klasy PamiecOdpowiedzi
+ */
+
+#include "Pamiec_odpowiedzi.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+namespace {
+const qint64 GODZINA_MS = 60LL * 60 * 1000;
+const qint64 DZIEN_MS = 24 * GODZINA_MS;
+}
+
+/**
+ * @brief Konstruktor klasy PamiecOdpowiedzi.
+ * @param katalog Katalog na pliki pamięci.
+ */
+PamiecOdpowiedzi::PamiecOdpowiedzi(const QString& katalog) :
+    m_katalog(katalog)
+{
+    QDir().mkpath(m_katalog);
+}
+
+/**
+ * @brief Zwraca czas ważności odpowiedzi dla endpointa.
+ * @param url Adres żądania.
+ * @return Czas ważności w ms (0 - nie zapisywać).
+ */
+qint64 PamiecOdpowiedzi::czasZycia(const QUrl& url) {
+    const QString sciezka = url.path();
+
+    if (sciezka.contains("station/findAll") || sciezka.contains("station/sensors"))
+        return 3 * DZIEN_MS;
+    if (sciezka.contains("data/getData") || sciezka.contains("aqindex/getIndex"))
+        return GODZINA_MS;
+
+    return 0;
+}
+
+/**
+ * @brief Odczytuje wpis dla adresu.
+ * @param url Adres żądania.
+ * @param wpis Struktura wynikowa.
+ * @return true jeśli wpis został odczytany.
+ */
+bool PamiecOdpowiedzi::znajdz(const QUrl& url, Wpis* wpis) const {
+    QFile plik(sciezkaWpisu(url));
+    if (!plik.open(QIODevice::ReadOnly))
+        return false;
+
+    const QByteArray naglowek = plik.readLine();
+    const QJsonObject obj = QJsonDocument::fromJson(naglowek).object();
+
+    // Kolizja skrótu lub uszkodzony plik - traktujemy jak brak wpisu.
+    if (obj["url"].toString() != url.toString())
+        return false;
+
+    wpis->etag = obj["etag"].toString().toUtf8();
+    wpis->ostatniaZmiana = obj["lastModified"].toString().toUtf8();
+    wpis->zapisano = static_cast<qint64>(obj["zapisano"].toDouble());
+    wpis->waznyDo = static_cast<qint64>(obj["waznyDo"].toDouble());
+    wpis->tresc = plik.readAll();
+    return true;
+}
+
+/**
+ * @brief Zapisuje odpowiedź dla adresu.
+ * @param url Adres żądania.
+ * @param tresc Treść odpowiedzi.
+ * @param etag Nagłówek ETag.
+ * @param ostatniaZmiana Nagłówek Last-Modified.
+ * @return true jeśli zapis się powiódł.
+ */
+bool PamiecOdpowiedzi::zapisz(const QUrl& url, const QByteArray& tresc,
+                              const QByteArray& etag, const QByteArray& ostatniaZmiana) {
+    const qint64 ttl = czasZycia(url);
+    if (ttl <= 0)
+        return false;
+
+    Wpis wpis;
+    wpis.tresc = tresc;
+    wpis.etag = etag;
+    wpis.ostatniaZmiana = ostatniaZmiana;
+    wpis.zapisano = QDateTime::currentMSecsSinceEpoch();
+    wpis.waznyDo = wpis.zapisano + ttl;
+    return zapiszWpis(url, wpis);
+}
+
+/**
+ * @brief Przedłuża ważność wpisu po odpowiedzi 304.
+ * @param url Adres żądania.
+ * @param wpis Wpis odczytany wcześniej.
+ * @return true jeśli zapis się powiódł.
+ */
+bool PamiecOdpowiedzi::odswiez(const QUrl& url, const Wpis& wpis) {
+    Wpis nowy = wpis;
+    nowy.zapisano = QDateTime::currentMSecsSinceEpoch();
+    nowy.waznyDo = nowy.zapisano + czasZycia(url);
+    return zapiszWpis(url, nowy);
+}
+
+/**
+ * @brief Usuwa wszystkie wpisy z pamięci.
+ */
+void PamiecOdpowiedzi::wyczysc() {
+    QDir katalog(m_katalog);
+    for (const QString& nazwa : katalog.entryList({"*.odp"}, QDir::Files))
+        katalog.remove(nazwa);
+}
+
+/**
+ * @brief Zwraca ścieżkę pliku wpisu.
+ * @param url Adres żądania.
+ * @return Ścieżka pliku.
+ */
+QString PamiecOdpowiedzi::sciezkaWpisu(const QUrl& url) const {
+    const QByteArray skrot = QCryptographicHash::hash(url.toString().toUtf8(), QCryptographicHash::Sha1).toHex();
+    return m_katalog + "/" + QString::fromLatin1(skrot) + ".odp";
+}
+
+/**
+ * @brief Zapisuje wpis do pliku.
+ *
+ * Nagłówek jest zapisywany jako jedna linia zwartego JSON, po niej następuje treść odpowiedzi.
+ *
+ * @param url Adres żądania.
+ * @param wpis Wpis do zapisania.
+ * @return true jeśli zapis się powiódł.
+ */
+bool PamiecOdpowiedzi::zapiszWpis(const QUrl& url, const Wpis& wpis) {
+    QJsonObject obj;
+    obj["url"] = url.toString();
+    obj["etag"] = QString::fromUtf8(wpis.etag);
+    obj["lastModified"] = QString::fromUtf8(wpis.ostatniaZmiana);
+    obj["zapisano"] = static_cast<double>(wpis.zapisano);
+    obj["waznyDo"] = static_cast<double>(wpis.waznyDo);
+
+    QSaveFile plik(sciezkaWpisu(url));
+    if (!plik.open(QIODevice::WriteOnly))
+        return false;
+
+    plik.write(QJsonDocument(obj).toJson(QJsonDocument::Compact));
+    plik.write("\n");
+    plik.write(wpis.tresc);
+    return plik.commit();
+}
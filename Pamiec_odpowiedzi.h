@@ -0,0 +1,122 @@
+/**
+ * @file Pamiec_odpowiedzi.h
+ * @brief Plik nagłówkowy klasy PamiecOdpowiedzi
+ *
+ * Klasa PamiecOdpowiedzi przechowuje odpowiedzi HTTP na dysku, z czasem ważności zależnym od endpointa
+ * oraz nagłówkami potrzebnymi do warunkowej rewalidacji (ETag, Last-Modified).
+*/
+
+#ifndef PAMIEC_ODPOWIEDZI_H
+#define PAMIEC_ODPOWIEDZI_H
+
+#include <QByteArray>
+#include <QString>
+#include <QUrl>
+
+/**
+ * @class PamiecOdpowiedzi
+ * @brief Dyskowa pamięć podręczna odpowiedzi API.
+ *
+ * Każdy wpis to jeden plik w katalogu pamięci, nazwany skrótem SHA-1 adresu URL.
+ * Pierwsza linia pliku zawiera nagłówek JSON (adres, ETag, Last-Modified, czas zapisu i ważności),
+ * a pozostała część - niezmienioną treść odpowiedzi. Pliki są zapisywane atomowo (QSaveFile).
+ */
+class PamiecOdpowiedzi
+{
+    friend class APIServiceTest; ///< Klasa testowa postarza wpisy, aby wymusić rewalidację
+
+public:
+    /**
+     * @struct Wpis
+     * @brief Odpowiedź odczytana z pamięci podręcznej.
+     */
+    struct Wpis {
+        QByteArray tresc;           /**< Treść odpowiedzi */
+        QByteArray etag;            /**< Nagłówek ETag (może być pusty) */
+        QByteArray ostatniaZmiana;  /**< Nagłówek Last-Modified (może być pusty) */
+        qint64 zapisano = 0;        /**< Czas zapisu [ms od epoki, UTC] */
+        qint64 waznyDo = 0;         /**< Koniec ważności [ms od epoki, UTC] */
+
+        /**
+         * @brief Sprawdza, czy wpis jest jeszcze ważny.
+         * @param teraz Bieżący czas [ms od epoki, UTC].
+         * @return true jeśli wpis można zwrócić bez pytania serwera.
+         */
+        bool jestSwiezy(qint64 teraz) const { return teraz < waznyDo; }
+
+        /**
+         * @brief Sprawdza, czy wpis można zrewalidować zapytaniem warunkowym.
+         * @return true jeśli znany jest ETag lub Last-Modified.
+         */
+        bool moznaRewalidowac() const { return !etag.isEmpty() || !ostatniaZmiana.isEmpty(); }
+    };
+
+    /**
+     * @brief Konstruktor klasy PamiecOdpowiedzi.
+     * @param katalog Katalog na pliki pamięci (tworzony w razie potrzeby).
+     */
+    explicit PamiecOdpowiedzi(const QString& katalog);
+
+    /**
+     * @brief Zwraca czas ważności odpowiedzi dla danego endpointa.
+     * @param url Adres żądania.
+     * @return Czas ważności w ms; 0 oznacza, że odpowiedź nie jest zapisywana.
+     *
+     * Metadane stacji i stanowisk zmieniają się rzadko (kilka dni), dane pomiarowe i indeks - co godzinę.
+     */
+    static qint64 czasZycia(const QUrl& url);
+
+    /**
+     * @brief Odczytuje wpis dla adresu.
+     * @param url Adres żądania.
+     * @param wpis Wskaźnik na strukturę wynikową.
+     * @return true jeśli wpis istnieje i został poprawnie odczytany (również gdy jest nieaktualny).
+     */
+    bool znajdz(const QUrl& url, Wpis* wpis) const;
+
+    /**
+     * @brief Zapisuje odpowiedź dla adresu.
+     * @param url Adres żądania.
+     * @param tresc Treść odpowiedzi.
+     * @param etag Nagłówek ETag odpowiedzi.
+     * @param ostatniaZmiana Nagłówek Last-Modified odpowiedzi.
+     * @return true jeśli zapis się powiódł.
+     *
+     * Odpowiedzi endpointów z zerowym czasem ważności nie są zapisywane.
+     */
+    bool zapisz(const QUrl& url, const QByteArray& tresc,
+                const QByteArray& etag, const QByteArray& ostatniaZmiana);
+
+    /**
+     * @brief Przedłuża ważność wpisu po odpowiedzi 304 Not Modified.
+     * @param url Adres żądania.
+     * @param wpis Wpis odczytany wcześniej (jego treść jest zapisywana ponownie).
+     * @return true jeśli zapis się powiódł.
+     */
+    bool odswiez(const QUrl& url, const Wpis& wpis);
+
+    /**
+     * @brief Usuwa wszystkie wpisy z pamięci.
+     */
+    void wyczysc();
+
+private:
+    /**
+     * @brief Zwraca ścieżkę pliku wpisu dla adresu.
+     * @param url Adres żądania.
+     * @return Ścieżka pliku w katalogu pamięci.
+     */
+    QString sciezkaWpisu(const QUrl& url) const;
+
+    /**
+     * @brief Zapisuje wpis do pliku.
+     * @param url Adres żądania.
+     * @param wpis Wpis do zapisania.
+     * @return true jeśli zapis się powiódł.
+     */
+    bool zapiszWpis(const QUrl& url, const Wpis& wpis);
+
+    QString m_katalog;   /**< Katalog z plikami wpisów */
+};
+
+#endif // PAMIEC_ODPOWIEDZI_H
@@ -0,0 +1,199 @@
+/**
+ * @file Pamiec_wspolbiezna.h
+ * @brief Plik nagłówkowy szablonu klasy PamiecWspolbiezna
+ *
+ * Szablon PamiecWspolbiezna to bezpieczna wątkowo pamięć podręczna LRU z kosztem liczonym w bajtach.
+ * Klucze są rozdzielane na segmenty, z których każdy ma własną blokadę, więc wątki
+ * korzystające z różnych kluczy rzadko na siebie czekają.
+*/
+
+#ifndef PAMIEC_WSPOLBIEZNA_H
+#define PAMIEC_WSPOLBIEZNA_H
+
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPair>
+#include <QSharedPointer>
+#include <QVector>
+
+#include <list>
+
+/**
+ * @class PamiecWspolbiezna
+ * @brief Segmentowana pamięć podręczna LRU dla zdekodowanych danych.
+ *
+ * Wartości są przechowywane jako QSharedPointer<const V>, więc wątek, który odczytał wpis,
+ * może z niego korzystać także po jego usunięciu z pamięci. Limit bajtów jest dzielony
+ * równo między segmenty; po przekroczeniu limitu segmentu usuwane są najdawniej używane wpisy.
+ *
+ * @tparam K Typ klucza (wymaga qHash i operatora ==).
+ * @tparam V Typ przechowywanej wartości.
+ * @tparam LiczbaSegmentow Liczba niezależnie blokowanych segmentów.
+ */
+template <typename K, typename V, int LiczbaSegmentow = 8>
+class PamiecWspolbiezna
+{
+public:
+    typedef QSharedPointer<const V> Wskaznik;   /**< Współdzielony wskaźnik na wartość */
+
+    /**
+     * @brief Konstruktor.
+     * @param maksBajtow Łączny limit kosztu wpisów w bajtach.
+     */
+    explicit PamiecWspolbiezna(qint64 maksBajtow) :
+        m_maksSegmentu(qMax<qint64>(1, maksBajtow / LiczbaSegmentow))
+    {}
+
+    /**
+     * @brief Wstawia lub zastępuje wpis.
+     * @param klucz Klucz wpisu.
+     * @param wartosc Wartość.
+     * @param koszt Przybliżony rozmiar wartości w bajtach.
+     * @return false jeśli wpis jest większy niż limit segmentu i nie został zapisany.
+     */
+    bool wstaw(const K& klucz, const Wskaznik& wartosc, qint64 koszt) {
+        Segment& s = segment(klucz);
+        QMutexLocker blokada(&s.mutex);
+
+        s.usun(klucz);
+        if (koszt > m_maksSegmentu)
+            return false;
+
+        s.kolejnosc.push_front(klucz);
+        s.elementy.insert(klucz, Element{wartosc, koszt, s.kolejnosc.begin()});
+        s.zajete += koszt;
+
+        while (s.zajete > m_maksSegmentu) {
+            const K najstarszy = s.kolejnosc.back();
+            s.usun(najstarszy);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Wyszukuje wpis i oznacza go jako ostatnio używany.
+     * @param klucz Klucz wpisu.
+     * @return Wartość lub pusty wskaźnik, jeśli wpisu nie ma.
+     */
+    Wskaznik znajdz(const K& klucz) const {
+        Segment& s = segment(klucz);
+        QMutexLocker blokada(&s.mutex);
+
+        auto it = s.elementy.find(klucz);
+        if (it == s.elementy.end())
+            return Wskaznik();
+
+        s.kolejnosc.splice(s.kolejnosc.begin(), s.kolejnosc, it->pozycja);
+        return it->wartosc;
+    }
+
+    /**
+     * @brief Sprawdza, czy wpis istnieje (bez zmiany kolejności LRU).
+     * @param klucz Klucz wpisu.
+     * @return true jeśli wpis istnieje.
+     */
+    bool zawiera(const K& klucz) const {
+        Segment& s = segment(klucz);
+        QMutexLocker blokada(&s.mutex);
+        return s.elementy.contains(klucz);
+    }
+
+    /**
+     * @brief Usuwa wpis.
+     * @param klucz Klucz wpisu.
+     */
+    void usun(const K& klucz) {
+        Segment& s = segment(klucz);
+        QMutexLocker blokada(&s.mutex);
+        s.usun(klucz);
+    }
+
+    /**
+     * @brief Usuwa wszystkie wpisy.
+     */
+    void wyczysc() {
+        for (Segment& s : m_segmenty) {
+            QMutexLocker blokada(&s.mutex);
+            s.elementy.clear();
+            s.kolejnosc.clear();
+            s.zajete = 0;
+        }
+    }
+
+    /**
+     * @brief Zwraca kopię wszystkich wpisów (np. do zapisu na dysk).
+     * @return Pary klucz-wartość; każdy segment jest kopiowany pod własną blokadą.
+     */
+    QVector<QPair<K, Wskaznik>> migawka() const {
+        QVector<QPair<K, Wskaznik>> wynik;
+        for (Segment& s : m_segmenty) {
+            QMutexLocker blokada(&s.mutex);
+            for (auto it = s.elementy.cbegin(); it != s.elementy.cend(); ++it)
+                wynik.append(qMakePair(it.key(), it->wartosc));
+        }
+        return wynik;
+    }
+
+    /**
+     * @brief Zwraca łączny koszt wpisów.
+     * @return Suma kosztów w bajtach.
+     */
+    qint64 zajeteBajty() const {
+        qint64 suma = 0;
+        for (Segment& s : m_segmenty) {
+            QMutexLocker blokada(&s.mutex);
+            suma += s.zajete;
+        }
+        return suma;
+    }
+
+private:
+    /**
+     * @struct Element
+     * @brief Wpis segmentu wraz z pozycją na liście LRU.
+     */
+    struct Element {
+        Wskaznik wartosc;                              /**< Wartość */
+        qint64 koszt;                                  /**< Koszt w bajtach */
+        typename std::list<K>::iterator pozycja;       /**< Pozycja na liście LRU */
+    };
+
+    /**
+     * @struct Segment
+     * @brief Niezależnie blokowana część pamięci.
+     */
+    struct Segment {
+        QMutex mutex;                  /**< Blokada segmentu */
+        QHash<K, Element> elementy;    /**< Wpisy segmentu */
+        std::list<K> kolejnosc;        /**< Klucze od ostatnio do najdawniej używanego */
+        qint64 zajete = 0;             /**< Suma kosztów wpisów */
+
+        /**
+         * @brief Usuwa wpis z segmentu (wywoływane pod blokadą).
+         * @param klucz Klucz wpisu.
+         */
+        void usun(const K& klucz) {
+            auto it = elementy.find(klucz);
+            if (it == elementy.end())
+                return;
+            zajete -= it->koszt;
+            kolejnosc.erase(it->pozycja);
+            elementy.erase(it);
+        }
+    };
+
+    /**
+     * @brief Zwraca segment odpowiedzialny za klucz.
+     * @param klucz Klucz wpisu.
+     * @return Referencja do segmentu.
+     */
+    Segment& segment(const K& klucz) const {
+        return m_segmenty[qHash(klucz) % LiczbaSegmentow];
+    }
+
+    mutable Segment m_segmenty[LiczbaSegmentow];   /**< Segmenty pamięci */
+    const qint64 m_maksSegmentu;                   /**< Limit kosztu jednego segmentu */
+};
+
+#endif // PAMIEC_WSPOLBIEZNA_H
@@ -0,0 +1,188 @@
+/**
+ * @file Parser_czasu.cpp
+ * @brief Plik źródłowy klasy ParserCzasu
+ */
+
+#include "Parser_czasu.h"
+
+#include <QDateTime>
+#include <QTimeZone>
+#include <limits>
+
+namespace {
+
+const qint64 MS_NA_SEKUNDE = 1000;
+const qint64 MS_NA_DOBE = 86400 * MS_NA_SEKUNDE;
+
+/**
+ * @brief Odczytuje liczbę z określonej liczby cyfr.
+ */
+bool cyfry(QStringView tekst, int pozycja, int liczba, int* wynik) {
+    int w = 0;
+    for (int i = pozycja; i < pozycja + liczba; ++i) {
+        const char16_t c = tekst[i].unicode();
+        if (c < u'0' || c > u'9') return false;
+        w = w * 10 + (c - u'0');
+    }
+    *wynik = w;
+    return true;
+}
+
+/**
+ * @struct PrzedzialStrefy
+ * @brief Przedział czasu lokalnego, w którym przesunięcie strefy jest stałe.
+ */
+struct PrzedzialStrefy {
+    qint64 odNaiwny = 1;    /**< Początek przedziału (czas naiwny, włącznie) */
+    qint64 doNaiwny = 0;    /**< Koniec przedziału (czas naiwny, wyłącznie) */
+    qint64 przesuniecie = 0; /**< Przesunięcie czasu lokalnego względem UTC w ms */
+};
+
+} // namespace
+
+/**
+ * @brief Parsuje znacznik czasu do milisekund od epoki.
+ *
+ * @param tekst Tekst znacznika czasu.
+ * @param wynikMs Wskaźnik na wynik.
+ * @return true jeśli format jest poprawny.
+ */
+bool ParserCzasu::parsuj(QStringView tekst, qint64* wynikMs) {
+    // yyyy-MM-dd HH:mm  (16 znaków) lub yyyy-MM-dd HH:mm:ss (19 znaków) + opcjonalna strefa
+    if (tekst.size() < 16) return false;
+    if (tekst[4] != u'-' || tekst[7] != u'-' || tekst[13] != u':') return false;
+    if (tekst[10] != u' ' && tekst[10] != u'T') return false;
+
+    int rok, miesiac, dzien, godzina, minuta, sekunda = 0;
+    if (!cyfry(tekst, 0, 4, &rok) || !cyfry(tekst, 5, 2, &miesiac) || !cyfry(tekst, 8, 2, &dzien) ||
+        !cyfry(tekst, 11, 2, &godzina) || !cyfry(tekst, 14, 2, &minuta))
+        return false;
+
+    int pozycja = 16;
+    if (tekst.size() >= 19 && tekst[16] == u':') {
+        if (!cyfry(tekst, 17, 2, &sekunda)) return false;
+        pozycja = 19;
+        // Ułamki sekund (ISO) są pomijane.
+        if (pozycja < tekst.size() && tekst[pozycja] == u'.') {
+            ++pozycja;
+            while (pozycja < tekst.size() && tekst[pozycja].isDigit()) ++pozycja;
+        }
+    }
+
+    if (miesiac < 1 || miesiac > 12 || dzien < 1 || dzien > dniWMiesiacu(rok, miesiac) ||
+        godzina > 23 || minuta > 59 || sekunda > 60)
+        return false;
+
+    const qint64 naiwny = dniOdEpoki(rok, miesiac, dzien) * MS_NA_DOBE +
+                          ((godzina * 60 + minuta) * 60 + sekunda) * MS_NA_SEKUNDE;
+
+    if (pozycja == tekst.size()) {
+        *wynikMs = lokalnyNaUtc(naiwny);
+        return true;
+    }
+
+    if (tekst[pozycja] == u'Z' && pozycja + 1 == tekst.size()) {
+        *wynikMs = naiwny;
+        return true;
+    }
+
+    if ((tekst[pozycja] == u'+' || tekst[pozycja] == u'-') && tekst.size() == pozycja + 6 &&
+        tekst[pozycja + 3] == u':') {
+        int godzStrefy, minStrefy;
+        if (!cyfry(tekst, pozycja + 1, 2, &godzStrefy) || !cyfry(tekst, pozycja + 4, 2, &minStrefy))
+            return false;
+        const qint64 przesuniecie = (godzStrefy * 60 + minStrefy) * 60 * MS_NA_SEKUNDE;
+        *wynikMs = tekst[pozycja] == u'+' ? naiwny - przesuniecie : naiwny + przesuniecie;
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Parsuje znacznik czasu, zwracając wartość domyślną w razie błędu.
+ *
+ * @param tekst Tekst znacznika czasu.
+ * @param domyslna Wartość domyślna.
+ * @return Milisekundy od epoki lub wartość domyślna.
+ */
+qint64 ParserCzasu::parsujLubDomyslna(QStringView tekst, qint64 domyslna) {
+    qint64 wynik;
+    return parsuj(tekst, &wynik) ? wynik : domyslna;
+}
+
+/**
+ * @brief Zwraca liczbę dni miesiąca w kalendarzu gregoriańskim.
+ *
+ * @param rok Rok.
+ * @param miesiac Miesiąc (1-12).
+ * @return Liczba dni.
+ */
+int ParserCzasu::dniWMiesiacu(int rok, int miesiac) {
+    static const int DNI[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    if (miesiac == 2 && rok % 4 == 0 && (rok % 100 != 0 || rok % 400 == 0))
+        return 29;
+    return DNI[miesiac - 1];
+}
+
+/**
+ * @brief Zamienia datę kalendarzową na liczbę dni od 1970-01-01.
+ *
+ * Algorytm "days from civil" dla kalendarza gregoriańskiego (ery 400-letnie).
+ *
+ * @param rok Rok.
+ * @param miesiac Miesiąc.
+ * @param dzien Dzień.
+ * @return Liczba dni od epoki.
+ */
+qint64 ParserCzasu::dniOdEpoki(int rok, int miesiac, int dzien) {
+    rok -= miesiac <= 2;
+    const qint64 era = (rok >= 0 ? rok : rok - 399) / 400;
+    const qint64 rokEry = rok - era * 400;
+    const qint64 dzienRoku = (153 * (miesiac + (miesiac > 2 ? -3 : 9)) + 2) / 5 + dzien - 1;
+    const qint64 dzienEry = rokEry * 365 + rokEry / 4 - rokEry / 100 + dzienRoku;
+    return era * 146097 + dzienEry - 719468;
+}
+
+/**
+ * @brief Przelicza czas lokalny na UTC.
+ *
+ * Przy pierwszym zapytaniu spoza zapamiętanego przedziału przesunięcie jest wyznaczane przez QDateTime,
+ * a granice przedziału przez najbliższe przejścia strefy systemowej (np. zmianę czasu letniego).
+ * Przedział jest osobny dla każdego wątku.
+ *
+ * @param naiwnyMs Czas lokalny zapisany jak UTC.
+ * @return Czas UTC.
+ */
+qint64 ParserCzasu::lokalnyNaUtc(qint64 naiwnyMs) {
+    thread_local PrzedzialStrefy przedzial;
+
+    if (naiwnyMs >= przedzial.odNaiwny && naiwnyMs < przedzial.doNaiwny)
+        return naiwnyMs - przedzial.przesuniecie;
+
+    const QDateTime naiwny = QDateTime::fromMSecsSinceEpoch(naiwnyMs, QTimeZone::utc());
+    const QDateTime lokalny(naiwny.date(), naiwny.time());
+    const qint64 utc = lokalny.toMSecsSinceEpoch();
+    const qint64 przesuniecie = naiwnyMs - utc;
+
+    qint64 od = std::numeric_limits<qint64>::min();
+    qint64 doCzasu = std::numeric_limits<qint64>::max();
+
+    const QTimeZone strefa = QTimeZone::systemTimeZone();
+    if (strefa.hasTransitions()) {
+        const QTimeZone::OffsetData poprzednie = strefa.previousTransition(lokalny);
+        const QTimeZone::OffsetData nastepne = strefa.nextTransition(lokalny);
+        if (poprzednie.atUtc.isValid())
+            od = poprzednie.atUtc.toMSecsSinceEpoch() + przesuniecie;
+        if (nastepne.atUtc.isValid())
+            doCzasu = nastepne.atUtc.toMSecsSinceEpoch() + przesuniecie;
+    }
+
+    // Czas tuż przy przejściu (godzina zdublowana lub pominięta) nie jest zapamiętywany.
+    if (naiwnyMs >= od && naiwnyMs < doCzasu) {
+        przedzial.odNaiwny = od;
+        przedzial.doNaiwny = doCzasu;
+        przedzial.przesuniecie = przesuniecie;
+    }
+    return utc;
+}
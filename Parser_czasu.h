@@ -0,0 +1,73 @@
+/**
+ * @file Parser_czasu.h
+ * @brief Plik nagłówkowy klasy ParserCzasu
+ *
+ * Klasa ParserCzasu zamienia znaczniki czasu zwracane przez API GIOŚ
+ * bezpośrednio na milisekundy od epoki, bez tworzenia pośrednich obiektów QDateTime.
+*/
+
+#ifndef PARSER_CZASU_H
+#define PARSER_CZASU_H
+
+#include <QStringView>
+#include <QtGlobal>
+
+/**
+ * @class ParserCzasu
+ * @brief Szybki parser znaczników czasu w stałym formacie.
+ *
+ * Obsługiwane formaty:
+ * - "yyyy-MM-dd HH:mm:ss" (format API GIOŚ, czas lokalny),
+ * - "yyyy-MM-ddTHH:mm:ss" (ISO 8601, czas lokalny),
+ * - oba powyższe bez sekund,
+ * - ISO 8601 z oznaczeniem strefy "Z" lub przesunięciem "+hh:mm" / "-hh:mm".
+ *
+ * Czas lokalny przeliczany jest na UTC z użyciem zapamiętanego przedziału, w którym przesunięcie strefy
+ * systemowej jest stałe, więc kolejne próbki z tej samej doby (lub sezonu) nie odpytują bazy stref czasowych.
+ */
+class ParserCzasu
+{
+public:
+    /**
+     * @brief Parsuje znacznik czasu.
+     * @param tekst Tekst znacznika czasu.
+     * @param wynikMs Wskaźnik na wynik w milisekundach od epoki (UTC).
+     * @return true jeśli tekst ma poprawny format.
+     */
+    static bool parsuj(QStringView tekst, qint64* wynikMs);
+
+    /**
+     * @brief Parsuje znacznik czasu, zwracając wartość domyślną w razie błędu.
+     * @param tekst Tekst znacznika czasu.
+     * @param domyslna Wartość zwracana dla niepoprawnego tekstu.
+     * @return Milisekundy od epoki (UTC) lub wartość domyślna.
+     */
+    static qint64 parsujLubDomyslna(QStringView tekst, qint64 domyslna = 0);
+
+private:
+    /**
+     * @brief Zwraca liczbę dni miesiąca.
+     * @param rok Rok (rozstrzyga o 29 lutego).
+     * @param miesiac Miesiąc (1-12).
+     * @return Liczba dni (28-31).
+     */
+    static int dniWMiesiacu(int rok, int miesiac);
+
+    /**
+     * @brief Zamienia datę kalendarzową na liczbę dni od 1970-01-01.
+     * @param rok Rok.
+     * @param miesiac Miesiąc (1-12).
+     * @param dzien Dzień miesiąca (1-31).
+     * @return Liczba dni od epoki.
+     */
+    static qint64 dniOdEpoki(int rok, int miesiac, int dzien);
+
+    /**
+     * @brief Przelicza "naiwny" czas lokalny (zapisany jak UTC) na rzeczywisty czas UTC.
+     * @param naiwnyMs Czas lokalny w milisekundach, liczony tak, jakby był czasem UTC.
+     * @return Czas UTC w milisekundach od epoki.
+     */
+    static qint64 lokalnyNaUtc(qint64 naiwnyMs);
+};
+
+#endif // PARSER_CZASU_H
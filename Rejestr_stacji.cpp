@@ -0,0 +1,357 @@
+/**
+ * @file Rejestr_stacji.cpp
+ * @brief Plik źródłowy klasy RejestrStacji
+ */
+
+#include "Rejestr_stacji.h"
+
+#include <QJsonObject>
+#include <algorithm>
+
+namespace {
+/// Trafienia z oceną co najmniej taką zawierają szukany tekst; niższe są tylko podobne.
+const float OCENA_FRAGMENTU = 0.7f;
+
+/**
+ * @brief Usuwa trafienia tylko podobne, jeśli są trafienia zawierające szukany tekst.
+ */
+void pominPodobne(QVector<IndeksNazw::Trafienie>& posortowane) {
+    if (posortowane.isEmpty() || posortowane.first().ocena < OCENA_FRAGMENTU)
+        return;
+
+    int n = 0;
+    while (n < posortowane.size() && posortowane[n].ocena >= OCENA_FRAGMENTU)
+        ++n;
+    posortowane.resize(n);
+}
+}
+
+/**
+ * @brief Domyślny konstruktor klasy RejestrStacji.
+ */
+RejestrStacji::RejestrStacji()
+{}
+
+/**
+ * @brief Dekoduje tablicę JSON ze stacjami do kolumn rejestru.
+ *
+ * Każdy obiekt JSON jest odczytywany dokładnie raz (przez StacjaPomiarowa::fromJson).
+ * Stacje bez współrzędnych trafiają do rejestru, ale nie do indeksu przestrzennego.
+ *
+ * @param stacje Tablica JSON ze stacjami.
+ */
+void RejestrStacji::zbuduj(const QJsonArray& stacje) {
+    wyczysc();
+    scal(stacje);
+}
+
+/**
+ * @brief Dołącza stacje do kolumn rejestru i przebudowuje indeks przestrzenny.
+ *
+ * @param stacje Tablica JSON ze stacjami.
+ */
+void RejestrStacji::scal(const QJsonArray& stacje) {
+    const int n = m_id.size() + stacje.size();
+    m_id.reserve(n);
+    m_lat.reserve(n);
+    m_lon.reserve(n);
+    m_nazwa.reserve(n);
+    m_miasto.reserve(n);
+    m_ulica.reserve(n);
+    m_wierszDlaId.reserve(n);
+
+    for (const QJsonValue& val : stacje) {
+        const StacjaPomiarowa stacja = StacjaPomiarowa::fromJson(val.toObject());
+        const auto it = m_wierszDlaId.constFind(stacja.id());
+
+        if (it != m_wierszDlaId.constEnd()) {
+            const int wiersz = it.value();
+            m_lat[wiersz] = stacja.latitude();
+            m_lon[wiersz] = stacja.longitude();
+            m_nazwa[wiersz] = stacja.nazwa();
+            m_miasto[wiersz] = internuj(stacja.miasto());
+            m_ulica[wiersz] = internuj(stacja.ulica());
+            continue;
+        }
+
+        m_wierszDlaId.insert(stacja.id(), m_id.size());
+        m_id.append(stacja.id());
+        m_lat.append(stacja.latitude());
+        m_lon.append(stacja.longitude());
+        m_nazwa.append(stacja.nazwa());
+        m_miasto.append(internuj(stacja.miasto()));
+        m_ulica.append(internuj(stacja.ulica()));
+    }
+
+    przebudujIndeks();
+    przebudujIndeksNazw();
+}
+
+/**
+ * @brief Buduje indeks przestrzenny ze stacji, które mają współrzędne.
+ */
+void RejestrStacji::przebudujIndeks() {
+    const int n = m_id.size();
+    QVector<double> szerokosci;
+    QVector<double> dlugosci;
+    szerokosci.reserve(n);
+    dlugosci.reserve(n);
+    m_wierszPunktu.clear();
+    m_wierszPunktu.reserve(n);
+
+    for (int wiersz = 0; wiersz < n; ++wiersz) {
+        if (qFuzzyIsNull(m_lat[wiersz]) || qFuzzyIsNull(m_lon[wiersz])) continue;
+
+        m_wierszPunktu.append(wiersz);
+        szerokosci.append(m_lat[wiersz]);
+        dlugosci.append(m_lon[wiersz]);
+    }
+
+    m_indeks.zbuduj(szerokosci, dlugosci);
+}
+
+/**
+ * @brief Buduje indeksy nazw miast (unikalnych) i stacji.
+ */
+void RejestrStacji::przebudujIndeksNazw() {
+    QHash<int, int> dokumentMiasta;
+    QVector<QString> miasta;
+    m_wierszeMiasta.clear();
+
+    for (int wiersz = 0; wiersz < m_miasto.size(); ++wiersz) {
+        auto it = dokumentMiasta.constFind(m_miasto[wiersz]);
+        if (it == dokumentMiasta.constEnd()) {
+            it = dokumentMiasta.insert(m_miasto[wiersz], miasta.size());
+            miasta.append(m_napisy[m_miasto[wiersz]]);
+            m_wierszeMiasta.append(QVector<int>());
+        }
+        m_wierszeMiasta[it.value()].append(wiersz);
+    }
+
+    m_indeksMiast.zbuduj(miasta);
+    m_indeksStacji.zbuduj(m_nazwa);
+}
+
+/**
+ * @brief Usuwa wszystkie stacje i internowane napisy.
+ */
+void RejestrStacji::wyczysc() {
+    m_id.clear();
+    m_lat.clear();
+    m_lon.clear();
+    m_nazwa.clear();
+    m_miasto.clear();
+    m_ulica.clear();
+    m_napisy.clear();
+    m_indeksNapisow.clear();
+    m_wierszDlaId.clear();
+    m_wierszPunktu.clear();
+    m_indeks.wyczysc();
+    m_indeksMiast.wyczysc();
+    m_wierszeMiasta.clear();
+    m_indeksStacji.wyczysc();
+}
+
+/**
+ * @brief Zwraca liczbę stacji w rejestrze.
+ * @return Liczba wierszy.
+ */
+int RejestrStacji::rozmiar() const {
+    return m_id.size();
+}
+
+/**
+ * @brief Sprawdza, czy rejestr jest pusty.
+ * @return true jeśli rejestr nie zawiera stacji.
+ */
+bool RejestrStacji::jestPusty() const {
+    return m_id.isEmpty();
+}
+
+/**
+ * @brief Zwraca numer wiersza dla identyfikatora stacji.
+ * @param id Identyfikator stacji.
+ * @return Numer wiersza lub -1.
+ */
+int RejestrStacji::wierszDlaId(int id) const {
+    return m_wierszDlaId.value(id, -1);
+}
+
+/**
+ * @brief Zwraca identyfikator stacji.
+ * @param wiersz Numer wiersza.
+ * @return Identyfikator stacji.
+ */
+int RejestrStacji::id(int wiersz) const {
+    return m_id[wiersz];
+}
+
+/**
+ * @brief Zwraca szerokość geograficzną stacji.
+ * @param wiersz Numer wiersza.
+ * @return Szerokość geograficzna.
+ */
+double RejestrStacji::latitude(int wiersz) const {
+    return m_lat[wiersz];
+}
+
+/**
+ * @brief Zwraca długość geograficzną stacji.
+ * @param wiersz Numer wiersza.
+ * @return Długość geograficzna.
+ */
+double RejestrStacji::longitude(int wiersz) const {
+    return m_lon[wiersz];
+}
+
+/**
+ * @brief Zwraca nazwę stacji.
+ * @param wiersz Numer wiersza.
+ * @return Nazwa stacji.
+ */
+const QString& RejestrStacji::nazwa(int wiersz) const {
+    return m_nazwa[wiersz];
+}
+
+/**
+ * @brief Zwraca nazwę miasta stacji.
+ * @param wiersz Numer wiersza.
+ * @return Nazwa miasta.
+ */
+const QString& RejestrStacji::miasto(int wiersz) const {
+    return m_napisy[m_miasto[wiersz]];
+}
+
+/**
+ * @brief Zwraca nazwę ulicy stacji.
+ * @param wiersz Numer wiersza.
+ * @return Nazwa ulicy.
+ */
+const QString& RejestrStacji::ulica(int wiersz) const {
+    return m_napisy[m_ulica[wiersz]];
+}
+
+/**
+ * @brief Składa obiekt StacjaPomiarowa z kolumn rejestru.
+ * @param wiersz Numer wiersza.
+ * @return Obiekt stacji.
+ */
+StacjaPomiarowa RejestrStacji::stacja(int wiersz) const {
+    return StacjaPomiarowa(m_id[wiersz], m_nazwa[wiersz], m_lat[wiersz], m_lon[wiersz],
+                           miasto(wiersz), ulica(wiersz));
+}
+
+/**
+ * @brief Zwraca numery wszystkich wierszy.
+ * @return Tablica 0..rozmiar()-1.
+ */
+QVector<int> RejestrStacji::wszystkie() const {
+    QVector<int> wynik(m_id.size());
+    for (int i = 0; i < wynik.size(); ++i)
+        wynik[i] = i;
+    return wynik;
+}
+
+/**
+ * @brief Wyszukuje stacje po fragmencie nazwy miasta.
+ *
+ * Zapytanie trafia do indeksu unikalnych nazw miast; nazwy tylko podobne są brane pod uwagę
+ * wyłącznie wtedy, gdy żadna nazwa nie zawiera szukanego tekstu.
+ *
+ * @param miasto Szukany tekst.
+ * @return Numery pasujących wierszy.
+ */
+QVector<int> RejestrStacji::wMiescie(const QString& miasto) const {
+    QVector<IndeksNazw::Trafienie> trafienia = m_indeksMiast.szukaj(miasto);
+    pominPodobne(trafienia);
+
+    QVector<int> wynik;
+    for (const IndeksNazw::Trafienie& t : trafienia)
+        wynik += m_wierszeMiasta[t.indeks];
+    return wynik;
+}
+
+/**
+ * @brief Wyszukuje stacje po nazwie miasta lub stacji.
+ *
+ * Ocena wiersza to lepsza z ocen jego miasta i nazwy stacji; stacje tylko o podobnej nazwie
+ * są zwracane wtedy, gdy żadna nie zawiera szukanego tekstu.
+ *
+ * @param tekst Szukany tekst.
+ * @param limit Maksymalna liczba wyników.
+ * @return Numery wierszy.
+ */
+QVector<int> RejestrStacji::szukaj(const QString& tekst, int limit) const {
+    QHash<int, float> oceny;
+    for (const IndeksNazw::Trafienie& t : m_indeksMiast.szukaj(tekst)) {
+        for (int wiersz : m_wierszeMiasta[t.indeks])
+            oceny[wiersz] = qMax(oceny.value(wiersz), t.ocena);
+    }
+    for (const IndeksNazw::Trafienie& t : m_indeksStacji.szukaj(tekst))
+        oceny[t.indeks] = qMax(oceny.value(t.indeks), t.ocena);
+
+    QVector<IndeksNazw::Trafienie> wynik;
+    wynik.reserve(oceny.size());
+    for (auto it = oceny.cbegin(); it != oceny.cend(); ++it)
+        wynik.append(IndeksNazw::Trafienie{it.key(), it.value()});
+    std::sort(wynik.begin(), wynik.end(), [](const IndeksNazw::Trafienie& a, const IndeksNazw::Trafienie& b) {
+        return a.ocena != b.ocena ? a.ocena > b.ocena : a.indeks < b.indeks;
+    });
+    pominPodobne(wynik);
+
+    QVector<int> wiersze;
+    const int n = limit >= 0 ? qMin(limit, wynik.size()) : wynik.size();
+    wiersze.reserve(n);
+    for (int i = 0; i < n; ++i)
+        wiersze.append(wynik[i].indeks);
+    return wiersze;
+}
+
+/**
+ * @brief Wyszukuje stacje w promieniu od punktu.
+ * @param lat Szerokość geograficzna.
+ * @param lon Długość geograficzna.
+ * @param promienKm Promień w kilometrach.
+ * @return Wyniki z numerami wierszy.
+ */
+QVector<IndeksPrzestrzenny::Wynik> RejestrStacji::wPromieniu(double lat, double lon, double promienKm) const {
+    return naWiersze(m_indeks.wPromieniu(lat, lon, promienKm));
+}
+
+/**
+ * @brief Wyszukuje k najbliższych stacji.
+ * @param lat Szerokość geograficzna.
+ * @param lon Długość geograficzna.
+ * @param k Maksymalna liczba stacji.
+ * @return Wyniki z numerami wierszy.
+ */
+QVector<IndeksPrzestrzenny::Wynik> RejestrStacji::najblizsze(double lat, double lon, int k) const {
+    return naWiersze(m_indeks.najblizsze(lat, lon, k));
+}
+
+/**
+ * @brief Internuje napis.
+ * @param napis Napis do zinternowania.
+ * @return Indeks napisu w m_napisy.
+ */
+int RejestrStacji::internuj(const QString& napis) {
+    auto it = m_indeksNapisow.constFind(napis);
+    if (it != m_indeksNapisow.constEnd())
+        return it.value();
+
+    const int indeks = m_napisy.size();
+    m_napisy.append(napis);
+    m_indeksNapisow.insert(napis, indeks);
+    return indeks;
+}
+
+/**
+ * @brief Zamienia numery punktów indeksu przestrzennego na numery wierszy.
+ * @param wyniki Wyniki zapytania.
+ * @return Wyniki z numerami wierszy.
+ */
+QVector<IndeksPrzestrzenny::Wynik> RejestrStacji::naWiersze(QVector<IndeksPrzestrzenny::Wynik> wyniki) const {
+    for (IndeksPrzestrzenny::Wynik& w : wyniki)
+        w.indeks = m_wierszPunktu[w.indeks];
+    return wyniki;
+}
@@ -0,0 +1,212 @@
+/**
+ * @file Rejestr_stacji.h
+ * @brief Plik nagłówkowy klasy RejestrStacji
+ *
+ * Klasa RejestrStacji przechowuje listę stacji pomiarowych w postaci kolumnowej (struct-of-arrays).
+ * Dane są dekodowane z JSON raz po każdym pobraniu, a interfejs i filtry odczytują je już jako typy proste.
+*/
+
+#ifndef REJESTR_STACJI_H
+#define REJESTR_STACJI_H
+
+#include <QVector>
+#include <QString>
+#include <QHash>
+#include <QJsonArray>
+
+#include "Stacja_pomiarowa.h"
+#include "Indeks_przestrzenny.h"
+#include "Indeks_nazw.h"
+
+/**
+ * @class RejestrStacji
+ * @brief Kolumnowy rejestr stacji pomiarowych.
+ *
+ * Każda stacja zajmuje jeden wiersz, a jej pola przechowywane są w osobnych tablicach
+ * (identyfikatory, współrzędne jako double, indeksy do internowanych nazw miast i ulic).
+ * Rejestr udostępnia odwzorowanie identyfikatora stacji na wiersz, indeks przestrzenny
+ * oraz indeksy nazw miast i stacji (wyszukiwanie bez znaków diakrytycznych, np. przy wpisywaniu).
+ */
+class RejestrStacji
+{
+public:
+    /**
+     * @brief Konstruktor domyślny.
+     *
+     * Tworzy pusty rejestr.
+     */
+    RejestrStacji();
+
+    /**
+     * @brief Buduje rejestr od nowa na podstawie tablicy JSON ze stacjami.
+     * @param stacje Tablica JSON (klucze API v1 lub starsze, patrz StacjaPomiarowa::fromJson).
+     */
+    void zbuduj(const QJsonArray& stacje);
+
+    /**
+     * @brief Dołącza stacje do rejestru (np. kolejną stronę listy stacji).
+     * @param stacje Tablica JSON ze stacjami.
+     *
+     * Stacja o znanym już identyfikatorze jest aktualizowana w miejscu, nowe są dopisywane
+     * na końcu, więc numery wierszy wcześniej dodanych stacji się nie zmieniają.
+     */
+    void scal(const QJsonArray& stacje);
+
+    /**
+     * @brief Usuwa wszystkie stacje z rejestru.
+     */
+    void wyczysc();
+
+    /**
+     * @brief Zwraca liczbę stacji w rejestrze.
+     * @return Liczba wierszy.
+     */
+    int rozmiar() const;
+
+    /**
+     * @brief Sprawdza, czy rejestr jest pusty.
+     * @return true jeśli rejestr nie zawiera stacji.
+     */
+    bool jestPusty() const;
+
+    /**
+     * @brief Zwraca numer wiersza dla identyfikatora stacji.
+     * @param id Identyfikator stacji.
+     * @return Numer wiersza lub -1, jeśli stacji nie ma w rejestrze.
+     */
+    int wierszDlaId(int id) const;
+
+    /**
+     * @brief Zwraca identyfikator stacji.
+     * @param wiersz Numer wiersza.
+     * @return Identyfikator stacji.
+     */
+    int id(int wiersz) const;
+
+    /**
+     * @brief Zwraca szerokość geograficzną stacji.
+     * @param wiersz Numer wiersza.
+     * @return Szerokość geograficzna (0 jeśli nieznana).
+     */
+    double latitude(int wiersz) const;
+
+    /**
+     * @brief Zwraca długość geograficzną stacji.
+     * @param wiersz Numer wiersza.
+     * @return Długość geograficzna (0 jeśli nieznana).
+     */
+    double longitude(int wiersz) const;
+
+    /**
+     * @brief Zwraca nazwę stacji.
+     * @param wiersz Numer wiersza.
+     * @return Nazwa stacji.
+     */
+    const QString& nazwa(int wiersz) const;
+
+    /**
+     * @brief Zwraca nazwę miasta stacji.
+     * @param wiersz Numer wiersza.
+     * @return Nazwa miasta (internowana).
+     */
+    const QString& miasto(int wiersz) const;
+
+    /**
+     * @brief Zwraca nazwę ulicy stacji.
+     * @param wiersz Numer wiersza.
+     * @return Nazwa ulicy (internowana).
+     */
+    const QString& ulica(int wiersz) const;
+
+    /**
+     * @brief Składa obiekt StacjaPomiarowa z kolumn rejestru.
+     * @param wiersz Numer wiersza.
+     * @return Obiekt stacji.
+     */
+    StacjaPomiarowa stacja(int wiersz) const;
+
+    /**
+     * @brief Zwraca numery wszystkich wierszy w kolejności pobrania.
+     * @return Tablica numerów wierszy.
+     */
+    QVector<int> wszystkie() const;
+
+    /**
+     * @brief Wyszukuje stacje, których nazwa miasta zawiera podany tekst.
+     * @param miasto Szukany tekst (wielkość liter i znaki diakrytyczne nie mają znaczenia).
+     * @return Numery pasujących wierszy, od miast najlepiej pasujących.
+     *
+     * Gdy żadna nazwa nie zawiera tekstu, zwracane są stacje miast o podobnej nazwie (literówki).
+     */
+    QVector<int> wMiescie(const QString& miasto) const;
+
+    /**
+     * @brief Wyszukuje stacje po nazwie miasta lub nazwie stacji (np. przy każdym naciśnięciu klawisza).
+     * @param tekst Szukany tekst.
+     * @param limit Maksymalna liczba wyników (-1 - bez limitu).
+     * @return Numery wierszy od najlepiej pasujących.
+     */
+    QVector<int> szukaj(const QString& tekst, int limit = -1) const;
+
+    /**
+     * @brief Wyszukuje stacje w promieniu od punktu.
+     * @param lat Szerokość geograficzna punktu odniesienia.
+     * @param lon Długość geograficzna punktu odniesienia.
+     * @param promienKm Promień w kilometrach.
+     * @return Wyniki (pole indeks to numer wiersza) posortowane według odległości.
+     */
+    QVector<IndeksPrzestrzenny::Wynik> wPromieniu(double lat, double lon, double promienKm) const;
+
+    /**
+     * @brief Wyszukuje k stacji najbliższych punktowi.
+     * @param lat Szerokość geograficzna punktu odniesienia.
+     * @param lon Długość geograficzna punktu odniesienia.
+     * @param k Maksymalna liczba stacji.
+     * @return Wyniki (pole indeks to numer wiersza) posortowane według odległości.
+     */
+    QVector<IndeksPrzestrzenny::Wynik> najblizsze(double lat, double lon, int k) const;
+
+private:
+    /**
+     * @brief Zwraca indeks napisu w tablicy internowanych napisów, dodając go w razie potrzeby.
+     * @param napis Napis do zinternowania.
+     * @return Indeks napisu.
+     */
+    int internuj(const QString& napis);
+
+    /**
+     * @brief Zamienia numery punktów indeksu przestrzennego na numery wierszy.
+     * @param wyniki Wyniki zapytania do indeksu.
+     * @return Wyniki z numerami wierszy.
+     */
+    QVector<IndeksPrzestrzenny::Wynik> naWiersze(QVector<IndeksPrzestrzenny::Wynik> wyniki) const;
+
+    /**
+     * @brief Buduje indeks przestrzenny od nowa ze wszystkich stacji ze znanymi współrzędnymi.
+     */
+    void przebudujIndeks();
+
+    /**
+     * @brief Buduje od nowa indeksy nazw miast i stacji.
+     */
+    void przebudujIndeksNazw();
+
+    QVector<int> m_id;                 /**< Identyfikatory stacji */
+    QVector<double> m_lat;             /**< Szerokości geograficzne */
+    QVector<double> m_lon;             /**< Długości geograficzne */
+    QVector<QString> m_nazwa;          /**< Nazwy stacji */
+    QVector<int> m_miasto;             /**< Indeksy nazw miast w m_napisy */
+    QVector<int> m_ulica;              /**< Indeksy nazw ulic w m_napisy */
+
+    QVector<QString> m_napisy;         /**< Internowane nazwy miast i ulic */
+    QHash<QString, int> m_indeksNapisow; /**< Odwzorowanie napisu na indeks w m_napisy */
+    QHash<int, int> m_wierszDlaId;     /**< Odwzorowanie identyfikatora stacji na wiersz */
+
+    QVector<int> m_wierszPunktu;       /**< Odwzorowanie punktu indeksu przestrzennego na wiersz */
+    IndeksPrzestrzenny m_indeks;       /**< Indeks przestrzenny stacji ze znanymi współrzędnymi */
+    IndeksNazw m_indeksMiast;          /**< Indeks unikalnych nazw miast */
+    QVector<QVector<int>> m_wierszeMiasta; /**< Wiersze stacji każdego miasta z m_indeksMiast */
+    IndeksNazw m_indeksStacji;         /**< Indeks nazw stacji (numer nazwy = wiersz) */
+};
+
+#endif // REJESTR_STACJI_H
@@ -0,0 +1,398 @@
+/**
+ * @file Seria_pomiarowa.cpp
+ * @brief Plik źródłowy klasy SeriaPomiarowa
+ */
+
+#include "Seria_pomiarowa.h"
+#include "Parser_czasu.h"
+
+#include <QJsonArray>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <algorithm>
+#include <numeric>
+
+/**
+ * @brief Domyślny konstruktor klasy SeriaPomiarowa.
+ */
+SeriaPomiarowa::SeriaPomiarowa()
+{}
+
+/**
+ * @brief Konstruktor tworzący pustą serię dla parametru.
+ * @param parametr Kod parametru pomiarowego.
+ */
+SeriaPomiarowa::SeriaPomiarowa(const QString& parametr) :
+    m_parametr(internuj(parametr))
+{}
+
+/**
+ * @brief Tworzy serię na podstawie obiektu JSON.
+ *
+ * Oczekiwane klucze JSON: "key" (kod parametru) oraz "values" - tablica obiektów
+ * z polami "date" (ISO lub "yyyy-MM-dd HH:mm:ss") i "value" (liczba lub null).
+ * Daty są parsowane raz, przez ParserCzasu; próbki z niepoprawną datą są pomijane.
+ * Wynikowa seria jest posortowana rosnąco po czasie.
+ *
+ * @param json Obiekt JSON z pomiarami.
+ * @return Seria utworzona na podstawie JSON.
+ */
+SeriaPomiarowa SeriaPomiarowa::fromJson(const QJsonObject& json) {
+    SeriaPomiarowa seria(json["key"].toString());
+
+    const QJsonArray wartosci = json["values"].toArray();
+    seria.zarezerwuj(wartosci.size());
+
+    for (const QJsonValue& val : wartosci) {
+        const QJsonObject pomiar = val.toObject();
+        qint64 czas = 0;
+        if (!ParserCzasu::parsuj(pomiar["date"].toString(), &czas)) continue;
+
+        const QJsonValue wartosc = pomiar["value"];
+        if (wartosc.isNull() || wartosc.isUndefined())
+            seria.dodajBrak(czas);
+        else
+            seria.dodaj(czas, static_cast<float>(wartosc.toDouble()));
+    }
+    seria.uporzadkuj();
+    return seria;
+}
+
+/**
+ * @brief Konwertuje serię do formatu JSON.
+ *
+ * Daty zapisywane są w formacie "yyyy-MM-dd HH:mm:ss", a braki jako null.
+ *
+ * @return Obiekt JSON z kluczami "key" i "values".
+ */
+QJsonObject SeriaPomiarowa::toJson() const {
+    QJsonArray wartosci;
+    for (int i = 0; i < rozmiar(); ++i) {
+        QJsonObject pomiar;
+        pomiar["date"] = QDateTime::fromMSecsSinceEpoch(m_czas[i]).toString("yyyy-MM-dd HH:mm:ss");
+        pomiar["value"] = jestBrak(i) ? QJsonValue() : QJsonValue(m_wartosci[i]);
+        wartosci.append(pomiar);
+    }
+
+    QJsonObject obj;
+    obj["key"] = m_parametr;
+    obj["values"] = wartosci;
+    return obj;
+}
+
+/**
+ * @brief Dodaje próbkę na koniec serii.
+ * @param czasMs Znacznik czasu.
+ * @param wartosc Wartość pomiaru.
+ */
+void SeriaPomiarowa::dodaj(qint64 czasMs, float wartosc) {
+    const int i = m_czas.size();
+    if ((i & 63) == 0)
+        m_braki.append(0);
+    if (i > 0 && czasMs < m_czas[i - 1])
+        m_posortowana = false;
+    m_czas.append(czasMs);
+    m_wartosci.append(wartosc);
+}
+
+/**
+ * @brief Dodaje próbkę bez wartości.
+ * @param czasMs Znacznik czasu.
+ */
+void SeriaPomiarowa::dodajBrak(qint64 czasMs) {
+    const int i = m_czas.size();
+    dodaj(czasMs, 0.0f);
+    m_braki[i >> 6] |= (quint64(1) << (i & 63));
+}
+
+/**
+ * @brief Dopisuje próbki innej serii na końcu.
+ *
+ * Kolumny są powiększane w miejscu, więc nieudostępniona seria nie jest kopiowana.
+ *
+ * @param nowsze Seria z późniejszymi próbkami.
+ */
+void SeriaPomiarowa::dolacz(const SeriaPomiarowa& nowsze) {
+    for (int i = 0; i < nowsze.rozmiar(); ++i)
+        dodajZ(nowsze, i);
+}
+
+/**
+ * @brief Scala serię z nowo pobranymi próbkami.
+ *
+ * Pozycja każdej starszej próbki wyszukiwana jest binarnie od miejsca poprzedniego trafienia,
+ * więc koszt zależy od liczby nowych próbek, a nie od długości historii.
+ *
+ * @param nowe Posortowana seria z nowymi próbkami.
+ * @param roznica Seria na nowe i zmienione próbki (może być nullptr).
+ * @return Wynik scalenia.
+ */
+SeriaPomiarowa::Scalenie SeriaPomiarowa::scal(const SeriaPomiarowa& nowe, SeriaPomiarowa* roznica) {
+    Q_ASSERT(m_posortowana && nowe.m_posortowana);
+
+    Scalenie wynik;
+    const int n = nowe.rozmiar();
+    const int stary = rozmiar();
+    QVector<int> doWstawienia;
+    int i = 0;
+    int j = 0;
+
+    if (stary > 0) {
+        const qint64 ostatni = m_czas[stary - 1];
+        for (; i < n && nowe.czas(i) <= ostatni; ++i) {
+            const qint64 czas = nowe.czas(i);
+            j = int(std::lower_bound(m_czas.constData() + j, m_czas.constData() + stary, czas) - m_czas.constData());
+
+            if (j < stary && m_czas[j] == czas) {
+                const bool brak = nowe.jestBrak(i);
+                if (brak == jestBrak(j) && (brak || m_wartosci[j] == nowe.wartosc(i)))
+                    continue;
+
+                m_wartosci[j] = brak ? 0.0f : nowe.wartosc(i);
+                if (brak)
+                    m_braki[j >> 6] |= (quint64(1) << (j & 63));
+                else
+                    m_braki[j >> 6] &= ~(quint64(1) << (j & 63));
+                ++wynik.zmienione;
+            } else {
+                doWstawienia.append(i);
+            }
+
+            if (roznica)
+                roznica->dodajZ(nowe, i);
+        }
+    }
+
+    for (; i < n; ++i) {
+        dodajZ(nowe, i);
+        if (roznica)
+            roznica->dodajZ(nowe, i);
+        ++wynik.dopisane;
+    }
+
+    if (!doWstawienia.isEmpty()) {
+        for (int k : doWstawienia)
+            dodajZ(nowe, k);
+        m_posortowana = false;
+        uporzadkuj();
+        wynik.wstawione = doWstawienia.size();
+    }
+
+    return wynik;
+}
+
+/**
+ * @brief Dopisuje próbkę z innej serii.
+ * @param zrodlo Seria źródłowa.
+ * @param i Indeks próbki.
+ */
+void SeriaPomiarowa::dodajZ(const SeriaPomiarowa& zrodlo, int i) {
+    if (zrodlo.jestBrak(i))
+        dodajBrak(zrodlo.czas(i));
+    else
+        dodaj(zrodlo.czas(i), zrodlo.wartosc(i));
+}
+
+/**
+ * @brief Sortuje próbki rosnąco po czasie.
+ *
+ * Przypadek serii ściśle malejącej (kolejność API) obsługiwany jest odwróceniem kolumn,
+ * w pozostałych przypadkach stosowane jest sortowanie stabilne permutacji indeksów.
+ */
+void SeriaPomiarowa::uporzadkuj() {
+    if (m_posortowana) return;
+
+    const int n = m_czas.size();
+    QVector<int> kolejnosc(n);
+    bool malejaca = true;
+    for (int i = 1; i < n && malejaca; ++i)
+        malejaca = m_czas[i] < m_czas[i - 1];
+
+    if (malejaca) {
+        for (int i = 0; i < n; ++i)
+            kolejnosc[i] = n - 1 - i;
+    } else {
+        std::iota(kolejnosc.begin(), kolejnosc.end(), 0);
+        std::stable_sort(kolejnosc.begin(), kolejnosc.end(), [this](int a, int b) {
+            return m_czas[a] < m_czas[b];
+        });
+    }
+
+    QVector<qint64> czas(n);
+    QVector<float> wartosci(n);
+    QVector<quint64> braki((n + 63) / 64, 0);
+    for (int i = 0; i < n; ++i) {
+        const int zrodlo = kolejnosc[i];
+        czas[i] = m_czas[zrodlo];
+        wartosci[i] = m_wartosci[zrodlo];
+        if (jestBrak(zrodlo))
+            braki[i >> 6] |= (quint64(1) << (i & 63));
+    }
+
+    m_czas.swap(czas);
+    m_wartosci.swap(wartosci);
+    m_braki.swap(braki);
+    m_posortowana = true;
+}
+
+/**
+ * @brief Sprawdza, czy seria jest posortowana.
+ * @return true jeśli próbki są w kolejności rosnącej.
+ */
+bool SeriaPomiarowa::jestPosortowana() const {
+    return m_posortowana;
+}
+
+/**
+ * @brief Zwraca widok na całą serię.
+ * @return Widok na wszystkie próbki.
+ */
+WidokSerii SeriaPomiarowa::calosc() const {
+    return WidokSerii(m_czas.constData(), m_wartosci.constData(), m_braki.constData(), 0, m_czas.size());
+}
+
+/**
+ * @brief Zwraca widok na próbki z przedziału czasu.
+ *
+ * Granice wyznaczane są przez std::lower_bound/std::upper_bound na kolumnie czasu.
+ *
+ * @param odMs Początek przedziału (włącznie).
+ * @param doMs Koniec przedziału (włącznie).
+ * @return Widok na próbki z przedziału.
+ */
+WidokSerii SeriaPomiarowa::zakres(qint64 odMs, qint64 doMs) const {
+    Q_ASSERT(m_posortowana);
+
+    const qint64* poczatek = m_czas.constData();
+    const qint64* koniec = poczatek + m_czas.size();
+    const int od = int(std::lower_bound(poczatek, koniec, odMs) - poczatek);
+    const int doIndeksu = int(std::upper_bound(poczatek, koniec, doMs) - poczatek);
+
+    return WidokSerii(m_czas.constData(), m_wartosci.constData(), m_braki.constData(),
+                      od, qMax(od, doIndeksu));
+}
+
+/**
+ * @brief Rezerwuje miejsce na próbki.
+ * @param liczba Oczekiwana liczba próbek.
+ */
+void SeriaPomiarowa::zarezerwuj(int liczba) {
+    m_czas.reserve(liczba);
+    m_wartosci.reserve(liczba);
+    m_braki.reserve((liczba + 63) / 64);
+}
+
+/**
+ * @brief Usuwa wszystkie próbki.
+ */
+void SeriaPomiarowa::wyczysc() {
+    m_czas.clear();
+    m_wartosci.clear();
+    m_braki.clear();
+    m_posortowana = true;
+}
+
+/**
+ * @brief Zwraca liczbę próbek.
+ * @return Liczba próbek.
+ */
+int SeriaPomiarowa::rozmiar() const {
+    return m_czas.size();
+}
+
+/**
+ * @brief Sprawdza, czy seria jest pusta.
+ * @return true jeśli brak próbek.
+ */
+bool SeriaPomiarowa::jestPusta() const {
+    return m_czas.isEmpty();
+}
+
+/**
+ * @brief Zwraca znacznik czasu próbki.
+ * @param i Indeks próbki.
+ * @return Milisekundy od epoki.
+ */
+qint64 SeriaPomiarowa::czas(int i) const {
+    return m_czas[i];
+}
+
+/**
+ * @brief Zwraca wartość próbki.
+ * @param i Indeks próbki.
+ * @return Wartość pomiaru.
+ */
+float SeriaPomiarowa::wartosc(int i) const {
+    return m_wartosci[i];
+}
+
+/**
+ * @brief Sprawdza, czy próbka nie ma wartości.
+ * @param i Indeks próbki.
+ * @return true jeśli brak wartości.
+ */
+bool SeriaPomiarowa::jestBrak(int i) const {
+    return (m_braki[i >> 6] >> (i & 63)) & 1;
+}
+
+/**
+ * @brief Zwraca kod parametru.
+ * @return Kod parametru.
+ */
+const QString& SeriaPomiarowa::parametr() const {
+    return m_parametr;
+}
+
+/**
+ * @brief Ustawia kod parametru.
+ * @param parametr Nowy kod parametru.
+ */
+void SeriaPomiarowa::setParametr(const QString& parametr) {
+    m_parametr = internuj(parametr);
+}
+
+/**
+ * @brief Zwraca próbkę jako obiekt DanePomiarowe.
+ * @param i Indeks próbki.
+ * @return Obiekt DanePomiarowe (wartość 0 dla braku danych).
+ */
+DanePomiarowe SeriaPomiarowa::pomiar(int i) const {
+    return DanePomiarowe(QDateTime::fromMSecsSinceEpoch(m_czas[i]), m_wartosci[i], m_parametr);
+}
+
+/**
+ * @brief Zwraca wskaźnik na tablicę znaczników czasu.
+ * @return Wskaźnik na dane.
+ */
+const qint64* SeriaPomiarowa::daneCzasu() const {
+    return m_czas.constData();
+}
+
+/**
+ * @brief Zwraca wskaźnik na tablicę wartości.
+ * @return Wskaźnik na dane.
+ */
+const float* SeriaPomiarowa::daneWartosci() const {
+    return m_wartosci.constData();
+}
+
+/**
+ * @brief Internuje kod parametru w globalnej puli.
+ *
+ * Kodów parametrów jest kilkanaście, więc pula nigdy nie rośnie znacząco.
+ *
+ * @param kod Kod parametru.
+ * @return Współdzielona kopia kodu.
+ */
+QString SeriaPomiarowa::internuj(const QString& kod) {
+    static QMutex mutex;
+    static QHash<QString, QString> pula;
+
+    QMutexLocker blokada(&mutex);
+    auto it = pula.constFind(kod);
+    if (it != pula.constEnd())
+        return it.value();
+    pula.insert(kod, kod);
+    return kod;
+}
@@ -0,0 +1,229 @@
+/**
+ * @file Seria_pomiarowa.h
+ * @brief Plik nagłówkowy klasy SeriaPomiarowa
+ *
+ * Klasa SeriaPomiarowa przechowuje szereg czasowy pomiarów jednego parametru w postaci kolumnowej:
+ * ciągłą tablicę znaczników czasu, tablicę wartości oraz mapę bitową braków danych.
+*/
+
+#ifndef SERIA_POMIAROWA_H
+#define SERIA_POMIAROWA_H
+
+#include <QVector>
+#include <QString>
+#include <QJsonObject>
+#include <QMetaType>
+
+#include "Dane_pomiarowe.h"
+#include "Widok_serii.h"
+
+/**
+ * @class SeriaPomiarowa
+ * @brief Kolumnowy szereg czasowy pomiarów jednego parametru.
+ *
+ * Zamiast tablicy obiektów JSON {date, value} seria przechowuje znaczniki czasu jako milisekundy
+ * od epoki (qint64), wartości jako float oraz jeden bit na próbkę oznaczający brak wartości.
+ * Kod parametru jest internowany, więc wszystkie serie tego samego parametru współdzielą jeden napis.
+ * Dane są współdzielone niejawnie (QVector), więc kopiowanie serii do wątku roboczego jest tanie.
+ * Seria utworzona przez fromJson() jest posortowana rosnąco po czasie, co pozwala wybierać zakresy
+ * dat wyszukiwaniem binarnym (zakres()).
+ */
+class SeriaPomiarowa
+{
+public:
+    /**
+     * @struct Scalenie
+     * @brief Wynik scalenia serii z nowszymi próbkami (scal()).
+     */
+    struct Scalenie {
+        int dopisane = 0;     /**< Próbki dopisane na końcu serii */
+        int zmienione = 0;    /**< Istniejące próbki, których wartość się zmieniła */
+        int wstawione = 0;    /**< Próbki wstawione w środek serii (wymagały sortowania) */
+    };
+
+    /**
+     * @brief Konstruktor domyślny.
+     *
+     * Tworzy pustą serię bez kodu parametru.
+     */
+    SeriaPomiarowa();
+
+    /**
+     * @brief Konstruktor inicjalizujący.
+     * @param parametr Kod parametru pomiarowego (np. PM10).
+     */
+    explicit SeriaPomiarowa(const QString& parametr);
+
+    /**
+     * @brief Tworzy serię z obiektu JSON w formacie {"key": ..., "values": [{"date", "value"}, ...]}.
+     * @param json Obiekt JSON z pomiarami.
+     * @return Seria utworzona na podstawie JSON.
+     */
+    static SeriaPomiarowa fromJson(const QJsonObject& json);
+
+    /**
+     * @brief Konwertuje serię do formatu JSON {"key": ..., "values": [...]}.
+     * @return Obiekt JSON reprezentujący serię.
+     */
+    QJsonObject toJson() const;
+
+    /**
+     * @brief Dodaje próbkę na koniec serii.
+     * @param czasMs Znacznik czasu w milisekundach od epoki.
+     * @param wartosc Zmierzona wartość.
+     */
+    void dodaj(qint64 czasMs, float wartosc);
+
+    /**
+     * @brief Dodaje na koniec serii próbkę bez wartości.
+     * @param czasMs Znacznik czasu w milisekundach od epoki.
+     */
+    void dodajBrak(qint64 czasMs);
+
+    /**
+     * @brief Dopisuje na koniec serii wszystkie próbki innej serii.
+     * @param nowsze Seria, której próbki są późniejsze od ostatniej próbki tej serii.
+     */
+    void dolacz(const SeriaPomiarowa& nowsze);
+
+    /**
+     * @brief Scala serię z nowo pobranymi próbkami, bez przebudowy serii.
+     * @param nowe Posortowana seria pobrana z API (zwykle okno z kilku ostatnich dni).
+     * @param roznica Opcjonalnie: seria, do której dopisywane są tylko nowe i zmienione próbki.
+     * @return Liczby próbek dopisanych, zmienionych i wstawionych.
+     *
+     * Próbki nowsze niż ostatnia próbka serii są dopisywane na końcu, a próbki o istniejącym
+     * czasie nadpisują wartość w miejscu. Tylko próbki brakujące w środku serii wymagają sortowania.
+     * Obie serie muszą być posortowane.
+     */
+    Scalenie scal(const SeriaPomiarowa& nowe, SeriaPomiarowa* roznica = nullptr);
+
+    /**
+     * @brief Sortuje próbki rosnąco po czasie, jeśli nie są już posortowane.
+     *
+     * Seria dostarczana przez API jest zwykle w kolejności malejącej, wtedy wystarcza odwrócenie kolumn.
+     */
+    void uporzadkuj();
+
+    /**
+     * @brief Sprawdza, czy próbki są posortowane rosnąco po czasie.
+     * @return true jeśli seria jest posortowana.
+     */
+    bool jestPosortowana() const;
+
+    /**
+     * @brief Zwraca widok na całą serię.
+     * @return Widok obejmujący wszystkie próbki.
+     */
+    WidokSerii calosc() const;
+
+    /**
+     * @brief Zwraca widok na próbki z przedziału czasu [od, do].
+     * @param odMs Początek przedziału (ms od epoki, włącznie).
+     * @param doMs Koniec przedziału (ms od epoki, włącznie).
+     * @return Widok na pasujące próbki.
+     *
+     * Wymaga posortowanej serii; koszt to O(log n), bez kopiowania danych.
+     */
+    WidokSerii zakres(qint64 odMs, qint64 doMs) const;
+
+    /**
+     * @brief Rezerwuje miejsce na podaną liczbę próbek.
+     * @param liczba Oczekiwana liczba próbek.
+     */
+    void zarezerwuj(int liczba);
+
+    /**
+     * @brief Usuwa wszystkie próbki (kod parametru pozostaje bez zmian).
+     */
+    void wyczysc();
+
+    /**
+     * @brief Zwraca liczbę próbek.
+     * @return Liczba próbek w serii.
+     */
+    int rozmiar() const;
+
+    /**
+     * @brief Sprawdza, czy seria jest pusta.
+     * @return true jeśli seria nie zawiera próbek.
+     */
+    bool jestPusta() const;
+
+    /**
+     * @brief Zwraca znacznik czasu próbki.
+     * @param i Indeks próbki.
+     * @return Milisekundy od epoki.
+     */
+    qint64 czas(int i) const;
+
+    /**
+     * @brief Zwraca wartość próbki.
+     * @param i Indeks próbki.
+     * @return Wartość (0 dla braku danych).
+     */
+    float wartosc(int i) const;
+
+    /**
+     * @brief Sprawdza, czy próbka nie ma wartości.
+     * @param i Indeks próbki.
+     * @return true jeśli brak wartości.
+     */
+    bool jestBrak(int i) const;
+
+    /**
+     * @brief Zwraca kod parametru pomiarowego.
+     * @return Kod parametru.
+     */
+    const QString& parametr() const;
+
+    /**
+     * @brief Ustawia kod parametru pomiarowego.
+     * @param parametr Nowy kod parametru (zostanie zinternowany).
+     */
+    void setParametr(const QString& parametr);
+
+    /**
+     * @brief Zwraca pojedynczą próbkę jako obiekt DanePomiarowe.
+     * @param i Indeks próbki.
+     * @return Obiekt DanePomiarowe.
+     */
+    DanePomiarowe pomiar(int i) const;
+
+    /**
+     * @brief Zwraca wskaźnik na ciągłą tablicę znaczników czasu.
+     * @return Wskaźnik na rozmiar() wartości qint64.
+     */
+    const qint64* daneCzasu() const;
+
+    /**
+     * @brief Zwraca wskaźnik na ciągłą tablicę wartości.
+     * @return Wskaźnik na rozmiar() wartości float.
+     */
+    const float* daneWartosci() const;
+
+private:
+    /**
+     * @brief Zwraca współdzieloną kopię kodu parametru z globalnej puli.
+     * @param kod Kod parametru.
+     * @return Internowany kod parametru.
+     */
+    static QString internuj(const QString& kod);
+
+    /**
+     * @brief Dopisuje na końcu próbkę z innej serii (z brakiem wartości włącznie).
+     * @param zrodlo Seria źródłowa.
+     * @param i Indeks próbki w serii źródłowej.
+     */
+    void dodajZ(const SeriaPomiarowa& zrodlo, int i);
+
+    QVector<qint64> m_czas;      /**< Znaczniki czasu (ms od epoki) */
+    QVector<float> m_wartosci;   /**< Wartości pomiarów */
+    QVector<quint64> m_braki;    /**< Mapa bitowa braków (bit ustawiony = brak wartości) */
+    QString m_parametr;          /**< Internowany kod parametru */
+    bool m_posortowana = true;   /**< Czy próbki są posortowane rosnąco po czasie */
+};
+
+Q_DECLARE_METATYPE(SeriaPomiarowa)
+
+#endif // SERIA_POMIAROWA_H
@@ -0,0 +1,537 @@
+/**
+ * @file Skorowidz_miejsc.cpp
+ * @brief Plik źródłowy klasy SkorowidzMiejsc
+ */
+
+#include "Skorowidz_miejsc.h"
+
+#include <QDebug>
+#include <QHash>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QStringList>
+#include <QTextStream>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+const char ZNACZNIK[4] = {'G', 'S', 'K', 'M'};
+const quint32 WERSJA = 1;
+const quint32 ZNACZNIK_KOLEJNOSCI = 0x01020304;
+const double SKALA_WSPOLRZEDNYCH = 1e6;
+const int KOLUMNY_GEONAMES = 11;   // kraj, kod, miejscowość, 3 x (nazwa, kod) podziału, szerokość, długość
+
+/**
+ * @struct Naglowek
+ * @brief Nagłówek pliku skorowidza.
+ */
+struct Naglowek {
+    char znacznik[4];            /**< "GSKM" */
+    quint32 wersja;              /**< Wersja formatu */
+    quint32 liczbaWpisow;        /**< Liczba wpisów tablicy */
+    quint32 kolejnoscBajtow;     /**< ZNACZNIK_KOLEJNOSCI zapisany natywnie */
+    qint64 rozmiarPuli;          /**< Rozmiar puli napisów w bajtach */
+    qint64 rozmiarPliku;         /**< Rozmiar pliku w bajtach */
+};
+
+static_assert(sizeof(Naglowek) == 32, "Nieoczekiwany rozmiar nagłówka skorowidza");
+
+/**
+ * @brief Porównuje bajtowo dwa napisy UTF-8 (kolejność zgodna z sortowaniem pliku).
+ */
+int porownaj(const char* a, int dlugoscA, const char* b, int dlugoscB) {
+    const int wynik = std::memcmp(a, b, size_t(qMin(dlugoscA, dlugoscB)));
+    if (wynik != 0)
+        return wynik;
+    return dlugoscA - dlugoscB;
+}
+}
+
+/**
+ * @brief Konstruktor klasy SkorowidzMiejsc.
+ */
+SkorowidzMiejsc::SkorowidzMiejsc()
+{
+    static_assert(sizeof(Wpis) == 32, "Nieoczekiwany rozmiar wpisu skorowidza");
+}
+
+/**
+ * @brief Destruktor klasy SkorowidzMiejsc.
+ */
+SkorowidzMiejsc::~SkorowidzMiejsc() {
+    zamknij();
+}
+
+/**
+ * @brief Normalizuje tekst do postaci klucza.
+ *
+ * @param tekst Tekst.
+ * @return Klucz.
+ */
+QString SkorowidzMiejsc::klucz(const QString& tekst) {
+    return tekst.toCaseFolded().simplified();
+}
+
+/**
+ * @brief Zapisuje skorowidz do pliku.
+ *
+ * Wpisy są sortowane bajtowo według klucza (stabilnie), a powtarzające się napisy
+ * (np. nazwy miejscowości ulic) trafiają do puli tylko raz.
+ *
+ * @param sciezka Ścieżka pliku docelowego.
+ * @param miejsca Wpisy.
+ * @return true jeśli zapis się powiódł.
+ */
+bool SkorowidzMiejsc::zapisz(const QString& sciezka, const QVector<Miejsce>& miejsca) {
+    struct Rekord {
+        QByteArray klucz;
+        const Miejsce* miejsce;
+    };
+
+    QVector<Rekord> rekordy;
+    rekordy.reserve(miejsca.size());
+    for (const Miejsce& m : miejsca) {
+        QString k = klucz(m.nazwa);
+        if (m.rodzaj == Ulica)
+            k = klucz(m.miejscowosc) + ", " + k;
+        rekordy.append(Rekord{k.toUtf8(), &m});
+    }
+    std::stable_sort(rekordy.begin(), rekordy.end(), [](const Rekord& a, const Rekord& b) {
+        return porownaj(a.klucz.constData(), a.klucz.size(), b.klucz.constData(), b.klucz.size()) < 0;
+    });
+
+    QByteArray pula;
+    QHash<QByteArray, quint32> wPuli;
+    auto dodajNapis = [&pula, &wPuli](const QByteArray& napis) -> quint32 {
+        auto it = wPuli.constFind(napis);
+        if (it != wPuli.constEnd())
+            return it.value();
+        const quint32 polozenie = quint32(pula.size());
+        pula.append(napis);
+        wPuli.insert(napis, polozenie);
+        return polozenie;
+    };
+
+    QVector<Wpis> wpisy;
+    wpisy.reserve(rekordy.size());
+    for (const Rekord& r : rekordy) {
+        const QByteArray nazwa = r.miejsce->nazwa.toUtf8();
+        const QByteArray miejscowosc = r.miejsce->miejscowosc.toUtf8();
+        if (r.klucz.isEmpty() || r.klucz.size() > 0xFFFF || nazwa.size() > 0xFFFF || miejscowosc.size() > 0xFFFF)
+            continue;
+
+        Wpis w;
+        std::memset(&w, 0, sizeof(Wpis));
+        w.przesuniecieKlucza = dodajNapis(r.klucz);
+        w.przesuniecieNazwy = dodajNapis(nazwa);
+        w.przesuniecieMiejscowosci = dodajNapis(miejscowosc);
+        w.dlugoscKlucza = quint16(r.klucz.size());
+        w.dlugoscNazwy = quint16(nazwa.size());
+        w.dlugoscMiejscowosci = quint16(miejscowosc.size());
+        w.rodzaj = quint8(r.miejsce->rodzaj);
+        w.lat = qRound(r.miejsce->lat * SKALA_WSPOLRZEDNYCH);
+        w.lon = qRound(r.miejsce->lon * SKALA_WSPOLRZEDNYCH);
+        wpisy.append(w);
+    }
+
+    if (qint64(pula.size()) > qint64(0xFFFFFFFFu)) {
+        qWarning() << "Pula napisów skorowidza jest zbyt duża";
+        return false;
+    }
+
+    Naglowek naglowek;
+    std::memcpy(naglowek.znacznik, ZNACZNIK, 4);
+    naglowek.wersja = WERSJA;
+    naglowek.liczbaWpisow = quint32(wpisy.size());
+    naglowek.kolejnoscBajtow = ZNACZNIK_KOLEJNOSCI;
+    naglowek.rozmiarPuli = pula.size();
+    naglowek.rozmiarPliku = qint64(sizeof(Naglowek)) + qint64(wpisy.size()) * sizeof(Wpis) + pula.size();
+
+    QSaveFile plik(sciezka);
+    if (!plik.open(QIODevice::WriteOnly))
+        return false;
+
+    plik.write(reinterpret_cast<const char*>(&naglowek), sizeof(Naglowek));
+    plik.write(reinterpret_cast<const char*>(wpisy.constData()), qint64(wpisy.size()) * sizeof(Wpis));
+    plik.write(pula);
+    return plik.commit();
+}
+
+/**
+ * @brief Odczytuje wpisy z pliku kodów pocztowych GeoNames.
+ *
+ * Każdy wiersz daje wpis kodu pocztowego. Miejscowość jest identyfikowana nazwą i województwem,
+ * a jej współrzędne to średnia współrzędnych jej kodów pocztowych.
+ *
+ * @param urzadzenie Urządzenie źródłowe.
+ * @return Wpisy skorowidza.
+ */
+QVector<SkorowidzMiejsc::Miejsce> SkorowidzMiejsc::zGeoNames(QIODevice* urzadzenie) {
+    struct Srodek {
+        Miejsce miejsce;
+        double sumaLat = 0.0;
+        double sumaLon = 0.0;
+        int liczba = 0;
+    };
+
+    QVector<Miejsce> wynik;
+    QVector<Srodek> miejscowosci;
+    QHash<QString, int> indeksMiejscowosci;
+
+    QTextStream strumien(urzadzenie);
+    strumien.setEncoding(QStringConverter::Utf8);
+    QString wiersz;
+    while (strumien.readLineInto(&wiersz)) {
+        const QStringList kolumny = wiersz.split('\t');
+        if (kolumny.size() < KOLUMNY_GEONAMES)
+            continue;
+
+        bool okLat = false;
+        bool okLon = false;
+        Miejsce kod;
+        kod.rodzaj = KodPocztowy;
+        kod.nazwa = kolumny[1].trimmed();
+        kod.miejscowosc = kolumny[2].trimmed();
+        kod.lat = kolumny[9].toDouble(&okLat);
+        kod.lon = kolumny[10].toDouble(&okLon);
+        if (!okLat || !okLon || kod.nazwa.isEmpty() || kod.miejscowosc.isEmpty())
+            continue;
+        wynik.append(kod);
+
+        const QString identyfikator = klucz(kod.miejscowosc) + '\t' + kolumny[3].trimmed();
+        auto it = indeksMiejscowosci.constFind(identyfikator);
+        if (it == indeksMiejscowosci.constEnd()) {
+            it = indeksMiejscowosci.insert(identyfikator, miejscowosci.size());
+            Srodek srodek;
+            srodek.miejsce.nazwa = kod.miejscowosc;
+            miejscowosci.append(srodek);
+        }
+        Srodek& srodek = miejscowosci[it.value()];
+        srodek.sumaLat += kod.lat;
+        srodek.sumaLon += kod.lon;
+        ++srodek.liczba;
+    }
+
+    wynik.reserve(wynik.size() + miejscowosci.size());
+    for (Srodek& srodek : miejscowosci) {
+        srodek.miejsce.lat = srodek.sumaLat / srodek.liczba;
+        srodek.miejsce.lon = srodek.sumaLon / srodek.liczba;
+        wynik.append(srodek.miejsce);
+    }
+    return wynik;
+}
+
+/**
+ * @brief Otwiera i mapuje plik skorowidza.
+ *
+ * Sprawdzany jest nagłówek oraz to, czy wszystkie napisy wpisów mieszczą się w puli.
+ *
+ * @param sciezka Ścieżka pliku.
+ * @return true jeśli plik ma poprawny format.
+ */
+bool SkorowidzMiejsc::otworz(const QString& sciezka) {
+    zamknij();
+
+    m_plik.setFileName(sciezka);
+    if (!m_plik.open(QIODevice::ReadOnly) || m_plik.size() < qint64(sizeof(Naglowek))) {
+        m_plik.close();
+        return false;
+    }
+
+    const qint64 rozmiar = m_plik.size();
+    uchar* mapa = m_plik.map(0, rozmiar);
+    if (!mapa) {
+        m_plik.close();
+        return false;
+    }
+
+    const Naglowek* naglowek = reinterpret_cast<const Naglowek*>(mapa);
+    const qint64 poczatekPuli = qint64(sizeof(Naglowek)) + qint64(naglowek->liczbaWpisow) * qint64(sizeof(Wpis));
+    bool poprawny = std::memcmp(naglowek->znacznik, ZNACZNIK, 4) == 0 &&
+                    naglowek->wersja == WERSJA &&
+                    naglowek->kolejnoscBajtow == ZNACZNIK_KOLEJNOSCI &&
+                    naglowek->rozmiarPliku == rozmiar &&
+                    naglowek->rozmiarPuli >= 0 &&
+                    poczatekPuli + naglowek->rozmiarPuli == rozmiar;
+
+    const Wpis* wpisy = reinterpret_cast<const Wpis*>(mapa + sizeof(Naglowek));
+    const qint64 pula = naglowek->rozmiarPuli;
+    for (quint32 i = 0; poprawny && i < naglowek->liczbaWpisow; ++i) {
+        const Wpis& w = wpisy[i];
+        poprawny = w.rodzaj <= Ulica &&
+                   qint64(w.przesuniecieKlucza) + w.dlugoscKlucza <= pula &&
+                   qint64(w.przesuniecieNazwy) + w.dlugoscNazwy <= pula &&
+                   qint64(w.przesuniecieMiejscowosci) + w.dlugoscMiejscowosci <= pula;
+    }
+
+    if (!poprawny) {
+        qWarning() << "Nieprawidłowy plik skorowidza miejsc:" << sciezka;
+        m_plik.unmap(mapa);
+        m_plik.close();
+        return false;
+    }
+
+    m_mapa = mapa;
+    m_wpisy = wpisy;
+    m_napisy = reinterpret_cast<const char*>(mapa + poczatekPuli);
+    m_liczbaWpisow = int(naglowek->liczbaWpisow);
+    return true;
+}
+
+/**
+ * @brief Usuwa mapowanie i zamyka plik.
+ */
+void SkorowidzMiejsc::zamknij() {
+    if (m_mapa)
+        m_plik.unmap(const_cast<uchar*>(m_mapa));
+    m_plik.close();
+    m_mapa = nullptr;
+    m_wpisy = nullptr;
+    m_napisy = nullptr;
+    m_liczbaWpisow = 0;
+}
+
+/**
+ * @brief Sprawdza, czy skorowidz jest otwarty.
+ * @return true jeśli plik jest zmapowany.
+ */
+bool SkorowidzMiejsc::jestOtwarty() const {
+    return m_mapa != nullptr;
+}
+
+/**
+ * @brief Zwraca liczbę wpisów.
+ * @return Liczba wpisów.
+ */
+int SkorowidzMiejsc::rozmiar() const {
+    return m_liczbaWpisow;
+}
+
+/**
+ * @brief Wyszukuje pierwszy wpis o danym kluczu i rodzaju.
+ *
+ * @param tekst Klucz przed normalizacją.
+ * @param rodzaj Rodzaj wpisu.
+ * @param wynik Struktura wynikowa.
+ * @return true jeśli wpis istnieje.
+ */
+bool SkorowidzMiejsc::znajdz(const QString& tekst, Rodzaj rodzaj, Miejsce* wynik) const {
+    const QByteArray k = klucz(tekst).toUtf8();
+    if (k.isEmpty())
+        return false;
+
+    for (int i = dolnaGranica(k); i < m_liczbaWpisow; ++i) {
+        const Wpis& w = m_wpisy[i];
+        if (porownaj(m_napisy + w.przesuniecieKlucza, w.dlugoscKlucza, k.constData(), k.size()) != 0)
+            return false;
+        if (w.rodzaj == rodzaj) {
+            *wynik = miejsce(w);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Zlicza wpisy o danym kluczu i rodzaju.
+ *
+ * Wpisy o tym samym kluczu leżą w tablicy obok siebie, więc przeglądany jest tylko ich ciąg.
+ *
+ * @param tekst Klucz przed normalizacją.
+ * @param rodzaj Rodzaj wpisu.
+ * @param miejscowosc Wymagana miejscowość wpisu (pusta - dowolna).
+ * @param wynik Pierwszy pasujący wpis.
+ * @return Liczba pasujących wpisów.
+ */
+int SkorowidzMiejsc::dopasuj(const QString& tekst, Rodzaj rodzaj, const QString& miejscowosc, Miejsce* wynik) const {
+    const QByteArray k = klucz(tekst).toUtf8();
+    const QString kluczMiejscowosci = klucz(miejscowosc);
+    if (k.isEmpty())
+        return 0;
+
+    int liczba = 0;
+    for (int i = dolnaGranica(k); i < m_liczbaWpisow; ++i) {
+        const Wpis& w = m_wpisy[i];
+        if (porownaj(m_napisy + w.przesuniecieKlucza, w.dlugoscKlucza, k.constData(), k.size()) != 0)
+            break;
+        if (w.rodzaj != rodzaj)
+            continue;
+        if (!kluczMiejscowosci.isEmpty() &&
+            klucz(QString::fromUtf8(m_napisy + w.przesuniecieMiejscowosci, w.dlugoscMiejscowosci)) != kluczMiejscowosci)
+            continue;
+        if (liczba++ == 0)
+            *wynik = miejsce(w);
+    }
+    return liczba;
+}
+
+/**
+ * @brief Zwraca wpisy o kluczu zaczynającym się od prefiksu.
+ *
+ * @param prefiks Prefiks.
+ * @param limit Maksymalna liczba wyników.
+ * @return Wpisy.
+ */
+QVector<SkorowidzMiejsc::Miejsce> SkorowidzMiejsc::zPrefiksem(const QString& prefiks, int limit) const {
+    QVector<Miejsce> wynik;
+    const QByteArray p = klucz(prefiks).toUtf8();
+    if (p.isEmpty())
+        return wynik;
+
+    for (int i = dolnaGranica(p); i < m_liczbaWpisow && wynik.size() < limit; ++i) {
+        if (!zaczynaSieOd(m_wpisy[i], p))
+            break;
+        wynik.append(miejsce(m_wpisy[i]));
+    }
+    return wynik;
+}
+
+/**
+ * @brief Rozpoznaje adres.
+ *
+ * Z adresu wyodrębniany jest kod pocztowy i numer budynku. Część z numerem budynku jest ulicą
+ * i nie może być miejscowością. Jeśli adres ma numer ("Polanka 3, Poznań"), miejscowością jest
+ * ostatnia z pozostałych części znana skorowidzowi; bez numeru ("Poznań, Polanka") - pierwsza.
+ * Pozostałe części są traktowane jako ulica.
+ * Wynikiem jest najdokładniejszy znaleziony wpis: ulica, kod pocztowy albo miejscowość.
+ * Kod pocztowy obejmujący kilka miejscowości jest zawężany do miejscowości z adresu.
+ * Jeśli wynikowi pasuje więcej niż jeden wpis, rozpoznanie nie jest dokładne.
+ *
+ * @param adres Adres.
+ * @return Wynik rozpoznania.
+ */
+SkorowidzMiejsc::Rozpoznanie SkorowidzMiejsc::rozwiaz(const QString& adres) const {
+    Rozpoznanie wynik;
+    if (!jestOtwarty())
+        return wynik;
+
+    static const QRegularExpression wzorKodu("\\b(\\d{2}-\\d{3})\\b");
+    static const QRegularExpression wzorNumeru("^(.*\\S)\\s+\\d+\\w*(/\\d+\\w*)?$");
+
+    QString kod;
+    bool numer = false;
+    QStringList czesci;
+    QVector<bool> zNumerem;
+    for (QString czesc : adres.split(',', Qt::SkipEmptyParts)) {
+        const QRegularExpressionMatch dopasowanieKodu = wzorKodu.match(czesc);
+        if (dopasowanieKodu.hasMatch()) {
+            kod = dopasowanieKodu.captured(1);
+            czesc.remove(dopasowanieKodu.capturedStart(1), dopasowanieKodu.capturedLength(1));
+        }
+        czesc = czesc.simplified();
+
+        const QRegularExpressionMatch dopasowanieNumeru = wzorNumeru.match(czesc);
+        if (dopasowanieNumeru.hasMatch()) {
+            numer = true;
+            czesc = dopasowanieNumeru.captured(1);
+        }
+        if (!czesc.isEmpty()) {
+            czesci.append(czesc);
+            zNumerem.append(dopasowanieNumeru.hasMatch());
+        }
+    }
+
+    // Kandydaci na miejscowość: części bez numeru budynku, od ostatniej, jeśli ulicę wskazał numer.
+    QVector<int> kandydaci;
+    for (int i = 0; i < czesci.size(); ++i) {
+        if (!zNumerem[i])
+            kandydaci.append(i);
+    }
+    if (numer)
+        std::reverse(kandydaci.begin(), kandydaci.end());
+
+    Miejsce m;
+    QString miasto;
+    int indeksMiasta = -1;
+    int pasujace = 0;
+    for (int k = 0; k < kandydaci.size() && indeksMiasta < 0; ++k) {
+        const int i = kandydaci[k];
+        const int liczba = dopasuj(czesci[i], Miejscowosc, QString(), &m);
+        if (liczba > 0) {
+            indeksMiasta = i;
+            miasto = czesci[i];
+            wynik.znaleziono = true;
+            wynik.miejsce = m;
+            pasujace = liczba;
+        }
+    }
+
+    if (!kod.isEmpty()) {
+        int liczba = miasto.isEmpty() ? 0 : dopasuj(kod, KodPocztowy, miasto, &m);
+        if (liczba == 0)
+            liczba = dopasuj(kod, KodPocztowy, QString(), &m);
+        if (liczba > 0) {
+            if (miasto.isEmpty())
+                miasto = m.miejscowosc;
+            wynik.znaleziono = true;
+            wynik.miejsce = m;
+            pasujace = liczba;
+        }
+    }
+
+    bool ulicaPodana = false;
+    bool ulicaZnaleziona = false;
+    for (int i = 0; i < czesci.size() && !ulicaZnaleziona; ++i) {
+        if (i == indeksMiasta)
+            continue;
+        ulicaPodana = true;
+        const int liczba = miasto.isEmpty() ? 0 : dopasuj(miasto + ", " + czesci[i], Ulica, QString(), &m);
+        if (liczba > 0) {
+            ulicaZnaleziona = true;
+            wynik.znaleziono = true;
+            wynik.miejsce = m;
+            pasujace = liczba;
+        }
+    }
+
+    wynik.dokladne = wynik.znaleziono && pasujace == 1 && !numer && (!ulicaPodana || ulicaZnaleziona);
+    return wynik;
+}
+
+/**
+ * @brief Wyszukuje binarnie pierwszy wpis o kluczu nie mniejszym niż podany.
+ *
+ * @param klucz Klucz w UTF-8.
+ * @return Indeks wpisu.
+ */
+int SkorowidzMiejsc::dolnaGranica(const QByteArray& klucz) const {
+    int lewy = 0;
+    int prawy = m_liczbaWpisow;
+    while (lewy < prawy) {
+        const int srodek = lewy + (prawy - lewy) / 2;
+        const Wpis& w = m_wpisy[srodek];
+        if (porownaj(m_napisy + w.przesuniecieKlucza, w.dlugoscKlucza, klucz.constData(), klucz.size()) < 0)
+            lewy = srodek + 1;
+        else
+            prawy = srodek;
+    }
+    return lewy;
+}
+
+/**
+ * @brief Sprawdza, czy klucz wpisu zaczyna się od prefiksu.
+ *
+ * @param w Wpis.
+ * @param prefiks Prefiks w UTF-8.
+ * @return true jeśli klucz zaczyna się od prefiksu.
+ */
+bool SkorowidzMiejsc::zaczynaSieOd(const Wpis& w, const QByteArray& prefiks) const {
+    return w.dlugoscKlucza >= prefiks.size() &&
+           std::memcmp(m_napisy + w.przesuniecieKlucza, prefiks.constData(), size_t(prefiks.size())) == 0;
+}
+
+/**
+ * @brief Dekoduje wpis tablicy.
+ *
+ * @param w Wpis.
+ * @return Miejsce.
+ */
+SkorowidzMiejsc::Miejsce SkorowidzMiejsc::miejsce(const Wpis& w) const {
+    Miejsce m;
+    m.rodzaj = Rodzaj(w.rodzaj);
+    m.nazwa = QString::fromUtf8(m_napisy + w.przesuniecieNazwy, w.dlugoscNazwy);
+    m.miejscowosc = QString::fromUtf8(m_napisy + w.przesuniecieMiejscowosci, w.dlugoscMiejscowosci);
+    m.lat = w.lat / SKALA_WSPOLRZEDNYCH;
+    m.lon = w.lon / SKALA_WSPOLRZEDNYCH;
+    return m;
+}
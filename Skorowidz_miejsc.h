@@ -0,0 +1,213 @@
+/**
+ * @file Skorowidz_miejsc.h
+ * @brief Plik nagłówkowy klasy SkorowidzMiejsc
+ *
+ * Klasa SkorowidzMiejsc udostępnia wbudowany, offline'owy skorowidz polskich kodów pocztowych,
+ * miejscowości i ulic (środki obszarów) zapisany w posortowanej tablicy binarnej.
+*/
+
+#ifndef SKOROWIDZ_MIEJSC_H
+#define SKOROWIDZ_MIEJSC_H
+
+#include <QFile>
+#include <QIODevice>
+#include <QString>
+#include <QVector>
+
+/**
+ * @class SkorowidzMiejsc
+ * @brief Zmapowany do pamięci skorowidz miejsc (plik "*.skm") z wyszukiwaniem po prefiksie.
+ *
+ * Plik składa się z nagłówka, tablicy wpisów posortowanej bajtowo według klucza (UTF-8)
+ * i puli napisów. Kluczem jest kod pocztowy ("60-695"), nazwa miejscowości ("poznań")
+ * albo miejscowość i ulica ("poznań, polanka"), zawsze po normalizacji (klucz()).
+ * Wyszukiwanie to wyszukiwanie binarne w zmapowanej tablicy, bez alokacji na stercie
+ * poza zwracanymi wynikami. Wpisy o tym samym kluczu zachowują kolejność z pliku.
+ */
+class SkorowidzMiejsc
+{
+public:
+    /**
+     * @enum Rodzaj
+     * @brief Rodzaj wpisu skorowidza (od najmniej do najbardziej dokładnego).
+     */
+    enum Rodzaj {
+        Miejscowosc = 0,    /**< Środek miejscowości */
+        KodPocztowy = 1,    /**< Środek obszaru kodu pocztowego */
+        Ulica = 2           /**< Środek ulicy w miejscowości */
+    };
+
+    /**
+     * @struct Miejsce
+     * @brief Wpis skorowidza.
+     */
+    struct Miejsce {
+        Rodzaj rodzaj = Miejscowosc;   /**< Rodzaj wpisu */
+        QString nazwa;                 /**< Nazwa miejscowości, kod pocztowy albo nazwa ulicy */
+        QString miejscowosc;           /**< Miejscowość kodu pocztowego lub ulicy (pusta dla miejscowości) */
+        double lat = 0.0;              /**< Szerokość geograficzna (WGS84) */
+        double lon = 0.0;              /**< Długość geograficzna (WGS84) */
+    };
+
+    /**
+     * @struct Rozpoznanie
+     * @brief Wynik rozpoznania adresu w skorowidzu.
+     */
+    struct Rozpoznanie {
+        bool znaleziono = false;   /**< Czy rozpoznano choć część adresu */
+        bool dokladne = false;     /**< Czy wynik ma dokładność, o którą pyta adres (brak numeru budynku, nieznanej ulicy i kilku pasujących wpisów) */
+        Miejsce miejsce;           /**< Najdokładniejszy rozpoznany wpis */
+    };
+
+    /**
+     * @brief Konstruktor domyślny; tworzy zamknięty skorowidz.
+     */
+    SkorowidzMiejsc();
+
+    /**
+     * @brief Destruktor; usuwa mapowanie pliku.
+     */
+    ~SkorowidzMiejsc();
+
+    SkorowidzMiejsc(const SkorowidzMiejsc&) = delete;
+    SkorowidzMiejsc& operator=(const SkorowidzMiejsc&) = delete;
+
+    /**
+     * @brief Sprowadza tekst do postaci klucza skorowidza.
+     * @param tekst Nazwa lub zapytanie.
+     * @return Tekst bez rozróżniania wielkości liter, z pojedynczymi odstępami.
+     */
+    static QString klucz(const QString& tekst);
+
+    /**
+     * @brief Zapisuje skorowidz do nowego pliku (narzędzie budujące dane).
+     * @param sciezka Ścieżka pliku docelowego.
+     * @param miejsca Wpisy w dowolnej kolejności.
+     * @return true jeśli zapis się powiódł.
+     *
+     * Współrzędne są zaokrąglane do 10⁻⁶ stopnia (ok. 0,1 m).
+     */
+    static bool zapisz(const QString& sciezka, const QVector<Miejsce>& miejsca);
+
+    /**
+     * @brief Odczytuje wpisy z pliku kodów pocztowych GeoNames (np. PL.txt z export/zip).
+     * @param urzadzenie Otwarte do odczytu urządzenie z wierszami TSV (kraj, kod, miejscowość,
+     *                   województwo, ..., szerokość w kolumnie 10, długość w kolumnie 11).
+     * @return Wpisy kodów pocztowych oraz miejscowości (środek jej kodów, osobno dla każdego województwa).
+     *
+     * Wiersze niepełne lub bez poprawnych współrzędnych są pomijane. GeoNames nie zawiera ulic,
+     * więc wynik nie ma wpisów Ulica, a adresy z ulicą rozpoznaje geokoder.
+     */
+    static QVector<Miejsce> zGeoNames(QIODevice* urzadzenie);
+
+    /**
+     * @brief Otwiera i mapuje plik skorowidza.
+     * @param sciezka Ścieżka pliku.
+     * @return true jeśli plik ma poprawny format.
+     */
+    bool otworz(const QString& sciezka);
+
+    /**
+     * @brief Usuwa mapowanie i zamyka plik.
+     */
+    void zamknij();
+
+    /**
+     * @brief Sprawdza, czy skorowidz jest otwarty.
+     * @return true jeśli plik jest zmapowany.
+     */
+    bool jestOtwarty() const;
+
+    /**
+     * @brief Zwraca liczbę wpisów.
+     * @return Liczba wpisów (0 dla zamkniętego skorowidza).
+     */
+    int rozmiar() const;
+
+    /**
+     * @brief Wyszukuje wpis o podanym kluczu i rodzaju.
+     * @param tekst Kod pocztowy, miejscowość lub "miejscowość, ulica" (nie musi być znormalizowany).
+     * @param rodzaj Rodzaj wpisu.
+     * @param wynik Wskaźnik na strukturę wynikową.
+     * @return true jeśli wpis istnieje.
+     */
+    bool znajdz(const QString& tekst, Rodzaj rodzaj, Miejsce* wynik) const;
+
+    /**
+     * @brief Zwraca wpisy, których klucz zaczyna się od prefiksu (np. do podpowiedzi).
+     * @param prefiks Początek nazwy lub kodu.
+     * @param limit Maksymalna liczba wyników.
+     * @return Wpisy w kolejności kluczy.
+     */
+    QVector<Miejsce> zPrefiksem(const QString& prefiks, int limit = 10) const;
+
+    /**
+     * @brief Rozpoznaje adres w jednym z formatów "Ulica 3, Miasto", "00-000 Miasto, Ulica 3", "Miasto, Ulica".
+     * @param adres Adres wpisany przez użytkownika.
+     * @return Najdokładniejszy wpis, jaki udało się dopasować.
+     *
+     * Adres z numerem budynku nigdy nie jest dokładny, bo skorowidz zna tylko środki ulic.
+     * Wynik nie jest też dokładny, gdy nazwie pasuje kilka wpisów (np. miejscowości o tej samej
+     * nazwie w różnych województwach), których nie rozróżnia kod pocztowy.
+     */
+    Rozpoznanie rozwiaz(const QString& adres) const;
+
+private:
+    /**
+     * @struct Wpis
+     * @brief Wpis tablicy (układ zgodny z plikiem).
+     */
+    struct Wpis {
+        quint32 przesuniecieKlucza;       /**< Położenie klucza w puli napisów */
+        quint32 przesuniecieNazwy;        /**< Położenie nazwy w puli napisów */
+        quint32 przesuniecieMiejscowosci; /**< Położenie nazwy miejscowości w puli napisów */
+        quint16 dlugoscKlucza;            /**< Długość klucza w bajtach */
+        quint16 dlugoscNazwy;             /**< Długość nazwy w bajtach */
+        quint16 dlugoscMiejscowosci;      /**< Długość nazwy miejscowości w bajtach */
+        quint8 rodzaj;                    /**< Rodzaj wpisu */
+        quint8 zarezerwowane;             /**< Do przyszłego użycia */
+        qint32 lat;                       /**< Szerokość [10⁻⁶ stopnia] */
+        qint32 lon;                       /**< Długość [10⁻⁶ stopnia] */
+        quint32 zarezerwowane2;           /**< Wyrównanie do 32 bajtów */
+    };
+
+    /**
+     * @brief Zlicza wpisy o podanym kluczu i rodzaju.
+     * @param tekst Klucz (nie musi być znormalizowany).
+     * @param rodzaj Rodzaj wpisu.
+     * @param miejscowosc Jeśli niepusta: tylko wpisy z tą miejscowością.
+     * @param wynik Wskaźnik na pierwszy pasujący wpis (wynik).
+     * @return Liczba pasujących wpisów.
+     */
+    int dopasuj(const QString& tekst, Rodzaj rodzaj, const QString& miejscowosc, Miejsce* wynik) const;
+
+    /**
+     * @brief Zwraca pierwszy wpis o kluczu nie mniejszym niż podany.
+     * @param klucz Klucz w UTF-8.
+     * @return Indeks wpisu (rozmiar() jeśli takiego nie ma).
+     */
+    int dolnaGranica(const QByteArray& klucz) const;
+
+    /**
+     * @brief Sprawdza, czy klucz wpisu zaczyna się od podanych bajtów.
+     * @param w Wpis.
+     * @param prefiks Prefiks w UTF-8.
+     * @return true jeśli klucz zaczyna się od prefiksu.
+     */
+    bool zaczynaSieOd(const Wpis& w, const QByteArray& prefiks) const;
+
+    /**
+     * @brief Dekoduje wpis tablicy.
+     * @param w Wpis.
+     * @return Miejsce z nazwami i współrzędnymi.
+     */
+    Miejsce miejsce(const Wpis& w) const;
+
+    QFile m_plik;                      /**< Plik skorowidza */
+    const uchar* m_mapa = nullptr;     /**< Początek zmapowanego pliku */
+    const Wpis* m_wpisy = nullptr;     /**< Tablica wpisów (w zmapowanym pliku) */
+    const char* m_napisy = nullptr;    /**< Pula napisów (w zmapowanym pliku) */
+    int m_liczbaWpisow = 0;            /**< Liczba wpisów */
+};
+
+#endif // SKOROWIDZ_MIEJSC_H
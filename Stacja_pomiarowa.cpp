@@ -33,28 +33,35 @@ StacjaPomiarowa::StacjaPomiarowa(int id, const QString& nazwa, double latitude,
 /**
  * @brief Tworzy obiekt StacjaPomiarowa na podstawie danych JSON.
  *
- * Oczekiwane pola JSON:
- * - "id": identyfikator stacji,
- * - "stationName": nazwa stacji,
- * - "gegrLat": szerokość geograficzna (jako string),
- * - "gegrLon": długość geograficzna (jako string),
- * - "city": obiekt zawierający pole "name" z nazwą miasta,
- * - "addressStreet": nazwa ulicy.
+ * Obsługiwane są klucze API v1 oraz starsze klucze (w nawiasach), używane gdy pole v1 jest puste:
+ * - "Identyfikator stacji" ("id"): identyfikator stacji,
+ * - "Nazwa stacji" ("stationName"): nazwa stacji,
+ * - "WGS84 φ N" ("gegrLat"): szerokość geograficzna (jako string),
+ * - "WGS84 λ E" ("gegrLon"): długość geograficzna (jako string),
+ * - "Nazwa miasta" (obiekt "city" z polem "name"): nazwa miasta,
+ * - "Ulica" ("addressStreet"): nazwa ulicy.
  *
  * @param json Obiekt QJsonObject zawierający dane stacji.
  * @return Obiekt StacjaPomiarowa utworzony z JSON.
  */
 StacjaPomiarowa StacjaPomiarowa::fromJson(const QJsonObject& json) {
-    int id = json["id"].toInt();
-    QString nazwa = json["stationName"].toString();
+    int id = json["Identyfikator stacji"].toInt();
+    if (id == 0) id = json["id"].toInt();
 
-    double lat = json["gegrLat"].toString().toDouble();
-    double lon = json["gegrLon"].toString().toDouble();
+    QString nazwa = json["Nazwa stacji"].toString();
+    if (nazwa.isEmpty()) nazwa = json["stationName"].toString();
 
-    QJsonObject cityObj = json["city"].toObject();
-    QString miasto = cityObj["name"].toString();
+    double lat = json[QString::fromUtf8("WGS84 \xCF\x86 N")].toString().toDouble();
+    if (qFuzzyIsNull(lat)) lat = json["gegrLat"].toString().toDouble();
 
-    QString ulica = json["addressStreet"].toString();
+    double lon = json[QString::fromUtf8("WGS84 \xCE\xBB E")].toString().toDouble();
+    if (qFuzzyIsNull(lon)) lon = json["gegrLon"].toString().toDouble();
+
+    QString miasto = json["Nazwa miasta"].toString();
+    if (miasto.isEmpty()) miasto = json["city"].toObject()["name"].toString();
+
+    QString ulica = json["Ulica"].toString();
+    if (ulica.isEmpty()) ulica = json["addressStreet"].toString();
 
     return StacjaPomiarowa(id, nazwa, lat, lon, miasto, ulica);
 }
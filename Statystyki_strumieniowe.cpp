@@ -0,0 +1,361 @@
+/**
+ * @file Statystyki_strumieniowe.cpp
+ * @brief Plik źródłowy klasy StatystykiStrumieniowe
+ */
+
+#include "Statystyki_strumieniowe.h"
+
+#include <QtMath>
+
+#include <algorithm>
+
+namespace {
+const double MS_NA_GODZINE = 3600.0 * 1000.0;
+const double KWANTYLE[3] = {0.5, 0.9, 0.98};
+const qint64 OKNA_MS[3] = {1 * 3600 * 1000LL, 8 * 3600 * 1000LL, 24 * 3600 * 1000LL};
+}
+
+/**
+ * @brief Konstruktor domyślny klasy StatystykiStrumieniowe.
+ */
+StatystykiStrumieniowe::StatystykiStrumieniowe() {
+    wyczysc();
+}
+
+/**
+ * @brief Buduje statystyki ze wszystkich próbek widoku.
+ *
+ * @param widok Widok na serię.
+ * @return StatystykiStrumieniowe Statystyki widoku.
+ */
+StatystykiStrumieniowe StatystykiStrumieniowe::zWidoku(const WidokSerii& widok) {
+    StatystykiStrumieniowe statystyki;
+    statystyki.dodaj(widok);
+    return statystyki;
+}
+
+/**
+ * @brief Uwzględnia kolejną próbkę we wszystkich statystykach.
+ *
+ * @param czasMs Znacznik czasu próbki.
+ * @param wartosc Wartość pomiaru.
+ * @return true jeśli próbka została dodana.
+ */
+bool StatystykiStrumieniowe::dodaj(qint64 czasMs, double wartosc) {
+    if (m_liczba > 0 && czasMs <= m_ostatniCzas)
+        return false;
+
+    if (m_liczba == 0) {
+        m_pierwszyCzas = czasMs;
+        m_min = m_max = wartosc;
+        m_czasMin = m_czasMax = czasMs;
+    } else if (wartosc < m_min) {
+        m_min = wartosc;
+        m_czasMin = czasMs;
+    } else if (wartosc > m_max) {
+        m_max = wartosc;
+        m_czasMax = czasMs;
+    }
+    m_ostatniCzas = czasMs;
+    ++m_liczba;
+
+    // Welford: średnie i sumy odchyleń bez sum kwadratów, które tracą precyzję przy dużych wartościach.
+    const double x = (czasMs - m_pierwszyCzas) / MS_NA_GODZINE;
+    const double dx = x - m_sredniaCzasu;
+    const double dy = wartosc - m_srednia;
+    m_sredniaCzasu += dx / m_liczba;
+    m_srednia += dy / m_liczba;
+    m_m2Czasu += dx * (x - m_sredniaCzasu);
+    m_m2 += dy * (wartosc - m_srednia);
+    m_kowariancja += dx * (wartosc - m_srednia);
+
+    for (EstymatorP2& estymator : m_kwantyle)
+        estymator.dodaj(wartosc);
+
+    for (OknoKroczace& okno : m_okna) {
+        okno.probki.enqueue(qMakePair(czasMs, wartosc));
+        okno.suma += wartosc;
+        while (okno.probki.head().first <= czasMs - okno.dlugoscMs)
+            okno.suma -= okno.probki.dequeue().second;
+        if (okno.probki.size() == 1)
+            okno.suma = wartosc;   // Odcięcie błędu zaokrągleń nagromadzonego przez odejmowanie.
+    }
+    return true;
+}
+
+/**
+ * @brief Uwzględnia próbki widoku nowsze od ostatniej próbki.
+ *
+ * Starsze próbki są pomijane wyszukiwaniem binarnym, więc dopisanie końcówki długiej serii
+ * kosztuje tyle, ile liczba nowych próbek.
+ *
+ * @param widok Widok na serię.
+ * @return int Liczba dodanych próbek.
+ */
+int StatystykiStrumieniowe::dodaj(const WidokSerii& widok) {
+    if (widok.jestPusty())
+        return 0;
+
+    const WidokSerii nowe = m_liczba > 0 ? widok.zakres(m_ostatniCzas + 1, widok.ostatniCzas()) : widok;
+    int dodane = 0;
+    for (int i = 0; i < nowe.rozmiar(); ++i) {
+        if (!nowe.jestBrak(i) && dodaj(nowe.czas(i), nowe.wartosc(i)))
+            ++dodane;
+    }
+    return dodane;
+}
+
+/**
+ * @brief Usuwa wszystkie próbki ze statystyk.
+ */
+void StatystykiStrumieniowe::wyczysc() {
+    m_liczba = 0;
+    m_pierwszyCzas = m_ostatniCzas = 0;
+    m_min = m_max = 0;
+    m_czasMin = m_czasMax = 0;
+    m_srednia = m_m2 = 0;
+    m_sredniaCzasu = m_m2Czasu = m_kowariancja = 0;
+
+    for (int i = 0; i < 3; ++i) {
+        m_kwantyle[i].ustaw(KWANTYLE[i]);
+        m_okna[i].dlugoscMs = OKNA_MS[i];
+        m_okna[i].probki.clear();
+        m_okna[i].suma = 0;
+    }
+}
+
+/**
+ * @brief Zwraca liczbę próbek.
+ * @return qint64 Liczba próbek.
+ */
+qint64 StatystykiStrumieniowe::liczba() const {
+    return m_liczba;
+}
+
+/**
+ * @brief Sprawdza, czy statystyki są puste.
+ * @return bool true jeśli brak próbek.
+ */
+bool StatystykiStrumieniowe::jestPusta() const {
+    return m_liczba == 0;
+}
+
+/**
+ * @brief Zwraca czas pierwszej próbki.
+ * @return qint64 Milisekundy od epoki.
+ */
+qint64 StatystykiStrumieniowe::pierwszyCzas() const {
+    return m_pierwszyCzas;
+}
+
+/**
+ * @brief Zwraca czas ostatniej próbki.
+ * @return qint64 Milisekundy od epoki.
+ */
+qint64 StatystykiStrumieniowe::ostatniCzas() const {
+    return m_ostatniCzas;
+}
+
+/**
+ * @brief Zwraca najmniejszą wartość.
+ * @return double Minimum.
+ */
+double StatystykiStrumieniowe::min() const {
+    return m_min;
+}
+
+/**
+ * @brief Zwraca czas najmniejszej wartości.
+ * @return qint64 Milisekundy od epoki.
+ */
+qint64 StatystykiStrumieniowe::czasMin() const {
+    return m_czasMin;
+}
+
+/**
+ * @brief Zwraca największą wartość.
+ * @return double Maksimum.
+ */
+double StatystykiStrumieniowe::max() const {
+    return m_max;
+}
+
+/**
+ * @brief Zwraca czas największej wartości.
+ * @return qint64 Milisekundy od epoki.
+ */
+qint64 StatystykiStrumieniowe::czasMax() const {
+    return m_czasMax;
+}
+
+/**
+ * @brief Zwraca średnią arytmetyczną.
+ * @return double Średnia.
+ */
+double StatystykiStrumieniowe::srednia() const {
+    return m_srednia;
+}
+
+/**
+ * @brief Zwraca wariancję z próby.
+ * @return double Wariancja.
+ */
+double StatystykiStrumieniowe::wariancja() const {
+    return m_liczba > 1 ? m_m2 / (m_liczba - 1) : 0;
+}
+
+/**
+ * @brief Zwraca odchylenie standardowe z próby.
+ * @return double Odchylenie standardowe.
+ */
+double StatystykiStrumieniowe::odchylenie() const {
+    return qSqrt(wariancja());
+}
+
+/**
+ * @brief Zwraca nachylenie prostej najmniejszych kwadratów.
+ * @return double Zmiana wartości na godzinę.
+ */
+double StatystykiStrumieniowe::trend() const {
+    return m_m2Czasu > 0 ? m_kowariancja / m_m2Czasu : 0;
+}
+
+/**
+ * @brief Zwraca oszacowanie kwantyla.
+ *
+ * @param kwantyl Szacowany kwantyl.
+ * @return double Wartość kwantyla.
+ */
+double StatystykiStrumieniowe::kwantyl(Kwantyl kwantyl) const {
+    return m_kwantyle[kwantyl].wartosc();
+}
+
+/**
+ * @brief Zwraca średnią kroczącą.
+ *
+ * @param okno Długość okna.
+ * @return double Średnia próbek z okna.
+ */
+double StatystykiStrumieniowe::sredniaKroczaca(Okno okno) const {
+    const OknoKroczace& dane = m_okna[okno];
+    return dane.probki.isEmpty() ? 0 : dane.suma / dane.probki.size();
+}
+
+/**
+ * @brief Zwraca liczbę próbek w oknie.
+ *
+ * @param okno Długość okna.
+ * @return int Liczba próbek.
+ */
+int StatystykiStrumieniowe::liczbaWOknie(Okno okno) const {
+    return m_okna[okno].probki.size();
+}
+
+/**
+ * @brief Ustawia kwantyl i zeruje estymator.
+ *
+ * @param kwantyl Kwantyl z przedziału (0, 1).
+ */
+void StatystykiStrumieniowe::EstymatorP2::ustaw(double kwantyl) {
+    p = kwantyl;
+    n = 0;
+    for (int i = 0; i < 5; ++i) {
+        wysokosc[i] = 0;
+        pozycja[i] = i + 1;
+    }
+    zadana[0] = 1;
+    zadana[1] = 1 + 2 * p;
+    zadana[2] = 1 + 4 * p;
+    zadana[3] = 3 + 2 * p;
+    zadana[4] = 5;
+    przyrost[0] = 0;
+    przyrost[1] = p / 2;
+    przyrost[2] = p;
+    przyrost[3] = (1 + p) / 2;
+    przyrost[4] = 1;
+}
+
+/**
+ * @brief Uwzględnia próbkę w estymatorze P².
+ *
+ * Pięć pierwszych próbek staje się znacznikami. Każda następna przesuwa znaczniki powyżej
+ * swojego przedziału, a znaczniki środkowe, które oddaliły się od pożądanych pozycji,
+ * są korygowane wzorem parabolicznym (lub liniowym, gdy parabola narusza kolejność).
+ *
+ * @param x Wartość próbki.
+ */
+void StatystykiStrumieniowe::EstymatorP2::dodaj(double x) {
+    if (n < 5) {
+        wysokosc[n++] = x;
+        if (n == 5)
+            std::sort(wysokosc, wysokosc + 5);
+        return;
+    }
+    ++n;
+
+    int k;
+    if (x < wysokosc[0]) {
+        wysokosc[0] = x;
+        k = 0;
+    } else if (x >= wysokosc[4]) {
+        wysokosc[4] = x;
+        k = 3;
+    } else {
+        k = 0;
+        while (x >= wysokosc[k + 1])
+            ++k;
+    }
+
+    for (int i = k + 1; i < 5; ++i)
+        pozycja[i] += 1;
+    for (int i = 0; i < 5; ++i)
+        zadana[i] += przyrost[i];
+
+    for (int i = 1; i <= 3; ++i) {
+        const double roznica = zadana[i] - pozycja[i];
+        if ((roznica >= 1 && pozycja[i + 1] - pozycja[i] > 1) ||
+            (roznica <= -1 && pozycja[i - 1] - pozycja[i] < -1)) {
+            const int d = roznica > 0 ? 1 : -1;
+            const double nowa = parabola(i, d);
+            if (wysokosc[i - 1] < nowa && nowa < wysokosc[i + 1])
+                wysokosc[i] = nowa;
+            else
+                wysokosc[i] += d * (wysokosc[i + d] - wysokosc[i]) / (pozycja[i + d] - pozycja[i]);
+            pozycja[i] += d;
+        }
+    }
+}
+
+/**
+ * @brief Zwraca oszacowanie kwantyla.
+ *
+ * Dla najwyżej pięciu próbek kwantyl jest liczony dokładnie (interpolacja liniowa między próbkami).
+ *
+ * @return double Wartość kwantyla.
+ */
+double StatystykiStrumieniowe::EstymatorP2::wartosc() const {
+    if (n == 0)
+        return 0;
+    if (n > 5)
+        return wysokosc[2];
+
+    double posortowane[5];
+    std::copy(wysokosc, wysokosc + n, posortowane);
+    std::sort(posortowane, posortowane + n);
+    const double h = (n - 1) * p;
+    const int i = int(h);
+    return i + 1 < n ? posortowane[i] + (h - i) * (posortowane[i + 1] - posortowane[i]) : posortowane[i];
+}
+
+/**
+ * @brief Wylicza nową wysokość znacznika wzorem parabolicznym P².
+ *
+ * @param i Indeks znacznika.
+ * @param d Kierunek przesunięcia.
+ * @return double Nowa wysokość.
+ */
+double StatystykiStrumieniowe::EstymatorP2::parabola(int i, int d) const {
+    return wysokosc[i] + d / (pozycja[i + 1] - pozycja[i - 1]) *
+           ((pozycja[i] - pozycja[i - 1] + d) * (wysokosc[i + 1] - wysokosc[i]) / (pozycja[i + 1] - pozycja[i]) +
+            (pozycja[i + 1] - pozycja[i] - d) * (wysokosc[i] - wysokosc[i - 1]) / (pozycja[i] - pozycja[i - 1]));
+}
@@ -0,0 +1,249 @@
+/**
+ * @file Statystyki_strumieniowe.h
+ * @brief Plik nagłówkowy klasy StatystykiStrumieniowe
+ *
+ * Klasa StatystykiStrumieniowe aktualizuje statystyki szeregu czasowego przyrostowo,
+ * próbka po próbce: ekstrema, średnią i wariancję, trend, kwantyle oraz średnie kroczące.
+*/
+
+#ifndef STATYSTYKI_STRUMIENIOWE_H
+#define STATYSTYKI_STRUMIENIOWE_H
+
+#include <QPair>
+#include <QQueue>
+#include <QtGlobal>
+
+#include "Widok_serii.h"
+
+/**
+ * @class StatystykiStrumieniowe
+ * @brief Przyrostowe statystyki serii pomiarów (stały koszt i stała pamięć na próbkę).
+ *
+ * Średnia i wariancja są liczone algorytmem Welforda, a trend (nachylenie prostej
+ * najmniejszych kwadratów w jednostkach na godzinę) analogicznie, z kowariancji aktualizowanej
+ * przyrostowo. Kwantyle p50, p90 i p98 szacuje algorytm P² (Jain, Chlamtac 1985), który
+ * przechowuje pięć znaczników na kwantyl zamiast wszystkich próbek; przy silnym trendzie
+ * w długiej serii oszacowanie jest mniej dokładne niż dla danych o stałym rozkładzie.
+ * Średnie kroczące 1 h, 8 h i 24 h dotyczą okien kończących się na ostatniej próbce;
+ * każda próbka jest raz dodawana i raz usuwana z sumy okna.
+ *
+ * Próbki muszą napływać w kolejności czasu: próbka nie nowsza od ostatniej jest pomijana.
+ * Zmiana wartości próbki już uwzględnionej wymaga zbudowania statystyk od nowa.
+ */
+class StatystykiStrumieniowe
+{
+public:
+    /**
+     * @enum Kwantyl
+     * @brief Szacowane kwantyle.
+     */
+    enum Kwantyl {
+        Mediana = 0,   /**< Kwantyl 0,5 */
+        P90 = 1,       /**< Kwantyl 0,9 */
+        P98 = 2        /**< Kwantyl 0,98 */
+    };
+
+    /**
+     * @enum Okno
+     * @brief Okna średnich kroczących.
+     */
+    enum Okno {
+        Okno1h = 0,    /**< Ostatnia godzina */
+        Okno8h = 1,    /**< Ostatnie 8 godzin */
+        Okno24h = 2    /**< Ostatnia doba */
+    };
+
+    /**
+     * @brief Konstruktor domyślny.
+     *
+     * Tworzy puste statystyki.
+     */
+    StatystykiStrumieniowe();
+
+    /**
+     * @brief Buduje statystyki ze wszystkich próbek widoku.
+     * @param widok Widok na posortowaną serię.
+     * @return Statystyki widoku.
+     */
+    static StatystykiStrumieniowe zWidoku(const WidokSerii& widok);
+
+    /**
+     * @brief Uwzględnia kolejną próbkę.
+     * @param czasMs Znacznik czasu próbki (ms od epoki).
+     * @param wartosc Wartość pomiaru.
+     * @return true jeśli próbka została dodana (false, gdy nie jest nowsza od ostatniej).
+     */
+    bool dodaj(qint64 czasMs, double wartosc);
+
+    /**
+     * @brief Uwzględnia próbki widoku nowsze od ostatniej próbki (braki są pomijane).
+     * @param widok Widok na posortowaną serię.
+     * @return Liczba dodanych próbek.
+     */
+    int dodaj(const WidokSerii& widok);
+
+    /**
+     * @brief Usuwa wszystkie próbki ze statystyk.
+     */
+    void wyczysc();
+
+    /**
+     * @brief Zwraca liczbę uwzględnionych próbek.
+     * @return Liczba próbek.
+     */
+    qint64 liczba() const;
+
+    /**
+     * @brief Sprawdza, czy statystyki nie zawierają próbek.
+     * @return true jeśli nie dodano żadnej próbki.
+     */
+    bool jestPusta() const;
+
+    /**
+     * @brief Zwraca czas pierwszej uwzględnionej próbki.
+     * @return Milisekundy od epoki (0, jeśli brak próbek).
+     */
+    qint64 pierwszyCzas() const;
+
+    /**
+     * @brief Zwraca czas ostatniej uwzględnionej próbki.
+     * @return Milisekundy od epoki (0, jeśli brak próbek).
+     */
+    qint64 ostatniCzas() const;
+
+    /**
+     * @brief Zwraca najmniejszą wartość.
+     * @return Minimum (0, jeśli brak próbek).
+     */
+    double min() const;
+
+    /**
+     * @brief Zwraca czas pierwszego wystąpienia najmniejszej wartości.
+     * @return Milisekundy od epoki.
+     */
+    qint64 czasMin() const;
+
+    /**
+     * @brief Zwraca największą wartość.
+     * @return Maksimum (0, jeśli brak próbek).
+     */
+    double max() const;
+
+    /**
+     * @brief Zwraca czas pierwszego wystąpienia największej wartości.
+     * @return Milisekundy od epoki.
+     */
+    qint64 czasMax() const;
+
+    /**
+     * @brief Zwraca średnią arytmetyczną.
+     * @return Średnia (0, jeśli brak próbek).
+     */
+    double srednia() const;
+
+    /**
+     * @brief Zwraca wariancję z próby (z poprawką Bessela).
+     * @return Wariancja (0 dla mniej niż dwóch próbek).
+     */
+    double wariancja() const;
+
+    /**
+     * @brief Zwraca odchylenie standardowe z próby.
+     * @return Odchylenie standardowe.
+     */
+    double odchylenie() const;
+
+    /**
+     * @brief Zwraca nachylenie prostej najmniejszych kwadratów.
+     * @return Zmiana wartości na godzinę (0, jeśli wszystkie próbki mają ten sam czas).
+     */
+    double trend() const;
+
+    /**
+     * @brief Zwraca oszacowanie kwantyla.
+     * @param kwantyl Szacowany kwantyl.
+     * @return Wartość kwantyla (dokładna dla najwyżej pięciu próbek).
+     */
+    double kwantyl(Kwantyl kwantyl) const;
+
+    /**
+     * @brief Zwraca średnią kroczącą z okna kończącego się na ostatniej próbce.
+     * @param okno Długość okna.
+     * @return Średnia próbek z okna (0, jeśli brak próbek).
+     */
+    double sredniaKroczaca(Okno okno) const;
+
+    /**
+     * @brief Zwraca liczbę próbek w oknie kończącym się na ostatniej próbce.
+     * @param okno Długość okna.
+     * @return Liczba próbek (pozwala ocenić kompletność danych, np. 18 z 24 godzin).
+     */
+    int liczbaWOknie(Okno okno) const;
+
+private:
+    /**
+     * @struct EstymatorP2
+     * @brief Estymator jednego kwantyla algorytmem P².
+     */
+    struct EstymatorP2 {
+        double p = 0.5;            /**< Szacowany kwantyl */
+        qint64 n = 0;              /**< Liczba próbek */
+        double wysokosc[5];        /**< Wysokości znaczników (pierwsze próbki, dopóki n < 5) */
+        double pozycja[5];         /**< Rzeczywiste pozycje znaczników */
+        double zadana[5];          /**< Pożądane pozycje znaczników */
+        double przyrost[5];        /**< Przyrost pożądanych pozycji na próbkę */
+
+        /**
+         * @brief Ustawia kwantyl i zeruje estymator.
+         * @param kwantyl Kwantyl z przedziału (0, 1).
+         */
+        void ustaw(double kwantyl);
+
+        /**
+         * @brief Uwzględnia próbkę.
+         * @param x Wartość próbki.
+         */
+        void dodaj(double x);
+
+        /**
+         * @brief Zwraca oszacowanie kwantyla.
+         * @return Wartość kwantyla.
+         */
+        double wartosc() const;
+
+        /**
+         * @brief Wylicza nową wysokość znacznika wzorem parabolicznym.
+         * @param i Indeks znacznika (1..3).
+         * @param d Kierunek przesunięcia (-1 lub 1).
+         * @return Nowa wysokość.
+         */
+        double parabola(int i, int d) const;
+    };
+
+    /**
+     * @struct OknoKroczace
+     * @brief Próbki i suma jednego okna średniej kroczącej.
+     */
+    struct OknoKroczace {
+        qint64 dlugoscMs = 0;                    /**< Długość okna */
+        QQueue<QPair<qint64, double>> probki;    /**< Próbki okna (czas, wartość) */
+        double suma = 0;                         /**< Suma wartości próbek okna */
+    };
+
+    qint64 m_liczba;                 /**< Liczba próbek */
+    qint64 m_pierwszyCzas;           /**< Czas pierwszej próbki */
+    qint64 m_ostatniCzas;            /**< Czas ostatniej próbki */
+    double m_min;                    /**< Najmniejsza wartość */
+    double m_max;                    /**< Największa wartość */
+    qint64 m_czasMin;                /**< Czas najmniejszej wartości */
+    qint64 m_czasMax;                /**< Czas największej wartości */
+    double m_srednia;                /**< Średnia wartości (Welford) */
+    double m_m2;                     /**< Suma kwadratów odchyleń wartości od średniej */
+    double m_sredniaCzasu;           /**< Średni czas w godzinach od pierwszej próbki */
+    double m_m2Czasu;                /**< Suma kwadratów odchyleń czasu od średniej */
+    double m_kowariancja;            /**< Suma iloczynów odchyleń czasu i wartości */
+    EstymatorP2 m_kwantyle[3];       /**< Estymatory kwantyli (według Kwantyl) */
+    OknoKroczace m_okna[3];          /**< Okna średnich kroczących (według Okno) */
+};
+
+#endif // STATYSTYKI_STRUMIENIOWE_H
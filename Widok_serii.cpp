@@ -0,0 +1,149 @@
+/**
+ * @file Widok_serii.cpp
+ * @brief Plik źródłowy klasy WidokSerii
+ */
+
+#include "Widok_serii.h"
+
+/**
+ * @brief Domyślny konstruktor klasy WidokSerii.
+ *
+ * Tworzy pusty widok bez danych.
+ */
+WidokSerii::WidokSerii() :
+    m_czas(nullptr), m_przesuniecia(nullptr), m_bazaMs(0),
+    m_wartosci(nullptr), m_braki(nullptr), m_poczatek(0), m_koniec(0)
+{}
+
+/**
+ * @brief Konstruktor tworzący widok na zakres kolumn serii.
+ *
+ * @param czas Kolumna czasu serii.
+ * @param wartosci Kolumna wartości serii.
+ * @param braki Mapa bitowa braków serii.
+ * @param poczatek Indeks pierwszej próbki.
+ * @param koniec Indeks za ostatnią próbką.
+ */
+WidokSerii::WidokSerii(const qint64* czas, const float* wartosci, const quint64* braki, int poczatek, int koniec) :
+    m_czas(czas), m_przesuniecia(nullptr), m_bazaMs(0),
+    m_wartosci(wartosci), m_braki(braki), m_poczatek(poczatek), m_koniec(koniec)
+{}
+
+/**
+ * @brief Konstruktor tworzący widok na kolumny z czasem zapisanym jako przesunięcia.
+ *
+ * @param bazaMs Czas bazowy w ms.
+ * @param przesuniecia Kolumna przesunięć w sekundach.
+ * @param wartosci Kolumna wartości.
+ * @param braki Mapa bitowa braków.
+ * @param poczatek Indeks pierwszej próbki.
+ * @param koniec Indeks za ostatnią próbką.
+ */
+WidokSerii::WidokSerii(qint64 bazaMs, const qint32* przesuniecia, const float* wartosci, const quint64* braki,
+                       int poczatek, int koniec) :
+    m_czas(nullptr), m_przesuniecia(przesuniecia), m_bazaMs(bazaMs),
+    m_wartosci(wartosci), m_braki(braki), m_poczatek(poczatek), m_koniec(koniec)
+{}
+
+/**
+ * @brief Zwraca liczbę próbek w widoku.
+ * @return Liczba próbek.
+ */
+int WidokSerii::rozmiar() const {
+    return m_koniec - m_poczatek;
+}
+
+/**
+ * @brief Sprawdza, czy widok jest pusty.
+ * @return true jeśli brak próbek.
+ */
+bool WidokSerii::jestPusty() const {
+    return m_koniec <= m_poczatek;
+}
+
+/**
+ * @brief Zwraca znacznik czasu próbki.
+ * @param i Indeks w widoku.
+ * @return Milisekundy od epoki.
+ */
+qint64 WidokSerii::czas(int i) const {
+    const int j = m_poczatek + i;
+    return m_czas ? m_czas[j] : m_bazaMs + qint64(m_przesuniecia[j]) * 1000;
+}
+
+/**
+ * @brief Zwraca wartość próbki.
+ * @param i Indeks w widoku.
+ * @return Wartość pomiaru.
+ */
+float WidokSerii::wartosc(int i) const {
+    return m_wartosci[m_poczatek + i];
+}
+
+/**
+ * @brief Sprawdza, czy próbka nie ma wartości.
+ * @param i Indeks w widoku.
+ * @return true jeśli brak wartości.
+ */
+bool WidokSerii::jestBrak(int i) const {
+    const int j = m_poczatek + i;
+    return (m_braki[j >> 6] >> (j & 63)) & 1;
+}
+
+/**
+ * @brief Zwraca znacznik czasu pierwszej próbki.
+ * @return Milisekundy od epoki.
+ */
+qint64 WidokSerii::pierwszyCzas() const {
+    return czas(0);
+}
+
+/**
+ * @brief Zwraca znacznik czasu ostatniej próbki.
+ * @return Milisekundy od epoki.
+ */
+qint64 WidokSerii::ostatniCzas() const {
+    return czas(rozmiar() - 1);
+}
+
+/**
+ * @brief Zwraca indeks pierwszej próbki widoku w serii źródłowej.
+ * @return Indeks w serii.
+ */
+int WidokSerii::poczatek() const {
+    return m_poczatek;
+}
+
+/**
+ * @brief Zwraca węższy widok na próbki z przedziału czasu.
+ *
+ * Widok musi być posortowany rosnąco po czasie.
+ *
+ * @param odMs Początek przedziału.
+ * @param doMs Koniec przedziału.
+ * @return Widok na próbki z przedziału.
+ */
+WidokSerii WidokSerii::zakres(qint64 odMs, qint64 doMs) const {
+    WidokSerii wynik = *this;
+    if (doMs < odMs) {
+        wynik.m_koniec = wynik.m_poczatek;
+        return wynik;
+    }
+
+    int lewy = 0, prawy = rozmiar();
+    while (lewy < prawy) {
+        const int srodek = lewy + (prawy - lewy) / 2;
+        if (czas(srodek) < odMs) lewy = srodek + 1; else prawy = srodek;
+    }
+    const int od = lewy;
+
+    prawy = rozmiar();
+    while (lewy < prawy) {
+        const int srodek = lewy + (prawy - lewy) / 2;
+        if (czas(srodek) <= doMs) lewy = srodek + 1; else prawy = srodek;
+    }
+
+    wynik.m_koniec = m_poczatek + lewy;
+    wynik.m_poczatek = m_poczatek + od;
+    return wynik;
+}
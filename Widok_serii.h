@@ -0,0 +1,124 @@
+/**
+ * @file Widok_serii.h
+ * @brief Plik nagłówkowy klasy WidokSerii
+ *
+ * Klasa WidokSerii jest lekkim, niekopiującym widokiem na ciągły fragment szeregu czasowego pomiarów.
+*/
+
+#ifndef WIDOK_SERII_H
+#define WIDOK_SERII_H
+
+#include <QtGlobal>
+
+/**
+ * @class WidokSerii
+ * @brief Niekopiujący widok na zakres próbek szeregu czasowego.
+ *
+ * Widok przechowuje jedynie wskaźniki na kolumny serii (czas, wartości, mapa braków) oraz zakres indeksów.
+ * Pozostaje ważny tak długo, jak długo nie zmieni się seria (lub zmapowany plik), z której powstał.
+ * Kolumna czasu może zawierać pełne znaczniki (ms od epoki) albo przesunięcia w sekundach
+ * względem czasu bazowego, w postaci używanej przez MagazynKolumnowy.
+ * Indeksy w metodach widoku liczone są od początku widoku (0..rozmiar()-1).
+ */
+class WidokSerii
+{
+public:
+    /**
+     * @brief Konstruktor domyślny.
+     *
+     * Tworzy pusty widok.
+     */
+    WidokSerii();
+
+    /**
+     * @brief Konstruktor inicjalizujący.
+     * @param czas Wskaźnik na pierwszy element kolumny czasu serii.
+     * @param wartosci Wskaźnik na pierwszy element kolumny wartości serii.
+     * @param braki Wskaźnik na mapę bitową braków serii (bit ustawiony = brak wartości).
+     * @param poczatek Indeks pierwszej próbki widoku w serii.
+     * @param koniec Indeks za ostatnią próbką widoku w serii.
+     */
+    WidokSerii(const qint64* czas, const float* wartosci, const quint64* braki, int poczatek, int koniec);
+
+    /**
+     * @brief Konstruktor widoku z kolumną czasu zapisaną jako przesunięcia od czasu bazowego.
+     * @param bazaMs Czas bazowy w ms od epoki.
+     * @param przesuniecia Wskaźnik na kolumnę przesunięć w sekundach względem bazaMs.
+     * @param wartosci Wskaźnik na pierwszy element kolumny wartości.
+     * @param braki Wskaźnik na mapę bitową braków (bit ustawiony = brak wartości).
+     * @param poczatek Indeks pierwszej próbki widoku.
+     * @param koniec Indeks za ostatnią próbką widoku.
+     */
+    WidokSerii(qint64 bazaMs, const qint32* przesuniecia, const float* wartosci, const quint64* braki,
+               int poczatek, int koniec);
+
+    /**
+     * @brief Zwraca liczbę próbek w widoku.
+     * @return Liczba próbek.
+     */
+    int rozmiar() const;
+
+    /**
+     * @brief Sprawdza, czy widok jest pusty.
+     * @return true jeśli widok nie zawiera próbek.
+     */
+    bool jestPusty() const;
+
+    /**
+     * @brief Zwraca znacznik czasu próbki.
+     * @param i Indeks próbki w widoku.
+     * @return Milisekundy od epoki.
+     */
+    qint64 czas(int i) const;
+
+    /**
+     * @brief Zwraca wartość próbki.
+     * @param i Indeks próbki w widoku.
+     * @return Wartość pomiaru.
+     */
+    float wartosc(int i) const;
+
+    /**
+     * @brief Sprawdza, czy próbka nie ma wartości.
+     * @param i Indeks próbki w widoku.
+     * @return true jeśli brak wartości.
+     */
+    bool jestBrak(int i) const;
+
+    /**
+     * @brief Zwraca znacznik czasu pierwszej próbki.
+     * @return Milisekundy od epoki (widok nie może być pusty).
+     */
+    qint64 pierwszyCzas() const;
+
+    /**
+     * @brief Zwraca znacznik czasu ostatniej próbki.
+     * @return Milisekundy od epoki (widok nie może być pusty).
+     */
+    qint64 ostatniCzas() const;
+
+    /**
+     * @brief Zwraca indeks pierwszej próbki widoku w serii źródłowej.
+     * @return Indeks w serii.
+     */
+    int poczatek() const;
+
+    /**
+     * @brief Zwraca węższy widok na próbki z przedziału czasu.
+     * @param odMs Początek przedziału (ms od epoki, włącznie).
+     * @param doMs Koniec przedziału (ms od epoki, włącznie).
+     * @return Widok na próbki z przedziału (wyszukiwanie binarne, bez kopiowania).
+     */
+    WidokSerii zakres(qint64 odMs, qint64 doMs) const;
+
+private:
+    const qint64* m_czas;      /**< Kolumna czasu serii (nullptr, jeśli czas zapisano jako przesunięcia) */
+    const qint32* m_przesuniecia; /**< Kolumna przesunięć czasu w sekundach względem m_bazaMs */
+    qint64 m_bazaMs;           /**< Czas bazowy dla m_przesuniecia */
+    const float* m_wartosci;   /**< Kolumna wartości serii */
+    const quint64* m_braki;    /**< Mapa bitowa braków serii */
+    int m_poczatek;            /**< Indeks pierwszej próbki widoku w serii */
+    int m_koniec;              /**< Indeks za ostatnią próbką widoku w serii */
+};
+
+#endif // WIDOK_SERII_H
@@ -0,0 +1,123 @@
+/**
+ * @file Widok_sklejony.cpp
+ * @brief Plik źródłowy klasy WidokSklejony
+ */
+
+#include "Widok_sklejony.h"
+
+/**
+ * @brief Domyślny konstruktor klasy WidokSklejony.
+ *
+ * Tworzy pusty widok.
+ */
+WidokSklejony::WidokSklejony() {}
+
+/**
+ * @brief Konstruktor łączący dwa odcinki.
+ *
+ * @param starsze Odcinek wcześniejszy.
+ * @param nowsze Odcinek późniejszy.
+ */
+WidokSklejony::WidokSklejony(const WidokSerii& starsze, const WidokSerii& nowsze) :
+    m_starsze(starsze), m_nowsze(nowsze)
+{}
+
+/**
+ * @brief Wybiera próbki z przedziału czasu z archiwum i z serii.
+ *
+ * Archiwum dostarcza próbki sprzed pierwszej próbki serii, a seria - pozostałą część przedziału.
+ * Oba odcinki są wyznaczane wyszukiwaniem binarnym.
+ *
+ * @param archiwum Widok na historię stanowiska w archiwum.
+ * @param seria Widok na serię w pamięci.
+ * @param odMs Początek przedziału.
+ * @param doMs Koniec przedziału.
+ * @return WidokSklejony Widok na próbki z przedziału.
+ */
+WidokSklejony WidokSklejony::zakres(const WidokSerii& archiwum, const WidokSerii& seria, qint64 odMs, qint64 doMs) {
+    if (seria.jestPusty())
+        return WidokSklejony(archiwum.zakres(odMs, doMs), WidokSerii());
+
+    const qint64 poczatekSerii = seria.pierwszyCzas();
+    const WidokSerii starsze = odMs < poczatekSerii
+        ? archiwum.zakres(odMs, qMin(doMs, poczatekSerii - 1)) : WidokSerii();
+    return WidokSklejony(starsze, seria.zakres(qMax(odMs, poczatekSerii), doMs));
+}
+
+/**
+ * @brief Zwraca liczbę próbek.
+ * @return Liczba próbek.
+ */
+int WidokSklejony::rozmiar() const {
+    return m_starsze.rozmiar() + m_nowsze.rozmiar();
+}
+
+/**
+ * @brief Sprawdza, czy widok jest pusty.
+ * @return true jeśli brak próbek.
+ */
+bool WidokSklejony::jestPusty() const {
+    return m_starsze.jestPusty() && m_nowsze.jestPusty();
+}
+
+/**
+ * @brief Zwraca znacznik czasu próbki.
+ * @param i Indeks w widoku.
+ * @return Milisekundy od epoki.
+ */
+qint64 WidokSklejony::czas(int i) const {
+    const int n = m_starsze.rozmiar();
+    return i < n ? m_starsze.czas(i) : m_nowsze.czas(i - n);
+}
+
+/**
+ * @brief Zwraca wartość próbki.
+ * @param i Indeks w widoku.
+ * @return Wartość pomiaru.
+ */
+float WidokSklejony::wartosc(int i) const {
+    const int n = m_starsze.rozmiar();
+    return i < n ? m_starsze.wartosc(i) : m_nowsze.wartosc(i - n);
+}
+
+/**
+ * @brief Sprawdza, czy próbka nie ma wartości.
+ * @param i Indeks w widoku.
+ * @return true jeśli brak wartości.
+ */
+bool WidokSklejony::jestBrak(int i) const {
+    const int n = m_starsze.rozmiar();
+    return i < n ? m_starsze.jestBrak(i) : m_nowsze.jestBrak(i - n);
+}
+
+/**
+ * @brief Zwraca znacznik czasu pierwszej próbki.
+ * @return Milisekundy od epoki.
+ */
+qint64 WidokSklejony::pierwszyCzas() const {
+    return m_starsze.jestPusty() ? m_nowsze.pierwszyCzas() : m_starsze.pierwszyCzas();
+}
+
+/**
+ * @brief Zwraca znacznik czasu ostatniej próbki.
+ * @return Milisekundy od epoki.
+ */
+qint64 WidokSklejony::ostatniCzas() const {
+    return m_nowsze.jestPusty() ? m_starsze.ostatniCzas() : m_nowsze.ostatniCzas();
+}
+
+/**
+ * @brief Zwraca odcinek wcześniejszy.
+ * @return Widok na starsze próbki.
+ */
+const WidokSerii& WidokSklejony::starsze() const {
+    return m_starsze;
+}
+
+/**
+ * @brief Zwraca odcinek późniejszy.
+ * @return Widok na nowsze próbki.
+ */
+const WidokSerii& WidokSklejony::nowsze() const {
+    return m_nowsze;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file Widok_sklejony.h
+ * @brief Plik nagłówkowy klasy WidokSklejony
+ *
+ * Klasa WidokSklejony łączy dwa następujące po sobie widoki serii (archiwum historii
+ * i serię w pamięci) w jeden ciąg próbek, bez kopiowania danych.
+*/
+
+#ifndef WIDOK_SKLEJONY_H
+#define WIDOK_SKLEJONY_H
+
+#include "Widok_serii.h"
+
+/**
+ * @class WidokSklejony
+ * @brief Niekopiujący widok na dwa kolejne odcinki szeregu czasowego.
+ *
+ * Wszystkie próbki odcinka starszego są wcześniejsze od próbek odcinka nowszego, więc indeksy
+ * 0..rozmiar()-1 przebiegają próbki w kolejności czasu. Widok jest ważny tak długo,
+ * jak oba widoki, z których powstał.
+ */
+class WidokSklejony
+{
+public:
+    /**
+     * @brief Konstruktor domyślny.
+     *
+     * Tworzy pusty widok.
+     */
+    WidokSklejony();
+
+    /**
+     * @brief Konstruktor inicjalizujący.
+     * @param starsze Widok na odcinek wcześniejszy (np. z archiwum historii).
+     * @param nowsze Widok na odcinek późniejszy (np. z serii w pamięci).
+     */
+    WidokSklejony(const WidokSerii& starsze, const WidokSerii& nowsze);
+
+    /**
+     * @brief Wybiera próbki z przedziału czasu z archiwum i z serii.
+     * @param archiwum Widok na całą historię stanowiska w archiwum (może być pusty).
+     * @param seria Widok na całą serię w pamięci (może być pusty).
+     * @param odMs Początek przedziału (ms od epoki, włącznie).
+     * @param doMs Koniec przedziału (ms od epoki, włącznie).
+     * @return Widok, w którym archiwum uzupełnia tylko okres sprzed pierwszej próbki serii.
+     *
+     * Próbki archiwum pokrywające się czasem z serią są pomijane, bo seria zawiera nowszą wersję pomiarów.
+     */
+    static WidokSklejony zakres(const WidokSerii& archiwum, const WidokSerii& seria, qint64 odMs, qint64 doMs);
+
+    /**
+     * @brief Zwraca liczbę próbek w obu odcinkach.
+     * @return Liczba próbek.
+     */
+    int rozmiar() const;
+
+    /**
+     * @brief Sprawdza, czy widok jest pusty.
+     * @return true jeśli żaden odcinek nie zawiera próbek.
+     */
+    bool jestPusty() const;
+
+    /**
+     * @brief Zwraca znacznik czasu próbki.
+     * @param i Indeks próbki w widoku.
+     * @return Milisekundy od epoki.
+     */
+    qint64 czas(int i) const;
+
+    /**
+     * @brief Zwraca wartość próbki.
+     * @param i Indeks próbki w widoku.
+     * @return Wartość pomiaru.
+     */
+    float wartosc(int i) const;
+
+    /**
+     * @brief Sprawdza, czy próbka nie ma wartości.
+     * @param i Indeks próbki w widoku.
+     * @return true jeśli brak wartości.
+     */
+    bool jestBrak(int i) const;
+
+    /**
+     * @brief Zwraca znacznik czasu pierwszej próbki.
+     * @return Milisekundy od epoki (widok nie może być pusty).
+     */
+    qint64 pierwszyCzas() const;
+
+    /**
+     * @brief Zwraca znacznik czasu ostatniej próbki.
+     * @return Milisekundy od epoki (widok nie może być pusty).
+     */
+    qint64 ostatniCzas() const;
+
+    /**
+     * @brief Zwraca odcinek wcześniejszy.
+     * @return Widok na starsze próbki.
+     */
+    const WidokSerii& starsze() const;
+
+    /**
+     * @brief Zwraca odcinek późniejszy.
+     * @return Widok na nowsze próbki.
+     */
+    const WidokSerii& nowsze() const;
+
+private:
+    WidokSerii m_starsze;   /**< Odcinek wcześniejszy */
+    WidokSerii m_nowsze;    /**< Odcinek późniejszy */
+};
+
+#endif // WIDOK_SKLEJONY_H
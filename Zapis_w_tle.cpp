@@ -0,0 +1,93 @@
+/**
+ * @file Zapis_w_tle.cpp
+ * @brief Plik źródłowy klasy ZapisWTle
+ */
+
+#include "Zapis_w_tle.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QJsonDocument>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QTimer>
+
+/**
+ * @brief Konstruktor klasy ZapisWTle.
+ * @param sciezka Ścieżka pliku danych.
+ * @param opoznienieMs Opóźnienie zapisu w ms.
+ * @param parent Wskaźnik na rodzica.
+ */
+ZapisWTle::ZapisWTle(const QString& sciezka, int opoznienieMs, QObject *parent) :
+    QObject(parent),
+    m_sciezka(sciezka),
+    m_licznik(new QTimer(this))
+{
+    m_licznik->setSingleShot(true);
+    m_licznik->setInterval(opoznienieMs);
+    connect(m_licznik, &QTimer::timeout, this, &ZapisWTle::zapiszTeraz);
+}
+
+/**
+ * @brief Zgłasza nową wartość sekcji do zapisu.
+ *
+ * Wcześniejsza, jeszcze niezapisana wartość tej samej sekcji jest zastępowana.
+ *
+ * @param sekcja Nazwa sekcji.
+ * @param wartosc Nowa wartość sekcji.
+ */
+void ZapisWTle::oznaczZmiane(const QString& sekcja, const QJsonValue& wartosc) {
+    {
+        QMutexLocker blokada(&m_mutex);
+        m_oczekujace[sekcja] = wartosc;
+    }
+    QMetaObject::invokeMethod(this, &ZapisWTle::zaplanuj, Qt::QueuedConnection);
+}
+
+/**
+ * @brief Uruchamia licznik opóźnienia.
+ *
+ * Licznik nie jest restartowany przy kolejnych zmianach, więc przy ciągłej aktywności
+ * dane trafiają na dysk nie rzadziej niż co opoznienieMs.
+ */
+void ZapisWTle::zaplanuj() {
+    if (!m_licznik->isActive())
+        m_licznik->start();
+}
+
+/**
+ * @brief Zapisuje oczekujące zmiany do pliku.
+ */
+void ZapisWTle::zapiszTeraz() {
+    m_licznik->stop();
+
+    QJsonObject zmiany;
+    {
+        QMutexLocker blokada(&m_mutex);
+        if (m_oczekujace.isEmpty())
+            return;
+        zmiany.swap(m_oczekujace);
+    }
+
+    if (!m_stanWczytany) {
+        QFile dotychczasowy(m_sciezka);
+        if (dotychczasowy.open(QIODevice::ReadOnly))
+            m_stan = QJsonDocument::fromJson(dotychczasowy.readAll()).object();
+        m_stanWczytany = true;
+    }
+
+    for (auto it = zmiany.constBegin(); it != zmiany.constEnd(); ++it)
+        m_stan[it.key()] = it.value();
+
+    QSaveFile file(m_sciezka);
+    bool sukces = false;
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(QJsonDocument(m_stan).toJson());
+        sukces = file.commit();
+    }
+
+    if (!sukces)
+        qWarning() << "Nie można zapisać pliku:" << m_sciezka;
+
+    emit zapisano(sukces);
+}
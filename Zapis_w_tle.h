@@ -0,0 +1,80 @@
+/**
+ * @file Zapis_w_tle.h
+ * @brief Plik nagłówkowy klasy ZapisWTle
+ *
+ * Klasa ZapisWTle zapisuje dane aplikacji do pliku JSON w osobnym wątku,
+ * łącząc wiele zmian w jeden zapis wykonywany z opóźnieniem lub przy zamykaniu programu.
+*/
+
+#ifndef ZAPIS_W_TLE_H
+#define ZAPIS_W_TLE_H
+
+#include <QObject>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QMutex>
+#include <QString>
+
+class QTimer;
+
+/**
+ * @class ZapisWTle
+ * @brief Opóźniony, atomowy zapis sekcji danych w tle.
+ *
+ * Obiekt jest przenoszony do osobnego wątku (QThread). Metoda oznaczZmiane() może być wywoływana
+ * z dowolnego wątku - zapamiętuje tylko najnowszą wartość zmienionej sekcji ("stacje", "pomiary", ...).
+ * Pierwsza zmiana uruchamia licznik; po jego upływie wszystkie oczekujące sekcje są scalane
+ * ze stanem pliku i zapisywane jednym wywołaniem QSaveFile. Dotychczasowa zawartość pliku
+ * jest wczytywana dopiero przy pierwszym zapisie, w wątku zapisu.
+ */
+class ZapisWTle : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Konstruktor klasy ZapisWTle.
+     * @param sciezka Ścieżka pliku danych (sekcje niezmieniane są zapisywane bez zmian).
+     * @param opoznienieMs Maksymalny czas od pierwszej zmiany do zapisu.
+     * @param parent Wskaźnik na obiekt rodzica (domyślnie nullptr).
+     */
+    explicit ZapisWTle(const QString& sciezka, int opoznienieMs = 2000, QObject *parent = nullptr);
+
+    /**
+     * @brief Zgłasza nową wartość sekcji do zapisu (bezpieczne wątkowo).
+     * @param sekcja Nazwa sekcji (klucz w głównym obiekcie JSON).
+     * @param wartosc Nowa wartość sekcji.
+     */
+    void oznaczZmiane(const QString& sekcja, const QJsonValue& wartosc);
+
+public slots:
+    /**
+     * @brief Natychmiast zapisuje oczekujące zmiany.
+     *
+     * Wywoływane po upływie opóźnienia oraz przy zamykaniu aplikacji.
+     */
+    void zapiszTeraz();
+
+signals:
+    /**
+     * @brief Sygnał emitowany po próbie zapisu.
+     * @param sukces true jeśli plik został zapisany.
+     */
+    void zapisano(bool sukces);
+
+private slots:
+    /**
+     * @brief Uruchamia licznik opóźnienia, jeśli nie jest już aktywny (w wątku zapisu).
+     */
+    void zaplanuj();
+
+private:
+    QString m_sciezka;             /**< Ścieżka pliku danych */
+    QJsonObject m_stan;            /**< Zawartość pliku po ostatnim zapisie (tylko wątek zapisu) */
+    bool m_stanWczytany = false;   /**< Czy m_stan zawiera już dotychczasową zawartość pliku */
+    QJsonObject m_oczekujace;      /**< Sekcje zmienione od ostatniego zapisu */
+    QMutex m_mutex;                /**< Blokada m_oczekujace */
+    QTimer *m_licznik;             /**< Licznik opóźnienia zapisu */
+};
+
+#endif // ZAPIS_W_TLE_H
@@ -4,13 +4,49 @@
  *
  * Plik zawiera funkcję `main`, która inicjalizuje aplikację Qt,
  * ustawia styl interfejsu użytkownika na „Fusion” oraz uruchamia
- * główne okno aplikacji `MainWindow`.
+ * główne okno aplikacji `MainWindow`. Z opcją `--importuj-skorowidz`
+ * buduje jedynie skorowidz miejsc i kończy działanie.
  *
  * @author Artur Horetskyi
  */
 
 #include "Okno_gui.h"
+#include "Skorowidz_miejsc.h"
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QDir>
+#include <QStandardPaths>
+
+/**
+ * @brief Buduje plik skorowidz.skm w katalogu danych aplikacji.
+ *
+ * @param sciezkaTsv Plik kodów pocztowych GeoNames (np. PL.txt).
+ * @return 0 jeśli skorowidz został zapisany.
+ */
+static int importujSkorowidz(const QString& sciezkaTsv) {
+    QFile plik(sciezkaTsv);
+    if (!plik.open(QIODevice::ReadOnly)) {
+        qCritical() << "Nie można otworzyć pliku:" << sciezkaTsv;
+        return 1;
+    }
+
+    const QVector<SkorowidzMiejsc::Miejsce> miejsca = SkorowidzMiejsc::zGeoNames(&plik);
+    if (miejsca.isEmpty()) {
+        qCritical() << "Plik nie zawiera wierszy w formacie GeoNames:" << sciezkaTsv;
+        return 1;
+    }
+
+    const QString katalog = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    const QString cel = katalog + "/skorowidz.skm";
+    if (!QDir().mkpath(katalog) || !SkorowidzMiejsc::zapisz(cel, miejsca)) {
+        qCritical() << "Nie można zapisać skorowidza:" << cel;
+        return 1;
+    }
+
+    qInfo() << "Zapisano" << miejsca.size() << "wpisów skorowidza do" << cel;
+    return 0;
+}
 
 /**
  * @brief Główna funkcja aplikacji.
@@ -26,6 +62,18 @@ int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
 
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    const QCommandLineOption opcjaSkorowidza(
+        "importuj-skorowidz",
+        "Buduje skorowidz miejsc (skorowidz.skm) z pliku kodów pocztowych GeoNames i kończy działanie.",
+        "plik.txt");
+    parser.addOption(opcjaSkorowidza);
+    parser.process(a);
+
+    if (parser.isSet(opcjaSkorowidza))
+        return importujSkorowidz(parser.value(opcjaSkorowidza));
+
     a.setStyle("Fusion");
 
     MainWindow w;
@@ -0,0 +1,184 @@
+/**
+ * @file API_pobieranie_test.cpp
+ * @brief Plik źródłowy klasy APIServiceTest
+ */
+
+#include "API_pobieranie_test.h"
+#include "Serwer_testowy.h"
+#include "../API_pobieranie.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSignalSpy>
+#include <QTest>
+
+namespace {
+const QByteArray POMIARY =
+    R"({"key":"PM10","values":[{"date":"2024-03-01 12:00:00","value":10.5},)"
+    R"({"date":"2024-03-01 13:00:00","value":11.25}]})";
+
+/**
+ * @brief Tworzy obiekt pomiarów {"key", "values"} z listy wartości w formacie API.
+ */
+QJsonObject pomiaryStanowiska(const QByteArray& wartosci) {
+    return QJsonDocument::fromJson(R"({"key":"PM10","values":[)" + wartosci + "]}").object();
+}
+
+/**
+ * @brief Tworzy stronę listy stacji w formacie API.
+ */
+QByteArray stronaStacji(const QVector<int>& identyfikatory, int liczbaStron) {
+    QByteArray stacje;
+    for (int id : identyfikatory) {
+        if (!stacje.isEmpty())
+            stacje += ',';
+        stacje += QString(R"({"Identyfikator stacji":%1,"Nazwa stacji":"Stacja %1",)"
+                          R"("Nazwa miasta":"Miasto","WGS84 φ N":"52.%1","WGS84 λ E":"21.%1"})").arg(id).toUtf8();
+    }
+    return R"({"Lista stacji pomiarowych":[)" + stacje + R"(],"totalPages":)" + QByteArray::number(liczbaStron) + "}";
+}
+}
+
+/**
+ * @brief Przygotowuje środowisko testów.
+ */
+void APIServiceTest::initTestCase() {
+    QStandardPaths::setTestModeEnabled(true);
+    QVERIFY(m_katalog.isValid());
+    QVERIFY(QDir::setCurrent(m_katalog.path()));
+
+    m_serwer = new SerwerTestowy(this);
+    QVERIFY(m_serwer->uruchom());
+}
+
+/**
+ * @brief Tworzy nowy obiekt APIService.
+ */
+void APIServiceTest::init() {
+    m_api = new APIService;
+    m_api->ustawAdresBazowy(m_serwer->adres());
+    m_api->pamiecDyskowa.wyczysc();
+}
+
+/**
+ * @brief Usuwa obiekt APIService.
+ */
+void APIServiceTest::cleanup() {
+    delete m_api;
+    m_api = nullptr;
+    m_serwer->wyczyscZapytania();
+}
+
+/**
+ * @brief Sprawdza rewalidację wpisu dyskowej pamięci podręcznej.
+ */
+void APIServiceTest::rewalidacjaEtag() {
+    const QByteArray sciezka = "/data/getData/7";
+    const QUrl url(m_serwer->adres() + "data/getData/7");
+    m_serwer->ustaw(sciezka, {200, POMIARY, "\"v1\""});
+
+    QSignalSpy pobrane(m_api, &APIService::danePomiarowePobrane);
+    QSignalSpy dolaczone(m_api, &APIService::pomiaryDolaczone);
+
+    m_api->pobierzDanePomiarowe(7);
+    QVERIFY(pobrane.wait());
+    QCOMPARE(m_serwer->liczbaZapytan(sciezka), 1);
+
+    PamiecOdpowiedzi::Wpis wpis;
+    QVERIFY(m_api->pamiecDyskowa.znajdz(url, &wpis));
+    QCOMPARE(wpis.etag, QByteArray("\"v1\""));
+    QCOMPARE(wpis.tresc, POMIARY);
+
+    // Świeży dokument z pamięci jest przetwarzany bez zapytania sieciowego i bez odczytu dysku.
+    m_api->pamiecDyskowa.wyczysc();
+    m_api->pobierzDanePomiarowe(7);
+    QVERIFY(dolaczone.wait());
+    QCOMPARE(m_serwer->liczbaZapytan(sciezka), 1);
+
+    // Nieaktualna kopia: zapytanie warunkowe, 304 i przedłużenie ważności.
+    wpis.waznyDo = 0;
+    QVERIFY(m_api->pamiecDyskowa.zapiszWpis(url, wpis));
+    m_api->waznoscCache.remove(url.toString());
+    m_api->pobierzDanePomiarowe(7);
+    QVERIFY(dolaczone.wait());
+    QCOMPARE(m_serwer->liczbaZapytan(sciezka), 2);
+    QCOMPARE(m_serwer->zapytania().last().naglowki.value("if-none-match"), QByteArray("\"v1\""));
+    QCOMPARE(m_serwer->zapytania().last().status, 304);
+
+    QVERIFY(m_api->pamiecDyskowa.znajdz(url, &wpis));
+    QVERIFY(wpis.jestSwiezy(QDateTime::currentMSecsSinceEpoch()));
+    QCOMPARE(wpis.tresc, POMIARY);
+    QCOMPARE(pobrane.size(), 1);
+}
+
+/**
+ * @brief Sprawdza pobieranie całej sieci.
+ */
+void APIServiceTest::pobieranieSieciWTle() {
+    const QString plikDanych = m_api->sciezkaPliku;
+    QFile::remove(plikDanych);
+
+    m_serwer->ustaw("/station/findAll?page=0&size=500", {200, stronaStacji({1, 2}, 2), {}});
+    m_serwer->ustaw("/station/findAll?page=1&size=500", {200, stronaStacji({3}, 2), {}});
+    for (int stacja = 1; stacja <= 3; ++stacja) {
+        const int stanowisko = 10 * stacja + 1;
+        m_serwer->ustaw("/station/sensors/" + QByteArray::number(stacja),
+                        {200, QString(R"([{"id":%1,"stationId":%2,"param":{"paramCode":"PM10"}}])")
+                                  .arg(stanowisko).arg(stacja).toUtf8(), {}});
+        m_serwer->ustaw("/data/getData/" + QByteArray::number(stanowisko), {200, POMIARY, {}});
+    }
+
+    QSignalSpy stacje(m_api, &APIService::daneStacjiPobrane);
+    QSignalSpy pomiary(m_api, &APIService::danePomiarowePobrane);
+
+    m_api->pobierzCalaSiec(100);
+    QTRY_VERIFY_WITH_TIMEOUT(!m_api->pobieranieSieciTrwa(), 10000);
+
+    QCOMPARE(m_api->rejestr.rozmiar(), 3);
+    QCOMPARE(m_serwer->liczbaZapytan("/station/findAll"), 2);
+    QCOMPARE(m_serwer->liczbaZapytan("/station/sensors/"), 3);
+    QCOMPARE(m_serwer->liczbaZapytan("/data/getData/"), 3);
+    QCOMPARE(m_api->statystykiStanowiska(21).liczba(), qint64(2));
+
+    // Nic nie trafiło do widoków ani do bieżących danych.
+    QCOMPARE(stacje.size(), 0);
+    QCOMPARE(pomiary.size(), 0);
+    QVERIFY(!m_api->aktualneDane.contains("stacje"));
+
+    // Zniszczenie usługi zapisuje oczekujące sekcje; lista stacji nie może być wśród nich.
+    delete m_api;
+    m_api = nullptr;
+    QFile plik(plikDanych);
+    if (plik.open(QIODevice::ReadOnly))
+        QVERIFY(!QJsonDocument::fromJson(plik.readAll()).object().contains("stacje"));
+}
+
+/**
+ * @brief Sprawdza przebudowę statystyk po poprawce próbki.
+ */
+void APIServiceTest::statystykiPoPoprawce() {
+    const int stanowisko = 501;
+    m_api->opublikujPomiary(stanowisko, pomiaryStanowiska(
+        R"({"date":"2024-03-02 12:00:00","value":10},{"date":"2024-03-02 13:00:00","value":20})"), false);
+    QCOMPARE(m_api->statystykiStanowiska(stanowisko).liczba(), qint64(2));
+    QCOMPARE(m_api->statystykiStanowiska(stanowisko).max(), 20.0);
+
+    // Wartość z 13:00 została poprawiona i doszła nowa próbka.
+    QSignalSpy zaktualizowane(m_api, &APIService::statystykiZaktualizowane);
+    m_api->opublikujPomiary(stanowisko, pomiaryStanowiska(
+        R"({"date":"2024-03-02 12:00:00","value":10},{"date":"2024-03-02 13:00:00","value":5},)"
+        R"({"date":"2024-03-02 14:00:00","value":30})"), false);
+
+    const StatystykiStrumieniowe statystyki = m_api->statystykiStanowiska(stanowisko);
+    QCOMPARE(zaktualizowane.size(), 1);
+    QCOMPARE(statystyki.liczba(), qint64(3));
+    QCOMPARE(statystyki.min(), 5.0);
+    QCOMPARE(statystyki.srednia(), 15.0);
+
+    // Same braki: statystyki są puste (widok pokazuje "brak danych").
+    m_api->opublikujPomiary(502, pomiaryStanowiska(R"({"date":"2024-03-02 12:00:00","value":null})"), false);
+    QVERIFY(m_api->statystykiStanowiska(502).jestPusta());
+}
@@ -0,0 +1,65 @@
+/**
+ * @file API_pobieranie_test.h
+ * @brief Plik nagłówkowy klasy APIServiceTest
+ *
+ * Klasa APIServiceTest zawiera testy APIService z lokalną atrapą API (SerwerTestowy).
+*/
+
+#ifndef API_POBIERANIE_TEST_H
+#define API_POBIERANIE_TEST_H
+
+#include <QObject>
+#include <QTemporaryDir>
+
+class APIService;
+class SerwerTestowy;
+
+/**
+ * @class APIServiceTest
+ * @brief Testy pamięci podręcznej, rewalidacji i pobierania w tle APIService.
+ *
+ * Każda funkcja testowa dostaje nowy obiekt APIService z pustą pamięcią dyskową,
+ * skierowany na SerwerTestowy. Pliki danych i dziennika powstają w katalogu tymczasowym.
+ */
+class APIServiceTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Przygotowuje katalog roboczy, tryb testowy QStandardPaths i serwer.
+     */
+    void initTestCase();
+
+    /**
+     * @brief Tworzy APIService skierowany na serwer testowy.
+     */
+    void init();
+
+    /**
+     * @brief Usuwa APIService i zapamiętane zapytania serwera.
+     */
+    void cleanup();
+
+    /**
+     * @brief Sprawdza, że świeża kopia nie wysyła zapytania, a nieaktualna jest rewalidowana ETagiem (304).
+     */
+    void rewalidacjaEtag();
+
+    /**
+     * @brief Sprawdza, że pobieranie całej sieci nie zmienia bieżących danych ani pliku danych.
+     */
+    void pobieranieSieciWTle();
+
+    /**
+     * @brief Sprawdza, że poprawka wcześniejszej próbki pobranej w tle przebudowuje statystyki stanowiska.
+     */
+    void statystykiPoPoprawce();
+
+private:
+    QTemporaryDir m_katalog;            /**< Katalog roboczy testów */
+    SerwerTestowy *m_serwer = nullptr;  /**< Atrapa API */
+    APIService *m_api = nullptr;        /**< Testowany obiekt */
+};
+
+#endif // API_POBIERANIE_TEST_H
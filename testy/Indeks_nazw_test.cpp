@@ -0,0 +1,155 @@
+/**
+ * @file Indeks_nazw_test.cpp
+ * @brief Plik źródłowy klasy IndeksNazwTest
+ */
+
+#include "Indeks_nazw_test.h"
+#include "../Indeks_nazw.h"
+#include "../Rejestr_stacji.h"
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QTest>
+
+namespace {
+/**
+ * @brief Zwraca numery nazw z trafień, w kolejności wyników.
+ */
+QVector<int> indeksy(const QVector<IndeksNazw::Trafienie>& trafienia) {
+    QVector<int> wynik;
+    for (const IndeksNazw::Trafienie& t : trafienia)
+        wynik.append(t.indeks);
+    return wynik;
+}
+
+/**
+ * @brief Tworzy obiekt stacji w formacie starszego API (bez współrzędnych).
+ */
+QJsonObject stacja(int id, const QString& nazwa, const QString& miasto) {
+    return QJsonObject{{"id", id}, {"stationName", nazwa}, {"city", QJsonObject{{"name", miasto}}}};
+}
+
+/**
+ * @brief Buduje rejestr testowy: wiersze 0 i 1 - Łódź, 2 - Kraków, 3 - Żory, 4 - Góry.
+ */
+void zbudujRejestr(RejestrStacji& rejestr) {
+    rejestr.zbuduj(QJsonArray{
+        stacja(1, "Łódź, ul. Czernika", "Łódź"),
+        stacja(2, "Łódź, al. Rudzka", "Łódź"),
+        stacja(3, "Kraków, Aleja Krasińskiego", "Kraków"),
+        stacja(4, "Żory, ul. Szeroka", "Żory"),
+        stacja(5, "Góry, Szkolna", "Góry"),
+    });
+}
+}
+
+/**
+ * @brief Sprawdza postać złożoną nazw.
+ */
+void IndeksNazwTest::zlozenie() {
+    QCOMPARE(IndeksNazw::zloz("Łódź"), QString("lodz"));
+    QCOMPARE(IndeksNazw::zloz("ŻÓŁW"), QString("zolw"));
+    QCOMPARE(IndeksNazw::zloz("Ćmielów"), QString("cmielow"));
+    QCOMPARE(IndeksNazw::zloz("  Bielsko-Biała "), QString("bielsko biala"));
+
+    // Litera z osobnym znakiem łączącym i znak o szerokości pełnej (rozkład zgodności NFKD).
+    QCOMPARE(IndeksNazw::zloz(QString("Lo") + QChar(0x0301) + "dz"), QString("lodz"));
+    QCOMPARE(IndeksNazw::zloz(QString(QChar(0xFF2B)) + "raków"), QString("krakow"));
+
+    QVERIFY(IndeksNazw::zloz(" ,.- ").isEmpty());
+}
+
+/**
+ * @brief Sprawdza wyszukiwanie "lodz" -> "Łódź".
+ */
+void IndeksNazwTest::bezZnakowDiakrytycznych() {
+    IndeksNazw indeks;
+    indeks.zbuduj({"Łódź", "Żory", "Gdańsk"});
+    QCOMPARE(indeks.rozmiar(), 3);
+
+    const QVector<IndeksNazw::Trafienie> lodz = indeks.szukaj("lodz");
+    QCOMPARE(indeksy(lodz), QVector<int>({0}));
+    QCOMPARE(lodz.first().ocena, 1.0f);
+
+    QCOMPARE(indeksy(indeks.szukaj("LODZ")), QVector<int>({0}));
+    QCOMPARE(indeksy(indeks.szukaj("zory")), QVector<int>({1}));
+    QCOMPARE(indeksy(indeks.szukaj("gdańsk")), QVector<int>({2}));
+    QVERIFY(indeks.szukaj("").isEmpty());
+}
+
+/**
+ * @brief Sprawdza uszeregowanie trafień i kolejność przy równej ocenie.
+ */
+void IndeksNazwTest::kolejnoscTrafien() {
+    IndeksNazw indeks;
+    indeks.zbuduj({"Podkrakowie", "Krakuw", "Stary Kraków", "Krakowiany", "Kraków", "Gdańsk"});
+
+    const QVector<IndeksNazw::Trafienie> trafienia = indeks.szukaj("krakow");
+    QCOMPARE(indeksy(trafienia), QVector<int>({4, 3, 2, 0, 1}));
+    QCOMPARE(trafienia[0].ocena, 1.0f);   // cała nazwa
+    QCOMPARE(trafienia[1].ocena, 0.9f);   // początek nazwy
+    QCOMPARE(trafienia[2].ocena, 0.8f);   // początek słowa
+    QCOMPARE(trafienia[3].ocena, 0.7f);   // fragment słowa
+    QVERIFY(trafienia[4].ocena < 0.6f);   // tylko podobna
+
+    QCOMPARE(indeksy(indeks.szukaj("krakow", 2)), QVector<int>({4, 3}));
+
+    // Przy równej ocenie krótsza nazwa jest pierwsza.
+    IndeksNazw wsie;
+    wsie.zbuduj({"Nowa Wieś Wielka", "Nowa Wieś"});
+    QCOMPARE(indeksy(wsie.szukaj("nowa")), QVector<int>({1, 0}));
+
+    // Zapytanie krótsze niż trigram jest szukane tylko jako prefiks.
+    QCOMPARE(indeksy(indeks.szukaj("kr")), QVector<int>({1, 4, 3, 2}));
+}
+
+/**
+ * @brief Sprawdza trafienia podobne i ich odcięcie poniżej PROG_PODOBIENSTWA.
+ */
+void IndeksNazwTest::literowki() {
+    IndeksNazw indeks;
+    indeks.zbuduj({"Kraków", "Krakowa", "Kraśnik", "Gdańsk"});
+
+    // "krakuw" i "krakow" mają 2 z 4 trigramów wspólne (Dice 0,5 - na progu), a z "krakowa" 2 z 4 i 5 (0,44).
+    const QVector<IndeksNazw::Trafienie> trafienia = indeks.szukaj("krakuw");
+    QCOMPARE(indeksy(trafienia), QVector<int>({0}));
+    QCOMPARE(trafienia.first().ocena, 0.6f * 0.5f);
+
+    QVERIFY(indeks.szukaj("krakuw", -1, false).isEmpty());
+    QVERIFY(indeks.szukaj("xyz").isEmpty());
+}
+
+/**
+ * @brief Sprawdza wyszukiwanie stacji po mieście.
+ */
+void IndeksNazwTest::stacjeWMiescie() {
+    RejestrStacji rejestr;
+    zbudujRejestr(rejestr);
+
+    QCOMPARE(rejestr.wMiescie("lodz"), QVector<int>({0, 1}));
+    QCOMPARE(rejestr.wMiescie("Kraków"), QVector<int>({2}));
+
+    // "Góry" jest podobna do "Żory", ale pomijana, bo "Żory" zawiera szukany tekst.
+    QCOMPARE(rejestr.wMiescie("zory"), QVector<int>({3}));
+    QCOMPARE(rejestr.wMiescie("gory"), QVector<int>({4}));
+
+    // Bez nazw zawierających tekst zwracane są miasta podobne.
+    QCOMPARE(rejestr.wMiescie("krakuw"), QVector<int>({2}));
+    QVERIFY(rejestr.wMiescie("gdansk").isEmpty());
+}
+
+/**
+ * @brief Sprawdza wyszukiwanie stacji po nazwie miasta lub stacji.
+ */
+void IndeksNazwTest::szukanieStacji() {
+    RejestrStacji rejestr;
+    zbudujRejestr(rejestr);
+
+    QCOMPARE(rejestr.szukaj("lodz"), QVector<int>({0, 1}));
+    QCOMPARE(rejestr.szukaj("lodz", 1), QVector<int>({0}));
+    QCOMPARE(rejestr.szukaj("rudzka"), QVector<int>({1}));
+    QCOMPARE(rejestr.szukaj("krasinskiego"), QVector<int>({2}));
+    QCOMPARE(rejestr.szukaj("szk"), QVector<int>({4}));
+    QCOMPARE(rejestr.szukaj("zory"), QVector<int>({3}));
+    QCOMPARE(rejestr.szukaj("krakuw"), QVector<int>({2}));
+}
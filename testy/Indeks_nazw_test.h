@@ -0,0 +1,57 @@
+/**
+ * @file Indeks_nazw_test.h
+ * @brief Plik nagłówkowy klasy IndeksNazwTest
+ *
+ * Klasa IndeksNazwTest zawiera testy składania nazw, wyszukiwania w IndeksNazw
+ * i wyszukiwania stacji po nazwie w RejestrStacji.
+*/
+
+#ifndef INDEKS_NAZW_TEST_H
+#define INDEKS_NAZW_TEST_H
+
+#include <QObject>
+
+/**
+ * @class IndeksNazwTest
+ * @brief Testy IndeksNazw::zloz, IndeksNazw::szukaj oraz RejestrStacji::wMiescie i szukaj.
+ *
+ * Rejestr zawiera dwie stacje w Łodzi oraz po jednej w Krakowie, Żorach i Górach;
+ * nazwy "Żory" i "Góry" są do siebie podobne, ale żadna nie zawiera drugiej.
+ */
+class IndeksNazwTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Sprawdza składanie nazw: "ł"/"Ł", znaki diakrytyczne po rozkładzie NFKD i interpunkcję.
+     */
+    void zlozenie();
+
+    /**
+     * @brief Sprawdza, że zapytanie bez znaków diakrytycznych znajduje nazwę z nimi.
+     */
+    void bezZnakowDiakrytycznych();
+
+    /**
+     * @brief Sprawdza kolejność: cała nazwa, początek nazwy, początek słowa, fragment, podobieństwo.
+     */
+    void kolejnoscTrafien();
+
+    /**
+     * @brief Sprawdza wyszukiwanie z literówką i próg podobieństwa.
+     */
+    void literowki();
+
+    /**
+     * @brief Sprawdza RejestrStacji::wMiescie z pominięciem nazw tylko podobnych.
+     */
+    void stacjeWMiescie();
+
+    /**
+     * @brief Sprawdza RejestrStacji::szukaj po nazwie miasta i stacji.
+     */
+    void szukanieStacji();
+};
+
+#endif // INDEKS_NAZW_TEST_H
@@ -0,0 +1,256 @@
+/**
+ * @file Kompresja_gorilla_test.cpp
+ * @brief Plik źródłowy klasy KompresjaGorillaTest
+ */
+
+#include "Kompresja_gorilla_test.h"
+#include "../Dziennik_pomiarow.h"
+#include "../Kompresja_gorilla.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QTest>
+#include <QtMath>
+
+namespace {
+const qint64 GODZINA_MS = 3600 * 1000LL;
+const qint64 POCZATEK_MS = 1704067200000LL;   // 2024-01-01 00:00 UTC
+const int ROZMIAR_SERII = 100000;
+const int ROZMIAR_PROBKI_WPROST = 13;         // czas i64 + wartość f32 + brak u8
+const int ROZMIAR_GLOWY_REKORDU = 4 + 14;     // prefiks długości + znacznik, id, liczba, długość parametru
+const double KOMPRESJA_DZIESIATE = 3.4;       // zmierzono 3,47x (3,75 B/próbkę)
+const double KOMPRESJA_CALKOWITE = 9.5;       // zmierzono 9,71x (1,34 B/próbkę)
+
+/**
+ * @brief Tworzy serię godzinową o stałej wartości.
+ */
+SeriaPomiarowa seriaGodzinowa(int odGodziny, int doGodziny, float wartosc) {
+    SeriaPomiarowa seria("PM10");
+    for (int h = odGodziny; h <= doGodziny; ++h)
+        seria.dodaj(POCZATEK_MS + h * GODZINA_MS, wartosc);
+    return seria;
+}
+
+/**
+ * @brief Tworzy serię godzinową o wolno zmiennych wartościach (cykl dobowy i tygodniowy).
+ * @param dokladnosc Rozdzielczość zapisanych wartości, np. 0.1 dla odczytów z jednym miejscem po przecinku.
+ */
+SeriaPomiarowa seriaDobowa(double dokladnosc) {
+    SeriaPomiarowa seria("PM10");
+    for (int h = 0; h < ROZMIAR_SERII; ++h) {
+        const double wartosc = 25.0 + 8.0 * qSin(2.0 * M_PI * h / 24.0)
+                             + 5.0 * qSin(2.0 * M_PI * h / (24.0 * 7));
+        seria.dodaj(POCZATEK_MS + h * GODZINA_MS, float(qRound(wartosc / dokladnosc) * dokladnosc));
+    }
+    return seria;
+}
+
+/**
+ * @brief Zwraca stopień kompresji strumienia względem zapisu próbek wprost.
+ */
+double stopienKompresji(const QByteArray& strumien, int liczbaProbek) {
+    return double(liczbaProbek) * ROZMIAR_PROBKI_WPROST / strumien.size();
+}
+
+/**
+ * @brief Porównuje zdekodowany strumień z próbkami widoku.
+ */
+bool zgodne(KompresjaGorilla::Dekoder& dekoder, const WidokSerii& widok) {
+    int j = 0;
+    while (!dekoder.koniec()) {
+        const WidokSerii blok = dekoder.nastepnyBlok();
+        for (int i = 0; i < blok.rozmiar(); ++i, ++j) {
+            if (blok.czas(i) != widok.czas(j) || blok.jestBrak(i) != widok.jestBrak(j) ||
+                (!blok.jestBrak(i) && blok.wartosc(i) != widok.wartosc(j)))
+                return false;
+        }
+    }
+    return !dekoder.blad() && j == widok.rozmiar();
+}
+}
+
+/**
+ * @brief Przygotowuje serię godzinową (co 50. próbka bez wartości, co 10. z przesunięciem o sekundę).
+ */
+void KompresjaGorillaTest::initTestCase() {
+    QVERIFY(m_katalog.isValid());
+
+    m_seriaDobowa = seriaDobowa(0.1);
+
+    m_czas.resize(ROZMIAR_SERII);
+    m_wartosci.resize(ROZMIAR_SERII);
+    m_braki.fill(0, (ROZMIAR_SERII + 63) / 64);
+    for (int i = 0; i < ROZMIAR_SERII; ++i) {
+        m_czas[i] = POCZATEK_MS + i * GODZINA_MS + (i % 10 == 9 ? 1000 : 0);
+        m_wartosci[i] = 20.0f + float(i % 37) * 0.5f;
+        if (i % 50 == 49) {
+            m_braki[i >> 6] |= quint64(1) << (i & 63);
+            m_wartosci[i] = 0.0f;
+        }
+    }
+}
+
+/**
+ * @brief Sprawdza kodowanie i dekodowanie.
+ */
+void KompresjaGorillaTest::kodowanieIDekodowanie() {
+    const WidokSerii widok(m_czas.constData(), m_wartosci.constData(), m_braki.constData(), 0, m_czas.size());
+
+    const QByteArray strumien = KompresjaGorilla::koduj(widok);
+    KompresjaGorilla::Dekoder dekoder(strumien.constData(), strumien.size(), widok.rozmiar(), widok.pierwszyCzas());
+    QCOMPARE(dekoder.liczbaProbek(), ROZMIAR_SERII);
+    QVERIFY(zgodne(dekoder, widok));
+    QVERIFY(strumien.size() < ROZMIAR_SERII * ROZMIAR_PROBKI_WPROST / 4);
+
+    // Z różnicą odniesienia równą krokowi serii druga próbka kosztuje jeden bit czasu.
+    const WidokSerii krotki = widok.zakres(POCZATEK_MS, POCZATEK_MS + 5 * GODZINA_MS);
+    const QByteArray bezOdniesienia = KompresjaGorilla::koduj(krotki);
+    const QByteArray zOdniesieniem = KompresjaGorilla::koduj(krotki, GODZINA_MS);
+    QVERIFY(zOdniesieniem.size() < bezOdniesienia.size());
+
+    KompresjaGorilla::Dekoder dekoderOdniesienia(zOdniesieniem.constData(), zOdniesieniem.size(),
+                                                 krotki.rozmiar(), krotki.pierwszyCzas(), GODZINA_MS);
+    QVERIFY(zgodne(dekoderOdniesienia, krotki));
+
+    // Uszkodzony (ucięty) strumień nie może dać próbek spoza danych.
+    KompresjaGorilla::Dekoder uciety(strumien.constData(), strumien.size() / 2, widok.rozmiar(), widok.pierwszyCzas());
+    while (!uciety.koniec())
+        uciety.nastepnyBlok();
+    QVERIFY(uciety.blad());
+}
+
+/**
+ * @brief Mierzy i sprawdza stopień kompresji realistycznej serii godzinowej.
+ *
+ * Przy wartościach z jednym miejscem po przecinku prawie każda próbka zmienia
+ * mantysę float, więc XOR wartości kosztuje ok. 28 bitów i stopień kompresji
+ * wynosi ok. 3,5x; 10x nie jest osiągalne. Odczyty całkowite zbliżają się do 10x.
+ */
+void KompresjaGorillaTest::stopienKompresjiSerii() {
+    const WidokSerii dziesiate = m_seriaDobowa.calosc();
+    const QByteArray strumienDziesiate = KompresjaGorilla::koduj(dziesiate);
+    const double stopienDziesiate = stopienKompresji(strumienDziesiate, dziesiate.rozmiar());
+
+    const SeriaPomiarowa calkowite = seriaDobowa(1.0);
+    const QByteArray strumienCalkowite = KompresjaGorilla::koduj(calkowite.calosc());
+    const double stopienCalkowite = stopienKompresji(strumienCalkowite, calkowite.rozmiar());
+
+    qInfo("Wartości co 0,1: %.2f B/próbkę, kompresja %.2fx",
+          double(strumienDziesiate.size()) / dziesiate.rozmiar(), stopienDziesiate);
+    qInfo("Wartości całkowite: %.2f B/próbkę, kompresja %.2fx",
+          double(strumienCalkowite.size()) / calkowite.rozmiar(), stopienCalkowite);
+
+    QVERIFY2(stopienDziesiate >= KOMPRESJA_DZIESIATE, qPrintable(QString::number(stopienDziesiate)));
+    QVERIFY2(stopienCalkowite >= KOMPRESJA_CALKOWITE, qPrintable(QString::number(stopienCalkowite)));
+}
+
+/**
+ * @brief Sprawdza rozmiar rekordu z jedną dopisaną próbką.
+ */
+void KompresjaGorillaTest::dopisanieProbki() {
+    const QString sciezka = m_katalog.filePath("dopisanie.bin");
+    DziennikPomiarow dziennik(sciezka);
+    QVERIFY(dziennik.otworz());
+
+    QCOMPARE(dziennik.dopisz(7, seriaGodzinowa(0, 23, 21.0f)), 24);
+    const qint64 przed = QFileInfo(sciezka).size();
+
+    QCOMPARE(dziennik.dopisz(7, seriaGodzinowa(0, 24, 21.0f)), 1);
+    const qint64 dopisane = QFileInfo(sciezka).size() - przed;
+
+    // Rekord nie powtarza liczby próbek ani pełnego czasu pierwszej próbki.
+    const int rekordWprost = ROZMIAR_GLOWY_REKORDU + QByteArray("PM10").size() + ROZMIAR_PROBKI_WPROST;
+    QVERIFY2(dopisane < rekordWprost, qPrintable(QString::number(dopisane)));
+
+    const SeriaPomiarowa historia = dziennik.wczytaj(7);
+    QCOMPARE(historia.rozmiar(), 25);
+    QCOMPARE(historia.czas(24), POCZATEK_MS + 24 * GODZINA_MS);
+    QCOMPARE(historia.wartosc(24), 21.0f);
+    QCOMPARE(historia.parametr(), QString("PM10"));
+}
+
+/**
+ * @brief Sprawdza poprawki próbek oraz ponowne indeksowanie pliku bez indeksu.
+ */
+void KompresjaGorillaTest::poprawkiIPonowneOtwarcie() {
+    const QString sciezka = m_katalog.filePath("poprawki.bin");
+
+    auto sprawdz = [](const DziennikPomiarow& dziennik) {
+        const SeriaPomiarowa historia = dziennik.wczytaj(3);
+        QCOMPARE(historia.rozmiar(), 41);
+        for (int h = 0; h <= 40; ++h) {
+            QCOMPARE(historia.czas(h), POCZATEK_MS + h * GODZINA_MS);
+            QCOMPARE(historia.wartosc(h), h < 10 ? 1.0f : (h <= 30 ? 2.0f : 3.0f));
+        }
+
+        // Przedział z jednym rekordem jest przekazywany blokami dekodera, bez scalania.
+        int probki = 0;
+        const QString parametr = dziennik.przegladaj(3, POCZATEK_MS + 35 * GODZINA_MS, POCZATEK_MS + 40 * GODZINA_MS,
+                                                     [&probki](const WidokSerii& blok) {
+            for (int i = 0; i < blok.rozmiar(); ++i)
+                QCOMPARE(blok.wartosc(i), 3.0f);
+            probki += blok.rozmiar();
+        });
+        QCOMPARE(probki, 6);
+        QCOMPARE(parametr, QString("PM10"));
+    };
+
+    {
+        DziennikPomiarow dziennik(sciezka);
+        QVERIFY(dziennik.otworz());
+        QCOMPARE(dziennik.dopisz(3, seriaGodzinowa(0, 23, 1.0f)), 24);
+        QCOMPARE(dziennik.dopisz(3, seriaGodzinowa(10, 30, 2.0f)), 21);
+        QCOMPARE(dziennik.dopisz(3, seriaGodzinowa(31, 40, 3.0f)), 10);
+        sprawdz(dziennik);
+    }
+
+    {
+        DziennikPomiarow dziennik(sciezka);
+        QVERIFY(dziennik.otworz());
+        sprawdz(dziennik);
+    }
+
+    // Bez indeksu rekordy są indeksowane od nowa, a kotwice czasu liczone w kolejności zapisu.
+    QVERIFY(QFile::remove(m_katalog.filePath("poprawki.idx")));
+    DziennikPomiarow dziennik(sciezka);
+    QVERIFY(dziennik.otworz());
+    sprawdz(dziennik);
+}
+
+/**
+ * @brief Mierzy czas kodowania serii dobowej.
+ */
+void KompresjaGorillaTest::wydajnoscKodowania() {
+    const WidokSerii widok = m_seriaDobowa.calosc();
+    QByteArray strumien;
+    QBENCHMARK {
+        strumien = KompresjaGorilla::koduj(widok);
+    }
+    QVERIFY(!strumien.isEmpty());
+    qInfo("%.2f B/próbkę", double(strumien.size()) / widok.rozmiar());
+}
+
+/**
+ * @brief Mierzy czas dekodowania serii dobowej i podaje przepustowość w MB/s próbek zdekodowanych.
+ */
+void KompresjaGorillaTest::wydajnoscDekodowania() {
+    const WidokSerii widok = m_seriaDobowa.calosc();
+    const QByteArray strumien = KompresjaGorilla::koduj(widok);
+    int probki = 0;
+    qint64 przebiegi = 0;
+    QElapsedTimer zegar;
+    zegar.start();
+    QBENCHMARK {
+        KompresjaGorilla::Dekoder dekoder(strumien.constData(), strumien.size(), widok.rozmiar(), widok.pierwszyCzas());
+        probki = 0;
+        while (!dekoder.koniec())
+            probki += dekoder.nastepnyBlok().rozmiar();
+        ++przebiegi;
+    }
+    const qint64 ns = zegar.nsecsElapsed();
+    QCOMPARE(probki, ROZMIAR_SERII);
+    if (ns > 0)
+        qInfo("Dekodowanie: %.0f MB/s (%d B na próbkę zdekodowaną)",
+              double(przebiegi) * probki * ROZMIAR_PROBKI_WPROST * 1000.0 / ns, ROZMIAR_PROBKI_WPROST);
+}
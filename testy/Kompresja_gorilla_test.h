@@ -0,0 +1,73 @@
+/**
+ * @file Kompresja_gorilla_test.h
+ * @brief Plik nagłówkowy klasy KompresjaGorillaTest
+ *
+ * Klasa KompresjaGorillaTest zawiera testy i pomiary wydajności kompresji KompresjaGorilla
+ * oraz rekordów dziennika pomiarów, które z niej korzystają.
+*/
+
+#ifndef KOMPRESJA_GORILLA_TEST_H
+#define KOMPRESJA_GORILLA_TEST_H
+
+#include <QObject>
+#include <QTemporaryDir>
+#include <QVector>
+
+#include "../Seria_pomiarowa.h"
+
+/**
+ * @class KompresjaGorillaTest
+ * @brief Testy kodowania i dekodowania strumienia oraz dopisywania do DziennikPomiarow.
+ *
+ * Pomiary wydajności (QBENCHMARK) dotyczą realistycznej serii godzinowej o długości ROZMIAR_SERII;
+ * testy wypisują rozmiar strumienia w bajtach na próbkę i przepustowość dekodowania w MB/s.
+ */
+class KompresjaGorillaTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Przygotowuje serię godzinową z brakami i katalog na dziennik.
+     */
+    void initTestCase();
+
+    /**
+     * @brief Sprawdza kodowanie i dekodowanie blokami, z różnicą odniesienia i bez niej.
+     */
+    void kodowanieIDekodowanie();
+
+    /**
+     * @brief Mierzy i sprawdza stopień kompresji serii godzinowej o wolno zmiennych wartościach.
+     */
+    void stopienKompresjiSerii();
+
+    /**
+     * @brief Sprawdza, że dopisanie jednej próbki godzinowej jest mniejsze od rekordu zapisanego wprost.
+     */
+    void dopisanieProbki();
+
+    /**
+     * @brief Sprawdza odczyt rekordów z poprawkami próbek i po ponownym otwarciu dziennika.
+     */
+    void poprawkiIPonowneOtwarcie();
+
+    /**
+     * @brief Mierzy czas kodowania serii.
+     */
+    void wydajnoscKodowania();
+
+    /**
+     * @brief Mierzy czas dekodowania serii.
+     */
+    void wydajnoscDekodowania();
+
+private:
+    QVector<qint64> m_czas;        /**< Kolumna czasu serii */
+    QVector<float> m_wartosci;     /**< Kolumna wartości serii */
+    QVector<quint64> m_braki;      /**< Mapa braków serii */
+    SeriaPomiarowa m_seriaDobowa;  /**< Seria co godzinę z cyklem dobowym, wartości co 0,1 */
+    QTemporaryDir m_katalog;       /**< Katalog plików dziennika */
+};
+
+#endif // KOMPRESJA_GORILLA_TEST_H
@@ -0,0 +1,90 @@
+/**
+ * @file Odleglosci_test.cpp
+ * @brief Plik źródłowy klasy OdleglosciTest
+ */
+
+#include "Odleglosci_test.h"
+#include "../Odleglosci.h"
+
+#include <QRandomGenerator>
+#include <QTest>
+
+namespace {
+const int LICZBA_PUNKTOW = 4099;       // nieparzysta i niepodzielna przez 4 (końcówki pętli wektorowych)
+const double POZNAN_LAT = 52.4064;
+const double POZNAN_LON = 16.9252;
+const double BLAD_DOKLADNY_KM = 1e-9;
+const double BLAD_PRZYBLIZONY_KM = 3e-4;
+}
+
+/**
+ * @brief Losuje punkty w prostokącie 49..55 N, 14..24 E.
+ */
+void OdleglosciTest::initTestCase() {
+    QRandomGenerator generator(2024);
+    for (int i = 0; i < LICZBA_PUNKTOW; ++i) {
+        m_lat.append(49.0 + 6.0 * generator.generateDouble());
+        m_lon.append(14.0 + 10.0 * generator.generateDouble());
+    }
+}
+
+/**
+ * @brief Sprawdza odPunktu względem wzoru haversine.
+ */
+void OdleglosciTest::odPunktuZgodneZHaversine() {
+    const Odleglosci::Punkty punkty = Odleglosci::przygotuj(m_lat, m_lon);
+    QCOMPARE(punkty.rozmiar(), LICZBA_PUNKTOW);
+
+    QVector<double> dokladne(LICZBA_PUNKTOW);
+    QVector<double> przyblizone(LICZBA_PUNKTOW);
+    Odleglosci::odPunktu(POZNAN_LAT, POZNAN_LON, punkty, dokladne.data());
+    Odleglosci::odPunktu(POZNAN_LAT, POZNAN_LON, punkty, przyblizone.data(), true);
+
+    for (int i = 0; i < LICZBA_PUNKTOW; ++i) {
+        const double wzorzec = Odleglosci::haversine(POZNAN_LAT, POZNAN_LON, m_lat[i], m_lon[i]);
+        QVERIFY2(qAbs(dokladne[i] - wzorzec) <= BLAD_DOKLADNY_KM, qPrintable(QString::number(i)));
+        QVERIFY2(qAbs(przyblizone[i] - wzorzec) <= BLAD_PRZYBLIZONY_KM, qPrintable(QString::number(i)));
+    }
+}
+
+/**
+ * @brief Sprawdza macierz odległości 7 punktów.
+ */
+void OdleglosciTest::macierzOdleglosci() {
+    const int n = 7;
+    const Odleglosci::Punkty punkty = Odleglosci::przygotuj(m_lat.mid(0, n), m_lon.mid(0, n));
+    const QVector<double> macierz = Odleglosci::macierz(punkty);
+    QCOMPARE(macierz.size(), n * n);
+
+    for (int i = 0; i < n; ++i) {
+        QVERIFY(macierz[i * n + i] <= BLAD_DOKLADNY_KM);
+        for (int j = 0; j < n; ++j) {
+            const double wzorzec = Odleglosci::haversine(m_lat[i], m_lon[i], m_lat[j], m_lon[j]);
+            QVERIFY(qAbs(macierz[i * n + j] - wzorzec) <= BLAD_DOKLADNY_KM);
+        }
+    }
+}
+
+/**
+ * @brief Mierzy czas wariantu dokładnego.
+ */
+void OdleglosciTest::wydajnoscOdPunktu() {
+    const Odleglosci::Punkty punkty = Odleglosci::przygotuj(m_lat, m_lon);
+    QVector<double> wynik(LICZBA_PUNKTOW);
+    QBENCHMARK {
+        Odleglosci::odPunktu(POZNAN_LAT, POZNAN_LON, punkty, wynik.data());
+    }
+    QVERIFY(wynik.first() > 0.0);
+}
+
+/**
+ * @brief Mierzy czas wariantu przybliżonego.
+ */
+void OdleglosciTest::wydajnoscOdPunktuPrzyblizona() {
+    const Odleglosci::Punkty punkty = Odleglosci::przygotuj(m_lat, m_lon);
+    QVector<double> wynik(LICZBA_PUNKTOW);
+    QBENCHMARK {
+        Odleglosci::odPunktu(POZNAN_LAT, POZNAN_LON, punkty, wynik.data(), true);
+    }
+    QVERIFY(wynik.first() > 0.0);
+}
@@ -0,0 +1,57 @@
+/**
+ * @file Odleglosci_test.h
+ * @brief Plik nagłówkowy klasy OdleglosciTest
+ *
+ * Klasa OdleglosciTest zawiera testy i pomiary wydajności wsadowych obliczeń odległości (Odleglosci).
+*/
+
+#ifndef ODLEGLOSCI_TEST_H
+#define ODLEGLOSCI_TEST_H
+
+#include <QObject>
+#include <QVector>
+
+/**
+ * @class OdleglosciTest
+ * @brief Testy Odleglosci::odPunktu i Odleglosci::macierz względem wzoru haversine.
+ *
+ * Punkty są losowane (ze stałym ziarnem) w prostokącie obejmującym Polskę. Ich liczba jest nieparzysta
+ * i niepodzielna przez 4, więc sprawdzane są też końcówki pętli wektorowych. Pomiary wydajności
+ * (QBENCHMARK) dotyczą wariantu wybranego dla procesora, na którym działają testy (AVX2, SSE2 albo skalarny).
+ */
+class OdleglosciTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Losuje punkty.
+     */
+    void initTestCase();
+
+    /**
+     * @brief Sprawdza dokładny i przybliżony wariant odPunktu.
+     */
+    void odPunktuZgodneZHaversine();
+
+    /**
+     * @brief Sprawdza macierz odległości niewielkiego zbioru punktów.
+     */
+    void macierzOdleglosci();
+
+    /**
+     * @brief Mierzy czas obliczenia odległości od punktu (wariant dokładny).
+     */
+    void wydajnoscOdPunktu();
+
+    /**
+     * @brief Mierzy czas obliczenia odległości od punktu (wariant przybliżony).
+     */
+    void wydajnoscOdPunktuPrzyblizona();
+
+private:
+    QVector<double> m_lat;   /**< Szerokości geograficzne punktów */
+    QVector<double> m_lon;   /**< Długości geograficzne punktów */
+};
+
+#endif // ODLEGLOSCI_TEST_H
@@ -0,0 +1,77 @@
+/**
+ * @file Parser_czasu_test.cpp
+ * @brief Plik źródłowy klasy ParserCzasuTest
+ */
+
+#include "Parser_czasu_test.h"
+#include "../Parser_czasu.h"
+
+#include <QDateTime>
+#include <QTest>
+#include <QTimeZone>
+
+/**
+ * @brief Sprawdza formaty z jawną strefą.
+ */
+void ParserCzasuTest::formatyZeStrefa() {
+    const qint64 oczekiwany = QDateTime(QDate(2024, 3, 1), QTime(12, 30), QTimeZone::utc()).toMSecsSinceEpoch();
+    qint64 wynik = 0;
+
+    QVERIFY(ParserCzasu::parsuj(u"2024-03-01T12:30:00Z", &wynik));
+    QCOMPARE(wynik, oczekiwany);
+    QVERIFY(ParserCzasu::parsuj(u"2024-03-01T14:30:00+02:00", &wynik));
+    QCOMPARE(wynik, oczekiwany);
+    QVERIFY(ParserCzasu::parsuj(u"2024-03-01T10:30-02:00", &wynik));
+    QCOMPARE(wynik, oczekiwany);
+    QVERIFY(ParserCzasu::parsuj(u"2024-03-01T12:30:00.250Z", &wynik));
+    QCOMPARE(wynik, oczekiwany);
+
+    QVERIFY(!ParserCzasu::parsuj(u"2024-03-01", &wynik));
+    QVERIFY(!ParserCzasu::parsuj(u"2024/03/01 12:30", &wynik));
+    QVERIFY(!ParserCzasu::parsuj(u"2024-03-01 24:00", &wynik));
+    QVERIFY(!ParserCzasu::parsuj(u"2024-03-01T12:30:00+0200", &wynik));
+}
+
+/**
+ * @brief Sprawdza przeliczenie czasu lokalnego (także po obu stronach zmiany czasu).
+ */
+void ParserCzasuTest::czasLokalny() {
+    const QDateTime daty[] = {
+        QDateTime(QDate(2024, 1, 15), QTime(8, 0)),
+        QDateTime(QDate(2024, 7, 15), QTime(8, 0)),
+        QDateTime(QDate(2024, 10, 27), QTime(5, 0)),
+    };
+
+    for (const QDateTime& data : daty) {
+        qint64 wynik = 0;
+        QVERIFY(ParserCzasu::parsuj(data.toString("yyyy-MM-dd HH:mm:ss"), &wynik));
+        QCOMPARE(wynik, data.toMSecsSinceEpoch());
+    }
+}
+
+/**
+ * @brief Sprawdza walidację dnia miesiąca.
+ */
+void ParserCzasuTest::dzienMiesiaca() {
+    qint64 wynik = 0;
+
+    QVERIFY(!ParserCzasu::parsuj(u"2023-02-31 00:00", &wynik));
+    QVERIFY(!ParserCzasu::parsuj(u"2023-02-29 00:00", &wynik));
+    QVERIFY(!ParserCzasu::parsuj(u"2023-04-31 00:00", &wynik));
+    QVERIFY(!ParserCzasu::parsuj(u"1900-02-29 00:00Z", &wynik));
+    QVERIFY(!ParserCzasu::parsuj(u"2023-13-01 00:00", &wynik));
+    QVERIFY(!ParserCzasu::parsuj(u"2023-01-00 00:00", &wynik));
+
+    QVERIFY(ParserCzasu::parsuj(u"2024-02-29 00:00Z", &wynik));
+    QVERIFY(ParserCzasu::parsuj(u"2000-02-29 00:00Z", &wynik));
+    QVERIFY(ParserCzasu::parsuj(u"2023-12-31 23:59:59Z", &wynik));
+}
+
+/**
+ * @brief Sprawdza wartość domyślną dla niepoprawnego tekstu.
+ */
+void ParserCzasuTest::wartoscDomyslna() {
+    QCOMPARE(ParserCzasu::parsujLubDomyslna(u"2023-02-31 00:00", -1), qint64(-1));
+    QCOMPARE(ParserCzasu::parsujLubDomyslna(u"bez daty"), qint64(0));
+    QCOMPARE(ParserCzasu::parsujLubDomyslna(u"1970-01-01T00:00:01Z", -1), qint64(1000));
+}
@@ -0,0 +1,43 @@
+/**
+ * @file Parser_czasu_test.h
+ * @brief Plik nagłówkowy klasy ParserCzasuTest
+ *
+ * Klasa ParserCzasuTest zawiera testy jednostkowe parsera znaczników czasu (ParserCzasu).
+*/
+
+#ifndef PARSER_CZASU_TEST_H
+#define PARSER_CZASU_TEST_H
+
+#include <QObject>
+
+/**
+ * @class ParserCzasuTest
+ * @brief Testy formatów, stref czasowych i walidacji dat parsera ParserCzasu.
+ */
+class ParserCzasuTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Sprawdza formaty z jawną strefą (wynik niezależny od strefy systemowej).
+     */
+    void formatyZeStrefa();
+
+    /**
+     * @brief Sprawdza, że czas lokalny jest zgodny z przeliczeniem QDateTime.
+     */
+    void czasLokalny();
+
+    /**
+     * @brief Sprawdza odrzucanie dni spoza miesiąca (np. 31 lutego) i 29 lutego w latach przestępnych.
+     */
+    void dzienMiesiaca();
+
+    /**
+     * @brief Sprawdza wartość domyślną dla niepoprawnego tekstu.
+     */
+    void wartoscDomyslna();
+};
+
+#endif // PARSER_CZASU_TEST_H
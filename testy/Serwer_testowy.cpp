@@ -0,0 +1,133 @@
+/**
+ * @file Serwer_testowy.cpp
+ * @brief Plik źródłowy klasy SerwerTestowy
+ */
+
+#include "Serwer_testowy.h"
+
+#include <QHostAddress>
+#include <QTcpSocket>
+
+/**
+ * @brief Konstruktor klasy SerwerTestowy.
+ *
+ * @param parent Obiekt rodzica.
+ */
+SerwerTestowy::SerwerTestowy(QObject *parent) :
+    QTcpServer(parent)
+{
+    connect(this, &QTcpServer::newConnection, this, [this]() {
+        while (QTcpSocket *polaczenie = nextPendingConnection()) {
+            connect(polaczenie, &QTcpSocket::readyRead, this, [this, polaczenie]() { obsluz(polaczenie); });
+            connect(polaczenie, &QTcpSocket::disconnected, polaczenie, &QObject::deleteLater);
+        }
+    });
+}
+
+/**
+ * @brief Uruchamia nasłuchiwanie na wolnym porcie.
+ *
+ * @return true jeśli serwer nasłuchuje.
+ */
+bool SerwerTestowy::uruchom() {
+    return listen(QHostAddress::LocalHost, 0);
+}
+
+/**
+ * @brief Zwraca adres bazowy serwera.
+ *
+ * @return Adres bazowy zakończony ukośnikiem.
+ */
+QString SerwerTestowy::adres() const {
+    return QString("http://127.0.0.1:%1/").arg(serverPort());
+}
+
+/**
+ * @brief Ustawia odpowiedź dla ścieżki.
+ *
+ * @param sciezka Ścieżka wraz z zapytaniem.
+ * @param odpowiedz Odpowiedź.
+ */
+void SerwerTestowy::ustaw(const QByteArray& sciezka, const Odpowiedz& odpowiedz) {
+    m_odpowiedzi.insert(sciezka, odpowiedz);
+}
+
+/**
+ * @brief Zwraca odebrane zapytania.
+ *
+ * @return Lista zapytań.
+ */
+const QVector<SerwerTestowy::Zapytanie>& SerwerTestowy::zapytania() const {
+    return m_zapytania;
+}
+
+/**
+ * @brief Zlicza zapytania o ścieżki z prefiksem.
+ *
+ * @param prefiks Początek ścieżki.
+ * @return int Liczba zapytań.
+ */
+int SerwerTestowy::liczbaZapytan(const QByteArray& prefiks) const {
+    int liczba = 0;
+    for (const Zapytanie& zapytanie : m_zapytania) {
+        if (zapytanie.sciezka.startsWith(prefiks))
+            ++liczba;
+    }
+    return liczba;
+}
+
+/**
+ * @brief Usuwa zapamiętane zapytania.
+ */
+void SerwerTestowy::wyczyscZapytania() {
+    m_zapytania.clear();
+}
+
+/**
+ * @brief Obsługuje zapytanie GET, gdy dotarły wszystkie nagłówki.
+ *
+ * Odpowiedź zamyka połączenie (Connection: close), więc treść nie wymaga kodowania fragmentami.
+ *
+ * @param polaczenie Połączenie klienta.
+ */
+void SerwerTestowy::obsluz(QTcpSocket *polaczenie) {
+    QByteArray bufor = polaczenie->property("bufor").toByteArray() + polaczenie->readAll();
+    const int koniec = bufor.indexOf("\r\n\r\n");
+    if (koniec < 0) {
+        polaczenie->setProperty("bufor", bufor);
+        return;
+    }
+
+    const QList<QByteArray> linie = bufor.left(koniec).split('\n');
+    Zapytanie zapytanie;
+    zapytanie.sciezka = linie.value(0).split(' ').value(1);
+    for (int i = 1; i < linie.size(); ++i) {
+        const int dwukropek = linie[i].indexOf(':');
+        if (dwukropek > 0)
+            zapytanie.naglowki.insert(linie[i].left(dwukropek).trimmed().toLower(), linie[i].mid(dwukropek + 1).trimmed());
+    }
+
+    const auto it = m_odpowiedzi.constFind(zapytanie.sciezka);
+    Odpowiedz odpowiedz;
+    if (it == m_odpowiedzi.constEnd())
+        odpowiedz.status = 404;
+    else if (!it->etag.isEmpty() && zapytanie.naglowki.value("if-none-match") == it->etag)
+        odpowiedz.status = 304;
+    else
+        odpowiedz = *it;
+
+    const char *opis = odpowiedz.status == 200 ? "OK" : odpowiedz.status == 304 ? "Not Modified" : "Error";
+    QByteArray wynik = "HTTP/1.1 " + QByteArray::number(odpowiedz.status) + ' ' + opis + "\r\n";
+    wynik += "Content-Type: application/json\r\n";
+    if (it != m_odpowiedzi.constEnd() && !it->etag.isEmpty())
+        wynik += "ETag: " + it->etag + "\r\n";
+    wynik += "Content-Length: " + QByteArray::number(odpowiedz.tresc.size()) + "\r\n";
+    wynik += "Connection: close\r\n\r\n";
+    wynik += odpowiedz.tresc;
+
+    zapytanie.status = odpowiedz.status;
+    m_zapytania.append(zapytanie);
+
+    polaczenie->write(wynik);
+    polaczenie->disconnectFromHost();
+}
@@ -0,0 +1,104 @@
+/**
+ * @file Serwer_testowy.h
+ * @brief Plik nagłówkowy klasy SerwerTestowy
+ *
+ * Klasa SerwerTestowy to lokalny serwer HTTP zwracający przygotowane odpowiedzi API
+ * i zapamiętujący otrzymane zapytania (na potrzeby testów APIService).
+*/
+
+#ifndef SERWER_TESTOWY_H
+#define SERWER_TESTOWY_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QTcpServer>
+#include <QVector>
+
+/**
+ * @class SerwerTestowy
+ * @brief Atrapa API na 127.0.0.1 (HTTP/1.1, jedno zapytanie na połączenie).
+ *
+ * Odpowiedzi są przypisane do ścieżek wraz z zapytaniem (np. "/station/findAll?page=0&size=500").
+ * Odpowiedź z ETagiem jest rewalidowana jak na prawdziwym serwerze: zapytanie z pasującym
+ * nagłówkiem If-None-Match dostaje 304 Not Modified bez treści.
+ */
+class SerwerTestowy : public QTcpServer
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @struct Odpowiedz
+     * @brief Przygotowana odpowiedź dla jednej ścieżki.
+     */
+    struct Odpowiedz {
+        int status = 200;          /**< Kod HTTP */
+        QByteArray tresc;          /**< Treść odpowiedzi */
+        QByteArray etag;           /**< Nagłówek ETag (pusty - bez rewalidacji) */
+    };
+
+    /**
+     * @struct Zapytanie
+     * @brief Zapytanie odebrane przez serwer.
+     */
+    struct Zapytanie {
+        QByteArray sciezka;                      /**< Ścieżka wraz z zapytaniem */
+        QHash<QByteArray, QByteArray> naglowki;  /**< Nagłówki (nazwy małymi literami) */
+        int status = 0;                          /**< Kod HTTP wysłanej odpowiedzi */
+    };
+
+    /**
+     * @brief Konstruktor klasy SerwerTestowy.
+     * @param parent Obiekt rodzica.
+     */
+    explicit SerwerTestowy(QObject *parent = nullptr);
+
+    /**
+     * @brief Uruchamia nasłuchiwanie na wolnym porcie interfejsu lokalnego.
+     * @return true jeśli serwer nasłuchuje.
+     */
+    bool uruchom();
+
+    /**
+     * @brief Zwraca adres bazowy serwera (do APIService::ustawAdresBazowy).
+     * @return Adres w postaci "http://127.0.0.1:port/".
+     */
+    QString adres() const;
+
+    /**
+     * @brief Ustawia odpowiedź dla ścieżki.
+     * @param sciezka Ścieżka wraz z zapytaniem, zaczynająca się od "/".
+     * @param odpowiedz Odpowiedź (nieznane ścieżki dostają 404).
+     */
+    void ustaw(const QByteArray& sciezka, const Odpowiedz& odpowiedz);
+
+    /**
+     * @brief Zwraca odebrane zapytania w kolejności odebrania.
+     * @return Lista zapytań.
+     */
+    const QVector<Zapytanie>& zapytania() const;
+
+    /**
+     * @brief Zlicza zapytania o ścieżki zaczynające się od prefiksu.
+     * @param prefiks Początek ścieżki.
+     * @return Liczba zapytań.
+     */
+    int liczbaZapytan(const QByteArray& prefiks) const;
+
+    /**
+     * @brief Usuwa zapamiętane zapytania.
+     */
+    void wyczyscZapytania();
+
+private:
+    /**
+     * @brief Odczytuje zapytanie z połączenia i wysyła odpowiedź, gdy nagłówki są kompletne.
+     * @param polaczenie Połączenie klienta.
+     */
+    void obsluz(QTcpSocket *polaczenie);
+
+    QHash<QByteArray, Odpowiedz> m_odpowiedzi;   /**< Odpowiedzi według ścieżki */
+    QVector<Zapytanie> m_zapytania;              /**< Odebrane zapytania */
+};
+
+#endif // SERWER_TESTOWY_H
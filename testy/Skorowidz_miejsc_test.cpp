@@ -0,0 +1,121 @@
+/**
+ * @file Skorowidz_miejsc_test.cpp
+ * @brief Plik źródłowy klasy SkorowidzMiejscTest
+ */
+
+#include "Skorowidz_miejsc_test.h"
+#include "../Skorowidz_miejsc.h"
+
+#include <QBuffer>
+#include <QTest>
+
+namespace {
+const QByteArray GEONAMES =
+    "PL\t60-695\tPoznań\tWielkopolskie\t86\tPoznań\t3064\tPoznań\t306401\t52.44\t16.88\t4\n"
+    "PL\t61-001\tPoznań\tWielkopolskie\t86\tPoznań\t3064\tPoznań\t306401\t52.40\t16.92\t4\n"
+    "PL\t05-340\tNowa Wieś\tMazowieckie\t78\tPowiat miński\t1412\tKołbiel\t141204\t51.97\t21.60\t4\n"
+    "PL\t62-020\tNowa Wieś\tWielkopolskie\t86\tPowiat poznański\t3021\tSwarzędz\t302110\t52.43\t17.08\t4\n"
+    "PL\t32-082\tPolanka\tMałopolskie\t72\tPowiat krakowski\t1206\tZabierzów\t120613\t50.11\t19.78\t4\n"
+    "PL\tniepełny wiersz\n";
+
+/**
+ * @brief Odczytuje wpisy z wierszy GeoNames.
+ */
+QVector<SkorowidzMiejsc::Miejsce> wpisyGeoNames() {
+    QBuffer bufor;
+    bufor.setData(GEONAMES);
+    bufor.open(QIODevice::ReadOnly);
+    return SkorowidzMiejsc::zGeoNames(&bufor);
+}
+}
+
+/**
+ * @brief Zapisuje skorowidz do katalogu tymczasowego.
+ */
+void SkorowidzMiejscTest::initTestCase() {
+    QVERIFY(m_katalog.isValid());
+    m_sciezka = m_katalog.filePath("skorowidz.skm");
+    QVERIFY(SkorowidzMiejsc::zapisz(m_sciezka, wpisyGeoNames()));
+}
+
+/**
+ * @brief Sprawdza wpisy z pliku GeoNames.
+ */
+void SkorowidzMiejscTest::importGeoNames() {
+    const QVector<SkorowidzMiejsc::Miejsce> wpisy = wpisyGeoNames();
+
+    // Pięć kodów pocztowych i cztery miejscowości (Nowa Wieś osobno w każdym województwie).
+    QCOMPARE(wpisy.size(), 9);
+    QCOMPARE(wpisy[0].rodzaj, SkorowidzMiejsc::KodPocztowy);
+    QCOMPARE(wpisy[0].nazwa, QString("60-695"));
+    QCOMPARE(wpisy[0].miejscowosc, QString("Poznań"));
+
+    QCOMPARE(wpisy[5].rodzaj, SkorowidzMiejsc::Miejscowosc);
+    QCOMPARE(wpisy[5].nazwa, QString("Poznań"));
+    QCOMPARE(wpisy[5].lat, (52.44 + 52.40) / 2);
+    QCOMPARE(wpisy[5].lon, (16.88 + 16.92) / 2);
+}
+
+/**
+ * @brief Sprawdza rozpoznanie jednoznaczne.
+ */
+void SkorowidzMiejscTest::rozpoznanieDokladne() {
+    SkorowidzMiejsc skorowidz;
+    QVERIFY(skorowidz.otworz(m_sciezka));
+    QCOMPARE(skorowidz.rozmiar(), 9);
+
+    const SkorowidzMiejsc::Rozpoznanie miasto = skorowidz.rozwiaz("poznań");
+    QVERIFY(miasto.znaleziono);
+    QVERIFY(miasto.dokladne);
+    QCOMPARE(miasto.miejsce.rodzaj, SkorowidzMiejsc::Miejscowosc);
+    QCOMPARE(miasto.miejsce.lat, 52.42);
+
+    const SkorowidzMiejsc::Rozpoznanie kod = skorowidz.rozwiaz("60-695 Poznań");
+    QVERIFY(kod.dokladne);
+    QCOMPARE(kod.miejsce.nazwa, QString("60-695"));
+
+    const SkorowidzMiejsc::Rozpoznanie budynek = skorowidz.rozwiaz("60-695 Poznań, Polanka 3");
+    QVERIFY(budynek.znaleziono);
+    QVERIFY(!budynek.dokladne);
+}
+
+/**
+ * @brief Sprawdza rozpoznanie niejednoznaczne.
+ */
+void SkorowidzMiejscTest::rozpoznanieNiejednoznaczne() {
+    SkorowidzMiejsc skorowidz;
+    QVERIFY(skorowidz.otworz(m_sciezka));
+
+    const SkorowidzMiejsc::Rozpoznanie nazwa = skorowidz.rozwiaz("Nowa Wieś");
+    QVERIFY(nazwa.znaleziono);
+    QVERIFY(!nazwa.dokladne);
+
+    const SkorowidzMiejsc::Rozpoznanie zKodem = skorowidz.rozwiaz("62-020 Nowa Wieś");
+    QVERIFY(zKodem.dokladne);
+    QCOMPARE(zKodem.miejsce.nazwa, QString("62-020"));
+    QCOMPARE(zKodem.miejsce.lon, 17.08);
+}
+
+/**
+ * @brief Sprawdza adresy, w których nazwa ulicy jest też nazwą miejscowości.
+ */
+void SkorowidzMiejscTest::ulicaONazwieMiejscowosci() {
+    SkorowidzMiejsc skorowidz;
+    QVERIFY(skorowidz.otworz(m_sciezka));
+
+    // Część z numerem budynku jest ulicą, nawet jeśli istnieje wieś Polanka.
+    const SkorowidzMiejsc::Rozpoznanie zNumerem = skorowidz.rozwiaz("Polanka 3, Poznań");
+    QVERIFY(zNumerem.znaleziono);
+    QVERIFY(!zNumerem.dokladne);
+    QCOMPARE(zNumerem.miejsce.nazwa, QString("Poznań"));
+    QCOMPARE(zNumerem.miejsce.lat, 52.42);
+
+    // Bez numeru obowiązuje kolejność "miasto, ulica".
+    const SkorowidzMiejsc::Rozpoznanie bezNumeru = skorowidz.rozwiaz("Poznań, Polanka");
+    QVERIFY(!bezNumeru.dokladne);
+    QCOMPARE(bezNumeru.miejsce.nazwa, QString("Poznań"));
+
+    const SkorowidzMiejsc::Rozpoznanie wies = skorowidz.rozwiaz("Polanka");
+    QVERIFY(wies.dokladne);
+    QCOMPARE(wies.miejsce.lat, 50.11);
+}
@@ -0,0 +1,56 @@
+/**
+ * @file Skorowidz_miejsc_test.h
+ * @brief Plik nagłówkowy klasy SkorowidzMiejscTest
+ *
+ * Klasa SkorowidzMiejscTest zawiera testy budowy skorowidza z pliku GeoNames i rozpoznawania adresów.
+*/
+
+#ifndef SKOROWIDZ_MIEJSC_TEST_H
+#define SKOROWIDZ_MIEJSC_TEST_H
+
+#include <QObject>
+#include <QTemporaryDir>
+
+/**
+ * @class SkorowidzMiejscTest
+ * @brief Testy SkorowidzMiejsc::zGeoNames, zapisz i rozwiaz.
+ *
+ * Skorowidz zawiera Poznań (dwa kody), dwie miejscowości Nowa Wieś w różnych województwach
+ * oraz wieś Polanka (nazwa, która jest też nazwą ulicy w Poznaniu).
+ */
+class SkorowidzMiejscTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Buduje skorowidz z wierszy GeoNames w katalogu tymczasowym.
+     */
+    void initTestCase();
+
+    /**
+     * @brief Sprawdza wpisy odczytane z pliku GeoNames.
+     */
+    void importGeoNames();
+
+    /**
+     * @brief Sprawdza rozpoznanie jednoznacznej miejscowości i adresu z numerem budynku.
+     */
+    void rozpoznanieDokladne();
+
+    /**
+     * @brief Sprawdza, że kilka pasujących wpisów daje wynik niedokładny, chyba że rozróżnia je kod.
+     */
+    void rozpoznanieNiejednoznaczne();
+
+    /**
+     * @brief Sprawdza, że ulica z numerem budynku nie jest brana za miejscowość o tej samej nazwie.
+     */
+    void ulicaONazwieMiejscowosci();
+
+private:
+    QTemporaryDir m_katalog;   /**< Katalog pliku skorowidza */
+    QString m_sciezka;         /**< Ścieżka pliku skorowidza */
+};
+
+#endif // SKOROWIDZ_MIEJSC_TEST_H
@@ -0,0 +1,220 @@
+/**
+ * @file Statystyki_strumieniowe_test.cpp
+ * @brief Plik źródłowy klasy StatystykiStrumienioweTest
+ */
+
+#include "Statystyki_strumieniowe_test.h"
+#include "../Statystyki_strumieniowe.h"
+
+#include <QRandomGenerator>
+#include <QTest>
+
+#include <algorithm>
+
+namespace {
+const qint64 GODZINA_MS = 3600 * 1000LL;
+const qint64 POCZATEK_MS = 1704067200000LL;   // 2024-01-01 00:00 UTC
+const int ROZMIAR_SERII = 20000;
+const double BLAD_KWANTYLA = 0.01;             // względem rozstępu serii
+const double BLAD_WZGLEDNY = 1e-9;
+
+/**
+ * @brief Zwraca kwantyl posortowanej tablicy z interpolacją liniową między próbkami.
+ */
+double kwantylDokladny(const QVector<double>& posortowane, double p) {
+    const double h = (posortowane.size() - 1) * p;
+    const int i = int(h);
+    return i + 1 < posortowane.size() ? posortowane[i] + (h - i) * (posortowane[i + 1] - posortowane[i]) : posortowane[i];
+}
+
+/**
+ * @brief Sprawdza, czy wartości różnią się najwyżej o błąd względny.
+ */
+bool bliskie(double a, double b, double blad) {
+    return qAbs(a - b) <= blad * qMax(1.0, qMax(qAbs(a), qAbs(b)));
+}
+}
+
+/**
+ * @brief Losuje serię (kwadrat rozkładu jednostajnego, jak stężenia z rzadkimi wysokimi wartościami).
+ */
+void StatystykiStrumienioweTest::initTestCase() {
+    QRandomGenerator generator(2024);
+    for (int i = 0; i < ROZMIAR_SERII; ++i) {
+        const double u = generator.generateDouble();
+        m_czas.append(POCZATEK_MS + i * GODZINA_MS);
+        m_wartosci.append(5.0 + 120.0 * u * u);
+    }
+}
+
+/**
+ * @brief Porównuje kwantyle P² z dokładnymi.
+ */
+void StatystykiStrumienioweTest::kwantyleP2() {
+    StatystykiStrumieniowe statystyki;
+    for (int i = 0; i < m_czas.size(); ++i)
+        QVERIFY(statystyki.dodaj(m_czas[i], m_wartosci[i]));
+
+    QVector<double> posortowane = m_wartosci;
+    std::sort(posortowane.begin(), posortowane.end());
+    const double rozstep = posortowane.last() - posortowane.first();
+
+    const QPair<StatystykiStrumieniowe::Kwantyl, double> kwantyle[] = {
+        {StatystykiStrumieniowe::Mediana, 0.5},
+        {StatystykiStrumieniowe::P90, 0.9},
+        {StatystykiStrumieniowe::P98, 0.98},
+    };
+    for (const auto& kwantyl : kwantyle) {
+        const double szacowany = statystyki.kwantyl(kwantyl.first);
+        const double dokladny = kwantylDokladny(posortowane, kwantyl.second);
+        QVERIFY2(qAbs(szacowany - dokladny) <= BLAD_KWANTYLA * rozstep,
+                 qPrintable(QString("p%1: %2 zamiast %3").arg(kwantyl.second).arg(szacowany).arg(dokladny)));
+    }
+}
+
+/**
+ * @brief Sprawdza kwantyle liczone dokładnie dla n <= 5.
+ */
+void StatystykiStrumienioweTest::kwantyleDokladne() {
+    StatystykiStrumieniowe statystyki;
+    QCOMPARE(statystyki.kwantyl(StatystykiStrumieniowe::Mediana), 0.0);
+
+    statystyki.dodaj(POCZATEK_MS, 7.0);
+    QCOMPARE(statystyki.kwantyl(StatystykiStrumieniowe::Mediana), 7.0);
+    QCOMPARE(statystyki.kwantyl(StatystykiStrumieniowe::P98), 7.0);
+
+    statystyki.dodaj(POCZATEK_MS + GODZINA_MS, 3.0);
+    QCOMPARE(statystyki.kwantyl(StatystykiStrumieniowe::Mediana), 5.0);
+    QCOMPARE(statystyki.kwantyl(StatystykiStrumieniowe::P90), 6.6);
+
+    // Próbki w kolejności nieposortowanej: 7, 3, 5, 1, 9.
+    statystyki.dodaj(POCZATEK_MS + 2 * GODZINA_MS, 5.0);
+    statystyki.dodaj(POCZATEK_MS + 3 * GODZINA_MS, 1.0);
+    statystyki.dodaj(POCZATEK_MS + 4 * GODZINA_MS, 9.0);
+    QCOMPARE(statystyki.liczba(), qint64(5));
+    QCOMPARE(statystyki.kwantyl(StatystykiStrumieniowe::Mediana), 5.0);
+    QCOMPARE(statystyki.kwantyl(StatystykiStrumieniowe::P90), 8.2);
+    QCOMPARE(statystyki.kwantyl(StatystykiStrumieniowe::P98), 8.84);
+
+    // Od szóstej próbki wynik daje środkowy znacznik P².
+    statystyki.dodaj(POCZATEK_MS + 5 * GODZINA_MS, 4.0);
+    const double mediana = statystyki.kwantyl(StatystykiStrumieniowe::Mediana);
+    QVERIFY(mediana >= 3.0 && mediana <= 7.0);
+}
+
+/**
+ * @brief Sprawdza okna kończące się na ostatniej próbce.
+ *
+ * Próbka starsza od ostatniej dokładnie o długość okna już do niego nie należy.
+ */
+void StatystykiStrumienioweTest::oknaKroczace() {
+    StatystykiStrumieniowe statystyki;
+    QCOMPARE(statystyki.sredniaKroczaca(StatystykiStrumieniowe::Okno1h), 0.0);
+
+    for (int h = 0; h < 30; ++h)
+        statystyki.dodaj(POCZATEK_MS + h * GODZINA_MS, h);
+    const qint64 ostatni = POCZATEK_MS + 29 * GODZINA_MS;
+
+    QCOMPARE(statystyki.liczbaWOknie(StatystykiStrumieniowe::Okno1h), 1);
+    QCOMPARE(statystyki.sredniaKroczaca(StatystykiStrumieniowe::Okno1h), 29.0);
+    QCOMPARE(statystyki.liczbaWOknie(StatystykiStrumieniowe::Okno8h), 8);
+    QCOMPARE(statystyki.sredniaKroczaca(StatystykiStrumieniowe::Okno8h), 25.5);
+    QCOMPARE(statystyki.liczbaWOknie(StatystykiStrumieniowe::Okno24h), 24);
+    QCOMPARE(statystyki.sredniaKroczaca(StatystykiStrumieniowe::Okno24h), 17.5);
+
+    // Pół godziny po ostatniej próbce poprzednia jest jeszcze w oknie 1 h...
+    statystyki.dodaj(ostatni + GODZINA_MS / 2, 100.0);
+    QCOMPARE(statystyki.liczbaWOknie(StatystykiStrumieniowe::Okno1h), 2);
+    QCOMPARE(statystyki.sredniaKroczaca(StatystykiStrumieniowe::Okno1h), 64.5);
+
+    // ...a dokładnie godzinę po niej już nie.
+    statystyki.dodaj(ostatni + GODZINA_MS, 50.0);
+    QCOMPARE(statystyki.liczbaWOknie(StatystykiStrumieniowe::Okno1h), 2);
+    QCOMPARE(statystyki.sredniaKroczaca(StatystykiStrumieniowe::Okno1h), 75.0);
+    QCOMPARE(statystyki.liczbaWOknie(StatystykiStrumieniowe::Okno8h), 9);
+    QCOMPARE(statystyki.liczbaWOknie(StatystykiStrumieniowe::Okno24h), 25);
+
+    // Po przerwie dłuższej niż doba każde okno zawiera tylko nową próbkę.
+    statystyki.dodaj(ostatni + 30 * GODZINA_MS, 12.0);
+    QCOMPARE(statystyki.liczbaWOknie(StatystykiStrumieniowe::Okno24h), 1);
+    QCOMPARE(statystyki.sredniaKroczaca(StatystykiStrumieniowe::Okno24h), 12.0);
+    QCOMPARE(statystyki.sredniaKroczaca(StatystykiStrumieniowe::Okno8h), 12.0);
+}
+
+/**
+ * @brief Porównuje statystyki Welforda z obliczeniami w dwóch przebiegach.
+ *
+ * Do wartości dodawane jest duże przesunięcie, przy którym suma kwadratów traciłaby precyzję.
+ */
+void StatystykiStrumienioweTest::sredniaWariancjaITrend() {
+    const double przesuniecie = 1e6;
+    StatystykiStrumieniowe statystyki;
+    for (int i = 0; i < m_czas.size(); ++i)
+        statystyki.dodaj(m_czas[i], przesuniecie + m_wartosci[i]);
+
+    const int n = m_czas.size();
+    double sredniaX = 0, sredniaY = 0;
+    for (int i = 0; i < n; ++i) {
+        sredniaX += (m_czas[i] - m_czas[0]) / double(GODZINA_MS);
+        sredniaY += przesuniecie + m_wartosci[i];
+    }
+    sredniaX /= n;
+    sredniaY /= n;
+
+    double sxx = 0, syy = 0, sxy = 0;
+    for (int i = 0; i < n; ++i) {
+        const double dx = (m_czas[i] - m_czas[0]) / double(GODZINA_MS) - sredniaX;
+        const double dy = przesuniecie + m_wartosci[i] - sredniaY;
+        sxx += dx * dx;
+        syy += dy * dy;
+        sxy += dx * dy;
+    }
+
+    QVERIFY(bliskie(statystyki.srednia(), sredniaY, BLAD_WZGLEDNY));
+    QVERIFY2(bliskie(statystyki.wariancja(), syy / (n - 1), BLAD_WZGLEDNY),
+             qPrintable(QString("%1 zamiast %2").arg(statystyki.wariancja()).arg(syy / (n - 1))));
+    QVERIFY(qAbs(statystyki.trend() - sxy / sxx) <= BLAD_WZGLEDNY);
+
+    const auto minimum = std::min_element(m_wartosci.cbegin(), m_wartosci.cend());
+    const auto maksimum = std::max_element(m_wartosci.cbegin(), m_wartosci.cend());
+    QCOMPARE(statystyki.min(), przesuniecie + *minimum);
+    QCOMPARE(statystyki.czasMin(), m_czas[int(minimum - m_wartosci.cbegin())]);
+    QCOMPARE(statystyki.max(), przesuniecie + *maksimum);
+    QCOMPARE(statystyki.czasMax(), m_czas[int(maksimum - m_wartosci.cbegin())]);
+
+    // Seria liniowa: trend jest jej nachyleniem na godzinę, a wariancja znana z wzoru.
+    StatystykiStrumieniowe liniowa;
+    for (int h = 0; h < 48; ++h)
+        liniowa.dodaj(POCZATEK_MS + h * GODZINA_MS, 3.0 + 0.5 * h);
+    QCOMPARE(liniowa.trend(), 0.5);
+    QCOMPARE(liniowa.srednia(), 3.0 + 0.5 * 23.5);
+    QCOMPARE(liniowa.wariancja(), 0.25 * 48 * 49 / 12.0);
+    QCOMPARE(liniowa.odchylenie(), qSqrt(0.25 * 48 * 49 / 12.0));
+}
+
+/**
+ * @brief Sprawdza, że próbki są przyjmowane tylko w kolejności czasu.
+ */
+void StatystykiStrumienioweTest::kolejnoscProbek() {
+    StatystykiStrumieniowe statystyki;
+    QVERIFY(statystyki.dodaj(POCZATEK_MS + GODZINA_MS, 1.0));
+    QVERIFY(!statystyki.dodaj(POCZATEK_MS + GODZINA_MS, 2.0));
+    QVERIFY(!statystyki.dodaj(POCZATEK_MS, 3.0));
+    QCOMPARE(statystyki.liczba(), qint64(1));
+    QCOMPARE(statystyki.trend(), 0.0);
+    QCOMPARE(statystyki.wariancja(), 0.0);
+
+    // Widok: próbki do ostatniej włącznie są pomijane, braki również.
+    const qint64 czas[] = {POCZATEK_MS, POCZATEK_MS + GODZINA_MS, POCZATEK_MS + 2 * GODZINA_MS,
+                           POCZATEK_MS + 3 * GODZINA_MS, POCZATEK_MS + 4 * GODZINA_MS};
+    const float wartosci[] = {10.0f, 20.0f, 30.0f, 0.0f, 50.0f};
+    const quint64 braki[] = {quint64(1) << 3};
+    QCOMPARE(statystyki.dodaj(WidokSerii(czas, wartosci, braki, 0, 5)), 2);
+    QCOMPARE(statystyki.liczba(), qint64(3));
+    QCOMPARE(statystyki.ostatniCzas(), POCZATEK_MS + 4 * GODZINA_MS);
+    QCOMPARE(statystyki.srednia(), 27.0);
+
+    statystyki.wyczysc();
+    QVERIFY(statystyki.jestPusta());
+    QCOMPARE(StatystykiStrumieniowe::zWidoku(WidokSerii(czas, wartosci, braki, 0, 5)).liczba(), qint64(4));
+}
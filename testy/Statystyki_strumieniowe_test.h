@@ -0,0 +1,60 @@
+/**
+ * @file Statystyki_strumieniowe_test.h
+ * @brief Plik nagłówkowy klasy StatystykiStrumienioweTest
+ *
+ * Klasa StatystykiStrumienioweTest zawiera testy przyrostowych statystyk serii pomiarów.
+*/
+
+#ifndef STATYSTYKI_STRUMIENIOWE_TEST_H
+#define STATYSTYKI_STRUMIENIOWE_TEST_H
+
+#include <QObject>
+#include <QVector>
+
+/**
+ * @class StatystykiStrumienioweTest
+ * @brief Testy StatystykiStrumieniowe: kwantyle P², okna średnich kroczących, średnia, wariancja i trend.
+ *
+ * Wyniki przyrostowe są porównywane z obliczeniami dokładnymi na całej serii (sortowanie, dwa przebiegi).
+ */
+class StatystykiStrumienioweTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Losuje serię godzinową o wartościach z rozkładu prawoskośnego.
+     */
+    void initTestCase();
+
+    /**
+     * @brief Porównuje kwantyle szacowane algorytmem P² z kwantylami posortowanej serii.
+     */
+    void kwantyleP2();
+
+    /**
+     * @brief Sprawdza dokładne kwantyle dla najwyżej pięciu próbek.
+     */
+    void kwantyleDokladne();
+
+    /**
+     * @brief Sprawdza usuwanie próbek z okien 1 h, 8 h i 24 h na ich granicy.
+     */
+    void oknaKroczace();
+
+    /**
+     * @brief Porównuje średnią, wariancję i trend z obliczeniami w dwóch przebiegach.
+     */
+    void sredniaWariancjaITrend();
+
+    /**
+     * @brief Sprawdza pomijanie próbek nie nowszych od ostatniej i braków w widoku.
+     */
+    void kolejnoscProbek();
+
+private:
+    QVector<qint64> m_czas;       /**< Czas próbek serii */
+    QVector<double> m_wartosci;   /**< Wartości próbek serii */
+};
+
+#endif // STATYSTYKI_STRUMIENIOWE_TEST_H
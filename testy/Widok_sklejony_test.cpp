@@ -0,0 +1,117 @@
+/**
+ * @file Widok_sklejony_test.cpp
+ * @brief Plik źródłowy klasy WidokSklejonyTest
+ */
+
+#include "Widok_sklejony_test.h"
+#include "../Decymacja.h"
+#include "../Statystyki_strumieniowe.h"
+#include "../Widok_sklejony.h"
+
+#include <QTest>
+
+namespace {
+const qint64 GODZINA_MS = 3600 * 1000LL;
+}
+
+/**
+ * @brief Przygotowuje kolumny archiwum (0..100 h) i serii (50..150 h).
+ */
+void WidokSklejonyTest::initTestCase() {
+    for (int h = 0; h <= 100; ++h) {
+        m_czasArchiwum.append(h * GODZINA_MS);
+        m_wartosciArchiwum.append(1.0f);
+    }
+    for (int h = 50; h <= 150; ++h) {
+        m_czasSerii.append(h * GODZINA_MS);
+        m_wartosciSerii.append(2.0f);
+    }
+    m_braki.fill(0, 4);
+}
+
+/**
+ * @brief Sprawdza przedział obejmujący oba źródła.
+ */
+void WidokSklejonyTest::przedzialObejmujacyObaZrodla() {
+    const WidokSerii archiwum(m_czasArchiwum.constData(), m_wartosciArchiwum.constData(), m_braki.constData(),
+                              0, m_czasArchiwum.size());
+    const WidokSerii seria(m_czasSerii.constData(), m_wartosciSerii.constData(), m_braki.constData(),
+                           0, m_czasSerii.size());
+
+    const WidokSklejony widok = WidokSklejony::zakres(archiwum, seria, 20 * GODZINA_MS, 120 * GODZINA_MS);
+
+    QCOMPARE(widok.rozmiar(), 101);
+    QCOMPARE(widok.starsze().rozmiar(), 30);
+    QCOMPARE(widok.starsze().ostatniCzas(), 49 * GODZINA_MS);
+    QCOMPARE(widok.pierwszyCzas(), 20 * GODZINA_MS);
+    QCOMPARE(widok.ostatniCzas(), 120 * GODZINA_MS);
+
+    for (int i = 0; i < widok.rozmiar(); ++i) {
+        QCOMPARE(widok.czas(i), (20 + i) * GODZINA_MS);
+        QVERIFY(!widok.jestBrak(i));
+        // Okres wspólny pochodzi z serii (nowsza wersja pomiarów).
+        QCOMPARE(widok.wartosc(i), widok.czas(i) < 50 * GODZINA_MS ? 1.0f : 2.0f);
+    }
+}
+
+/**
+ * @brief Sprawdza przedziały jednego źródła.
+ */
+void WidokSklejonyTest::przedzialJednegoZrodla() {
+    const WidokSerii archiwum(m_czasArchiwum.constData(), m_wartosciArchiwum.constData(), m_braki.constData(),
+                              0, m_czasArchiwum.size());
+    const WidokSerii seria(m_czasSerii.constData(), m_wartosciSerii.constData(), m_braki.constData(),
+                           0, m_czasSerii.size());
+
+    const WidokSklejony stare = WidokSklejony::zakres(archiwum, seria, 0, 30 * GODZINA_MS);
+    QCOMPARE(stare.rozmiar(), 31);
+    QVERIFY(stare.nowsze().jestPusty());
+    QCOMPARE(stare.ostatniCzas(), 30 * GODZINA_MS);
+
+    const WidokSklejony nowe = WidokSklejony::zakres(archiwum, seria, 60 * GODZINA_MS, 150 * GODZINA_MS);
+    QCOMPARE(nowe.rozmiar(), 91);
+    QVERIFY(nowe.starsze().jestPusty());
+    QCOMPARE(nowe.pierwszyCzas(), 60 * GODZINA_MS);
+
+    const WidokSklejony bezArchiwum = WidokSklejony::zakres(WidokSerii(), seria, 0, 200 * GODZINA_MS);
+    QCOMPARE(bezArchiwum.rozmiar(), 101);
+    QCOMPARE(bezArchiwum.pierwszyCzas(), 50 * GODZINA_MS);
+
+    const WidokSklejony bezSerii = WidokSklejony::zakres(archiwum, WidokSerii(), 90 * GODZINA_MS, 200 * GODZINA_MS);
+    QCOMPARE(bezSerii.rozmiar(), 11);
+    QCOMPARE(bezSerii.ostatniCzas(), 100 * GODZINA_MS);
+}
+
+/**
+ * @brief Sprawdza widok bez źródeł.
+ */
+void WidokSklejonyTest::brakZrodla() {
+    const WidokSklejony widok = WidokSklejony::zakres(WidokSerii(), WidokSerii(), 0, 100 * GODZINA_MS);
+    QVERIFY(widok.jestPusty());
+    QCOMPARE(widok.rozmiar(), 0);
+    QVERIFY(Decymacja::lttb(widok, 50).isEmpty());
+}
+
+/**
+ * @brief Sprawdza decymację i statystyki widoku sklejonego.
+ */
+void WidokSklejonyTest::decymacjaIStatystyki() {
+    const WidokSerii archiwum(m_czasArchiwum.constData(), m_wartosciArchiwum.constData(), m_braki.constData(),
+                              0, m_czasArchiwum.size());
+    const WidokSerii seria(m_czasSerii.constData(), m_wartosciSerii.constData(), m_braki.constData(),
+                           0, m_czasSerii.size());
+    const WidokSklejony widok = WidokSklejony::zakres(archiwum, seria, 0, 150 * GODZINA_MS);
+
+    const QVector<QPointF> punkty = Decymacja::lttb(widok, 20);
+    QCOMPARE(punkty.size(), 20);
+    QCOMPARE(qint64(punkty.first().x()), 0LL);
+    QCOMPARE(qint64(punkty.last().x()), 150 * GODZINA_MS);
+    QCOMPARE(punkty.last().y(), 2.0);
+
+    StatystykiStrumieniowe statystyki;
+    statystyki.dodaj(widok.starsze());
+    statystyki.dodaj(widok.nowsze());
+    QCOMPARE(statystyki.liczba(), qint64(151));
+    QCOMPARE(statystyki.ostatniCzas(), 150 * GODZINA_MS);
+    QCOMPARE(statystyki.max(), 2.0);
+}
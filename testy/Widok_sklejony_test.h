@@ -0,0 +1,59 @@
+/**
+ * @file Widok_sklejony_test.h
+ * @brief Plik nagłówkowy klasy WidokSklejonyTest
+ *
+ * Klasa WidokSklejonyTest zawiera testy łączenia archiwum historii z serią w pamięci (WidokSklejony).
+*/
+
+#ifndef WIDOK_SKLEJONY_TEST_H
+#define WIDOK_SKLEJONY_TEST_H
+
+#include <QObject>
+#include <QVector>
+
+/**
+ * @class WidokSklejonyTest
+ * @brief Testy WidokSklejony::zakres oraz decymacji i statystyk widoku sklejonego.
+ *
+ * Archiwum zawiera próbki godzinowe 0..100 h (wartość 1), a seria w pamięci 50..150 h (wartość 2),
+ * więc okres 50..100 h występuje w obu źródłach.
+ */
+class WidokSklejonyTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Przygotowuje kolumny archiwum i serii.
+     */
+    void initTestCase();
+
+    /**
+     * @brief Sprawdza przedział obejmujący archiwum i serię (najnowsze próbki nie mogą zginąć).
+     */
+    void przedzialObejmujacyObaZrodla();
+
+    /**
+     * @brief Sprawdza przedziały leżące w całości w archiwum albo w serii.
+     */
+    void przedzialJednegoZrodla();
+
+    /**
+     * @brief Sprawdza widok bez archiwum i bez serii.
+     */
+    void brakZrodla();
+
+    /**
+     * @brief Sprawdza, że decymacja i statystyki obejmują oba odcinki.
+     */
+    void decymacjaIStatystyki();
+
+private:
+    QVector<qint64> m_czasArchiwum;      /**< Kolumna czasu archiwum */
+    QVector<float> m_wartosciArchiwum;   /**< Kolumna wartości archiwum */
+    QVector<qint64> m_czasSerii;         /**< Kolumna czasu serii */
+    QVector<float> m_wartosciSerii;      /**< Kolumna wartości serii */
+    QVector<quint64> m_braki;            /**< Mapa braków (bez braków) */
+};
+
+#endif // WIDOK_SKLEJONY_TEST_H
@@ -0,0 +1,55 @@
+/**
+ * @file main_testy.cpp
+ * @brief Punkt wejścia testów jednostkowych (ProjektTests).
+ *
+ * Uruchamia kolejno wszystkie klasy testowe z katalogu testy.
+ * Argumenty wiersza poleceń są przekazywane do QTest (np. -o, -v2, nazwa funkcji testowej).
+ */
+
+#include <QCoreApplication>
+#include <QTest>
+
+#include "API_pobieranie_test.h"
+#include "Indeks_nazw_test.h"
+#include "Kompresja_gorilla_test.h"
+#include "Odleglosci_test.h"
+#include "Parser_czasu_test.h"
+#include "Skorowidz_miejsc_test.h"
+#include "Statystyki_strumieniowe_test.h"
+#include "Widok_sklejony_test.h"
+
+/**
+ * @brief Uruchamia jedną klasę testową.
+ *
+ * @param test Obiekt klasy testowej.
+ * @param argc Liczba argumentów.
+ * @param argv Argumenty.
+ * @return Liczba nieudanych testów.
+ */
+static int uruchom(QObject&& test, int argc, char *argv[]) {
+    return QTest::qExec(&test, argc, argv);
+}
+
+/**
+ * @brief Główna funkcja testów.
+ *
+ * @param argc Liczba argumentów wiersza poleceń.
+ * @param argv Tablica argumentów wiersza poleceń.
+ * @return 0 jeśli wszystkie testy przeszły.
+ */
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+
+    int bledy = 0;
+    bledy += uruchom(ParserCzasuTest(), argc, argv);
+    bledy += uruchom(WidokSklejonyTest(), argc, argv);
+    bledy += uruchom(KompresjaGorillaTest(), argc, argv);
+    bledy += uruchom(SkorowidzMiejscTest(), argc, argv);
+    bledy += uruchom(OdleglosciTest(), argc, argv);
+    bledy += uruchom(IndeksNazwTest(), argc, argv);
+    bledy += uruchom(StatystykiStrumienioweTest(), argc, argv);
+    bledy += uruchom(APIServiceTest(), argc, argv);
+
+    return bledy == 0 ? 0 : 1;
+}